@@ -0,0 +1,449 @@
+/**
+ * vsrtl_bench
+ * Performance benchmarks of the VSRTL core library. For each benchmarked design, the following is measured:
+ *  - construction time
+ *  - verifyAndInitialize() time
+ *  - clock throughput (cycles/second), with signals enabled, with signals disabled and with VCD dumping enabled
+ *  - reverse throughput (reversed cycles/second)
+ *  - peak resident set size
+ *
+ * Results are printed to stdout, and may be written as JSON (--output). Given a baseline (--baseline), as previously
+ * written through --output, results are compared against the baseline and the benchmark fails if any metric regressed
+ * by more than the given threshold.
+ */
+
+#include "Leros/SingleCycleLeros/SingleCycleLeros.h"
+#include "vsrtl_manynestedcomponents.h"
+#include "vsrtl_rannumgen.h"
+#include "vsrtl_registerfilecmp.h"
+#include "vsrtl_syntheticdesign.h"
+#include "vsrtl_xornetwork.h"
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+using namespace vsrtl;
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkResult {
+    std::string design;
+    double constructionMs = 0;
+    double verifyMs = 0;
+    double cyclesPerSecond = 0;
+    double cyclesPerSecondNoSignals = 0;
+    double cyclesPerSecondVcd = 0;
+    double reversesPerSecond = 0;
+    double peakRssKb = 0;
+    double footprintKb = 0;
+
+    template <class Archive>
+    void serialize(Archive& archive) {
+        archive(cereal::make_nvp("design", design), cereal::make_nvp("construction_ms", constructionMs),
+                cereal::make_nvp("verify_ms", verifyMs), cereal::make_nvp("cycles_per_second", cyclesPerSecond),
+                cereal::make_nvp("cycles_per_second_no_signals", cyclesPerSecondNoSignals),
+                cereal::make_nvp("cycles_per_second_vcd", cyclesPerSecondVcd),
+                cereal::make_nvp("reverses_per_second", reversesPerSecond),
+                cereal::make_nvp("peak_rss_kb", peakRssKb), cereal::make_nvp("footprint_kb", footprintKb));
+    }
+};
+
+struct Metric {
+    const char* name;
+    const char* label;
+    double BenchmarkResult::*value;
+    bool higherIsBetter;
+};
+
+const Metric metrics[] = {
+    {"construction_ms", "construct [ms]", &BenchmarkResult::constructionMs, false},
+    {"verify_ms", "verify [ms]", &BenchmarkResult::verifyMs, false},
+    {"cycles_per_second", "cycles/s", &BenchmarkResult::cyclesPerSecond, true},
+    {"cycles_per_second_no_signals", "cycles/s nosig", &BenchmarkResult::cyclesPerSecondNoSignals, true},
+    {"cycles_per_second_vcd", "cycles/s vcd", &BenchmarkResult::cyclesPerSecondVcd, true},
+    {"reverses_per_second", "reverses/s", &BenchmarkResult::reversesPerSecond, true},
+    {"peak_rss_kb", "peak RSS [kB]", &BenchmarkResult::peakRssKb, false},
+    {"footprint_kb", "footprint [kB]", &BenchmarkResult::footprintKb, false},
+};
+
+struct BenchmarkDesign {
+    std::string name;
+    std::function<std::unique_ptr<core::Design>()> create;
+};
+
+struct Options {
+    std::string output;
+    std::string baseline;
+    std::string filter;
+    double threshold = 0.10;
+    double minTime = 0.5;  // seconds per throughput measurement
+    unsigned repeat = 3;
+    int footprintDepth = -1;  // hierarchy depth of the printed memory footprint; disabled if negative
+};
+
+template <typename T>
+std::unique_ptr<core::Design> createDesign() {
+    return core::Design::create<T>();
+}
+
+std::unique_ptr<core::Design> createLeros(const std::vector<unsigned short>& program) {
+    auto design = core::Design::create<leros::SingleCycleLeros>();
+    design->m_memory->addInitializationMemory(0x0, program.data(), program.size());
+    return design;
+}
+
+BenchmarkDesign syntheticBenchmark(unsigned gates) {
+    SyntheticDesignParameters parameters;
+    parameters.gates = gates;
+    parameters.hierarchyDepth = 2;
+    parameters.memories = 4;
+    return {"Synthetic/" + std::to_string(gates), [=] { return core::Design::create<SyntheticDesign>(parameters); }};
+}
+
+std::vector<BenchmarkDesign> benchmarkDesigns() {
+    /**
+     *      loadhi  1   -- 0x100
+     *      store   0
+     *      ldaddr  0
+     *      loadi   0
+     *      stind   0   -- store 0 at 0x100[0]
+     * .loop:
+     *      ldind   0
+     *      addi    1
+     *      stind   0
+     *      loadi   0
+     *      br      -8
+     */
+    static const std::vector<unsigned short> incInMemory = {0x2901, 0x3000, 0x5000, 0x2100, 0x7000,
+                                                            0x6000, 0x0901, 0x7000, 0x2100, 0x8FFC};
+
+    // Compiled C program; startup code followed by nested loops over memory
+    static const std::vector<unsigned short> startup = {
+        0x2100, 0x3064, 0x2101, 0x3065, 0x2180, 0x2900, 0x3066, 0x2100, 0x2980, 0x2a00, 0x3067, 0x2100, 0x2b80, 0x3068,
+        0x21ff, 0x2900, 0x3069, 0x29ff, 0x2a00, 0x306a, 0x2100, 0x2aff, 0x306b, 0x21ff, 0x2b7f, 0x306c, 0x21cc, 0x2900,
+        0x2a00, 0x2b00, 0x3078, 0x21e4, 0x2900, 0x2a00, 0x2b00, 0x3079, 0x21fc, 0x2900, 0x2a00, 0x2b00, 0x307a, 0x2100,
+        0x2900, 0x2a00, 0x2b00, 0x9011, 0x3001, 0x2100, 0x2900, 0x2a00, 0x2b20, 0x3002, 0x5002, 0x2100, 0x7000, 0x2002,
+        0x0904, 0x3002, 0x2001, 0x0d01, 0x3001, 0xaff7, 0x21fc, 0x290f, 0x2a00, 0x2b20, 0x3001, 0x2194, 0x2900, 0x2a00,
+        0x2b00, 0x4000, 0x8000, 0x0000, 0x2001, 0x09f0, 0x3001, 0x2000, 0x5001, 0x7003, 0x2002, 0x7002, 0x2001, 0x0910,
+        0x3002, 0x8001, 0x5002, 0x60fd, 0x0901, 0x70fd, 0x60fd, 0x2304, 0x3004, 0x9008, 0x8001, 0x5002, 0x60fc, 0x0901,
+        0x3004, 0x70fc, 0x8001, 0x8ff1, 0x2005, 0x9009, 0x2004, 0x0804, 0x3004, 0x2005, 0x0d01, 0x9003, 0x3005, 0x8ff9,
+        0x2000, 0x4000, 0x2005, 0x9009, 0x2004, 0x1000, 0x3004, 0x2005, 0x0d01, 0x9003, 0x3005, 0x8ff9, 0x2000, 0x4000,
+        0x2005, 0x900a, 0x2004, 0x1000, 0x226c, 0x3004, 0x2005, 0x0d01, 0x9003, 0x3005, 0x8ff8, 0x2000, 0x4000};
+
+    return {
+        {"XorNetwork", createDesign<core::XorNetwork>},
+        {"RanNumGen", createDesign<core::RanNumGen>},
+        {"ManyNestedComponents", createDesign<core::ManyNestedComponents>},
+        {"RegisterFileTester", createDesign<core::RegisterFileTester>},
+        {"SingleCycleLeros/incInMemory", [] { return createLeros(incInMemory); }},
+        {"SingleCycleLeros/startup", [] { return createLeros(startup); }},
+        syntheticBenchmark(1000),
+        syntheticBenchmark(10000),
+        syntheticBenchmark(100000),
+    };
+}
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0 : values[values.size() / 2];
+}
+
+/**
+ * @brief measureRate
+ * Repeatedly executes @p op in batches of doubling size, until at least @p minTime seconds have passed.
+ * @returns executions of @p op per second.
+ */
+double measureRate(const std::function<void()>& op, double minTime) {
+    const auto start = Clock::now();
+    size_t n = 0;
+    for (size_t batch = 1;; batch *= 2) {
+        for (size_t i = 0; i < batch; ++i) {
+            op();
+        }
+        n += batch;
+        const double seconds = elapsedMs(start) / 1000.0;
+        if (seconds >= minTime) {
+            return n / seconds;
+        }
+    }
+}
+
+/// Resets the peak resident set size of the process, if supported by the platform.
+void resetPeakRss() {
+#if defined(__linux__)
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+/// @returns the peak resident set size of the process in kilobytes, or 0 if unavailable.
+double peakRssKb() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stod(line.substr(6));
+        }
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024.0;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+BenchmarkResult runBenchmark(const BenchmarkDesign& bench, const Options& options) {
+    BenchmarkResult result;
+    result.design = bench.name;
+    resetPeakRss();
+
+    std::vector<double> construction, verify, cycles, cyclesNoSignals, cyclesVcd, reverses;
+    for (unsigned r = 0; r < options.repeat; ++r) {
+        auto start = Clock::now();
+        auto design = bench.create();
+        construction.push_back(elapsedMs(start));
+
+        start = Clock::now();
+        design->verifyAndInitialize();
+        verify.push_back(elapsedMs(start));
+
+        cycles.push_back(measureRate([&] { design->clock(); }, options.minTime));
+
+        if (r == 0) {
+            // Reverse stacks are filled at this point
+            const auto footprint = design->getMemoryFootprint();
+            result.footprintKb = footprint.total().total() / 1024.0;
+            if (options.footprintDepth >= 0) {
+                footprint.print(std::cout, options.footprintDepth);
+            }
+        }
+
+        design->setEnableSignals(false);
+        cyclesNoSignals.push_back(measureRate([&] { design->clock(); }, options.minTime));
+        design->setEnableSignals(true);
+
+        // Reverse throughput; the reverse stack is filled, after which all cycles on the stack are reversed. The
+        // measurement is bounded by wall-clock time, as filling the stack takes time as well. Designs without a reverse
+        // stack cannot be reversed, and report a rate of 0.
+        design->reset();
+        const unsigned depth = core::ClockedComponent::reverseStackSize();
+        double reverseMs = 0;
+        size_t reversed = 0;
+        const auto reverseStart = Clock::now();
+        while (depth != 0 && elapsedMs(reverseStart) < options.minTime * 1000.0) {
+            for (unsigned i = 0; i < depth; ++i) {
+                design->clock();
+            }
+            start = Clock::now();
+            while (design->canReverse()) {
+                design->reverse();
+                reversed++;
+            }
+            reverseMs += elapsedMs(start);
+        }
+        reverses.push_back(reversed != 0 && reverseMs > 0 ? reversed / (reverseMs / 1000.0) : 0.0);
+
+        // VCD files are written to the current working directory
+        const auto cwd = std::filesystem::current_path();
+        const auto vcdDir = std::filesystem::temp_directory_path() / "vsrtl_bench";
+        std::filesystem::create_directories(vcdDir);
+        std::filesystem::current_path(vcdDir);
+        design->vcdDump(true);
+        design->reset();
+        cyclesVcd.push_back(measureRate([&] { design->clock(); }, options.minTime));
+        design->vcdDump(false);
+        design.reset();
+        std::filesystem::current_path(cwd);
+        std::filesystem::remove_all(vcdDir);
+    }
+
+    result.constructionMs = median(construction);
+    result.verifyMs = median(verify);
+    result.cyclesPerSecond = median(cycles);
+    result.cyclesPerSecondNoSignals = median(cyclesNoSignals);
+    result.cyclesPerSecondVcd = median(cyclesVcd);
+    result.reversesPerSecond = median(reverses);
+    result.peakRssKb = peakRssKb();
+    return result;
+}
+
+void printResults(const std::vector<BenchmarkResult>& results) {
+    std::printf("%-30s", "design");
+    for (const auto& metric : metrics) {
+        std::printf(" %16s", metric.label);
+    }
+    std::printf("\n");
+    for (const auto& result : results) {
+        std::printf("%-30s", result.design.c_str());
+        for (const auto& metric : metrics) {
+            std::printf(" %16.2f", result.*metric.value);
+        }
+        std::printf("\n");
+    }
+}
+
+void writeResults(const std::string& path, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open '" + path + "' for writing");
+    }
+    cereal::JSONOutputArchive archive(file);
+    archive(cereal::make_nvp("benchmarks", results));
+}
+
+std::vector<BenchmarkResult> readResults(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open baseline '" + path + "'");
+    }
+    std::vector<BenchmarkResult> results;
+    cereal::JSONInputArchive archive(file);
+    archive(cereal::make_nvp("benchmarks", results));
+    return results;
+}
+
+/**
+ * @brief compareResults
+ * Compares @p results against @p baseline, printing the relative change of each metric.
+ * @returns the number of metrics which regressed by more than @p threshold.
+ */
+unsigned compareResults(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+                        double threshold) {
+    unsigned regressions = 0;
+    std::printf("\nComparison against baseline (threshold %.1f%%):\n", threshold * 100);
+    for (const auto& result : results) {
+        auto base = std::find_if(baseline.begin(), baseline.end(),
+                                 [&](const BenchmarkResult& b) { return b.design == result.design; });
+        if (base == baseline.end()) {
+            std::printf("%-30s not present in baseline\n", result.design.c_str());
+            continue;
+        }
+        for (const auto& metric : metrics) {
+            const double before = (*base).*metric.value;
+            const double after = result.*metric.value;
+            if (before <= 0 || after <= 0) {
+                // Metric unavailable on this platform
+                continue;
+            }
+            // Positive changes are improvements
+            const double change = metric.higherIsBetter ? after / before - 1 : before / after - 1;
+            const bool regressed = change < -threshold;
+            regressions += regressed;
+            std::printf("%-30s %-30s %14.2f -> %14.2f  %+7.1f%%%s\n", result.design.c_str(), metric.name, before,
+                        after, change * 100, regressed ? "  REGRESSION" : "");
+        }
+    }
+    return regressions;
+}
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [options]\n"
+              << "  --output <file>      Write results as JSON to <file>\n"
+              << "  --baseline <file>    Compare results against a JSON baseline, failing on regressions\n"
+              << "  --threshold <ratio>  Relative change considered a regression (default: 0.10)\n"
+              << "  --filter <string>    Only run designs whose name contains <string>\n"
+              << "  --min-time <s>       Minimum duration of each throughput measurement (default: 0.5)\n"
+              << "  --repeat <n>         Repetitions of each measurement; the median is reported (default: 3)\n"
+              << "  --synthetic <gates>  Add a synthetic design of <gates> logic gates\n"
+              << "  --footprint <depth>  Print the memory footprint of each design, down to hierarchy <depth>\n"
+              << "  --list               List benchmark designs\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    auto designs = benchmarkDesigns();
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--output") {
+            options.output = value();
+        } else if (arg == "--baseline") {
+            options.baseline = value();
+        } else if (arg == "--threshold") {
+            options.threshold = std::stod(value());
+        } else if (arg == "--filter") {
+            options.filter = value();
+        } else if (arg == "--min-time") {
+            options.minTime = std::stod(value());
+        } else if (arg == "--repeat") {
+            options.repeat = std::max(1, std::stoi(value()));
+        } else if (arg == "--footprint") {
+            options.footprintDepth = std::stoi(value());
+        } else if (arg == "--synthetic") {
+            designs.push_back(syntheticBenchmark(std::stoul(value())));
+        } else if (arg == "--list") {
+            for (const auto& design : designs) {
+                std::cout << design.name << "\n";
+            }
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    try {
+        std::vector<BenchmarkResult> results;
+        for (const auto& design : designs) {
+            if (design.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            std::cerr << "Running " << design.name << "..." << std::endl;
+            results.push_back(runBenchmark(design, options));
+        }
+        printResults(results);
+
+        if (!options.output.empty()) {
+            writeResults(options.output, results);
+        }
+
+        if (!options.baseline.empty()) {
+            const unsigned regressions = compareResults(results, readResults(options.baseline), options.threshold);
+            if (regressions != 0) {
+                std::printf("\n%u metric(s) regressed\n", regressions);
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
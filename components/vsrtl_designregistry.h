@@ -0,0 +1,71 @@
+#ifndef VSRTL_DESIGNREGISTRY_H
+#define VSRTL_DESIGNREGISTRY_H
+
+#include "Leros/SingleCycleLeros/SingleCycleLeros.h"
+#include "vsrtl_adderandreg.h"
+#include "vsrtl_aluandreg.h"
+#include "vsrtl_counter.h"
+#include "vsrtl_enumandmux.h"
+#include "vsrtl_manynestedcomponents.h"
+#include "vsrtl_nestedexponenter.h"
+#include "vsrtl_rannumgen.h"
+#include "vsrtl_registerfilecmp.h"
+#include "vsrtl_syntheticdesign.h"
+#include "vsrtl_xornetwork.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vsrtl {
+namespace core {
+
+/**
+ * @brief The RegisteredDesign struct
+ * An example design which may be instantiated by name, ie. by command-line tools.
+ */
+struct RegisteredDesign {
+    std::string name;
+    std::string description;
+    std::function<std::unique_ptr<Design>()> create;
+    /// Address space which programs are loaded into, or nullptr if the design does not execute programs.
+    std::function<AddressSpace*(Design&)> programMemory;
+};
+
+/// @returns all designs which may be instantiated by name. Designs are only constructed when created.
+inline const std::vector<RegisteredDesign>& registeredDesigns() {
+    static const std::vector<RegisteredDesign> designs = {
+        {"AdderAndReg", "Adder feeding back into a register", [] { return Design::create<AdderAndReg>(); }, {}},
+        {"ALUAndReg", "ALU feeding back into a register", [] { return Design::create<ALUAndReg>(); }, {}},
+        {"Counter", "8-bit counter built from full adders", [] { return Design::create<Counter<8>>(); }, {}},
+        {"EnumAndMux", "Enum-controlled multiplexer", [] { return Design::create<EnumAndMux>(); }, {}},
+        {"ManyNestedComponents", "Deeply nested component hierarchy",
+         [] { return Design::create<ManyNestedComponents>(); }, {}},
+        {"NestedExponenter", "Nested exponentiation circuit", [] { return Design::create<NestedExponenter>(); }, {}},
+        {"RanNumGen", "Xorshift random number generator", [] { return Design::create<RanNumGen>(); }, {}},
+        {"RegisterFileTester", "Register file with incrementing writeback",
+         [] { return Design::create<RegisterFileTester>(); }, {}},
+        {"XorNetwork", "Network of xor gates", [] { return Design::create<XorNetwork>(); }, {}},
+        {"SyntheticDesign", "Randomly generated design of 1000 gates",
+         [] { return Design::create<SyntheticDesign>(); }, {}},
+        {"SingleCycleLeros", "Single cycle Leros processor", [] { return Design::create<leros::SingleCycleLeros>(); },
+         [](Design& d) -> AddressSpace* { return static_cast<leros::SingleCycleLeros&>(d).m_memory; }},
+    };
+    return designs;
+}
+
+/// @returns the registered design named @p name, or nullptr if no such design exists.
+inline const RegisteredDesign* findRegisteredDesign(const std::string& name) {
+    for (const auto& design : registeredDesigns()) {
+        if (design.name == name) {
+            return &design;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace core
+}  // namespace vsrtl
+
+#endif  // VSRTL_DESIGNREGISTRY_H
@@ -0,0 +1,378 @@
+#ifndef VSRTL_SYNTHETICDESIGN_H
+#define VSRTL_SYNTHETICDESIGN_H
+
+#include "vsrtl_adder.h"
+#include "vsrtl_constant.h"
+#include "vsrtl_design.h"
+#include "vsrtl_logicgate.h"
+#include "vsrtl_memory.h"
+#include "vsrtl_register.h"
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace vsrtl {
+namespace core {
+
+struct SyntheticDesignParameters {
+    /// Seed of the generator; equal parameters yield structurally identical designs.
+    uint64_t seed = 0;
+    /// Number of combinational logic gates. A few additional gates may be inserted to sink otherwise unused nets.
+    unsigned gates = 1000;
+    /// Number of gate levels between register boundaries.
+    unsigned depth = 8;
+    /// Number of registers relative to the number of gates.
+    double registerRatio = 0.1;
+    /**
+     * Skew of the fan-out distribution. At 1.0, gate inputs are drawn uniformly from the nets of the preceding levels.
+     * Larger values concentrate fan-out onto fewer nets, yielding a heavy-tailed fan-out distribution.
+     */
+    double fanOutSkew = 1.0;
+    /// Port widths in use; logic is split evenly across widths. Each width must be one of 1, 8, 16, 32 or 64.
+    std::vector<unsigned> widths = {1, 8, 32};
+    /// Number of nested levels of modules. At 0, all logic is placed at the top level of the design.
+    unsigned hierarchyDepth = 0;
+    /// Number of submodules within each module.
+    unsigned hierarchyBranching = 4;
+    /// Number of memories. Memories are placed on nets of 8 bits or wider.
+    unsigned memories = 0;
+};
+
+/**
+ * @brief The SyntheticModule class
+ * Hierarchical container of a SyntheticDesign. Ports are added to the module by the design generator.
+ */
+class SyntheticModule : public Component {
+public:
+    SyntheticModule(const std::string& name, SimComponent* parent) : Component(name, parent) {}
+};
+
+/**
+ * @brief The SyntheticDesign class
+ * Randomly generated, valid design of configurable size and shape, built from core primitives. Used for characterizing
+ * how elaboration, simulation and the graphical library scale with design size.
+ *
+ * Logic is generated in leaf modules. Within a leaf, registers and memories are the sources of a levelized cloud of
+ * logic gates, which in turn drives the registers and memories. Modules are chained through a single input and output
+ * port per width, wherein module outputs are always driven by a register. Thus, no combinational loops may arise
+ * between modules.
+ */
+class SyntheticDesign : public Design {
+public:
+    struct Statistics {
+        unsigned gates = 0;
+        unsigned registers = 0;
+        unsigned memories = 0;
+        unsigned modules = 0;
+    };
+
+    explicit SyntheticDesign(const SyntheticDesignParameters& parameters = {})
+        : Design("Synthetic design"), m_parameters(parameters), m_rng(parameters.seed) {
+        verifyParameters();
+        unsigned leaves = 1;
+        for (unsigned i = 0; i < m_parameters.hierarchyDepth; ++i) {
+            leaves *= m_parameters.hierarchyBranching;
+        }
+
+        // Memories are spread across all leaves, on widths which are byte-addressable.
+        std::vector<unsigned> memoryLanes;
+        for (unsigned lane = 0; lane < m_parameters.widths.size(); ++lane) {
+            if (m_parameters.widths[lane] >= CHAR_BIT) {
+                memoryLanes.push_back(lane);
+            }
+        }
+        const unsigned lanes = m_parameters.widths.size();
+        m_budgets.resize(leaves * lanes);
+        for (unsigned i = 0; i < m_budgets.size(); ++i) {
+            m_budgets[i].gates = share(m_parameters.gates, m_budgets.size(), i);
+        }
+        for (unsigned i = 0; i < m_parameters.memories; ++i) {
+            const unsigned leaf = i % leaves;
+            const unsigned lane = memoryLanes[(i / leaves) % memoryLanes.size()];
+            m_budgets[leaf * lanes + lane].memories++;
+        }
+
+        if (m_parameters.hierarchyDepth == 0) {
+            generateLeaf(this, nullptr);
+        } else {
+            generateModule(this, nullptr, 0);
+        }
+    }
+
+    const SyntheticDesignParameters& parameters() const { return m_parameters; }
+    const Statistics& statistics() const { return m_statistics; }
+
+private:
+    struct Budget {
+        unsigned gates = 0;
+        unsigned memories = 0;
+    };
+
+    /// Module ports of each width lane
+    struct ModulePorts {
+        std::vector<PortBase*> in;
+        std::vector<PortBase*> out;
+    };
+
+    void verifyParameters() const {
+        if (m_parameters.widths.empty()) {
+            throw std::runtime_error("Synthetic design: no port widths specified");
+        }
+        for (unsigned w : m_parameters.widths) {
+            forWidth(w, [](auto) {});
+        }
+        if (m_parameters.depth == 0) {
+            throw std::runtime_error("Synthetic design: logic depth must be at least 1");
+        }
+        if (m_parameters.hierarchyDepth != 0 && m_parameters.hierarchyBranching == 0) {
+            throw std::runtime_error("Synthetic design: hierarchy branching must be at least 1");
+        }
+        if (m_parameters.registerRatio < 0 || m_parameters.fanOutSkew <= 0) {
+            throw std::runtime_error("Synthetic design: invalid register ratio or fan-out skew");
+        }
+        if (m_parameters.memories != 0 && std::none_of(m_parameters.widths.begin(), m_parameters.widths.end(),
+                                                       [](unsigned w) { return w >= CHAR_BIT; })) {
+            throw std::runtime_error("Synthetic design: memories require a port width of at least 8 bits");
+        }
+    }
+
+    /// Invokes @p f with std::integral_constant<unsigned, @p width>.
+    template <typename F>
+    static void forWidth(unsigned width, F&& f) {
+        switch (width) {
+            case 1:
+                return f(std::integral_constant<unsigned, 1>());
+            case 8:
+                return f(std::integral_constant<unsigned, 8>());
+            case 16:
+                return f(std::integral_constant<unsigned, 16>());
+            case 32:
+                return f(std::integral_constant<unsigned, 32>());
+            case 64:
+                return f(std::integral_constant<unsigned, 64>());
+            default:
+                throw std::runtime_error("Synthetic design: unsupported port width " + std::to_string(width));
+        }
+    }
+
+    /// @returns the size of the @p i'th of @p n near-equal shares of @p total.
+    static unsigned share(unsigned total, unsigned n, unsigned i) { return total / n + (i < total % n ? 1 : 0); }
+
+    // Random number generation is implemented here rather than through the standard distributions, whose output is
+    // implementation defined, such that a seed yields the same design on all platforms.
+    uint64_t random(uint64_t n) { return m_rng() % n; }
+    double uniform() { return (m_rng() >> 11) * 0x1.0p-53; }
+
+    /// @returns a random index into [begin; end), skewed towards begin according to the fan-out skew.
+    size_t skewedIndex(size_t begin, size_t end) {
+        const auto n = end - begin;
+        return begin + std::min<size_t>(n - 1, static_cast<size_t>(n * std::pow(uniform(), m_parameters.fanOutSkew)));
+    }
+
+    /**
+     * @brief generateModule
+     * Recursively generates the submodules of @p container, chaining the submodules through their ports. The first
+     * submodule is driven by the input port of @p container, and the output of the last submodule drives the output
+     * port of @p container. At the top level, the chain is closed into a ring.
+     */
+    void generateModule(SimComponent* container, ModulePorts* ports, unsigned level) {
+        std::vector<ModulePorts> children(m_parameters.hierarchyBranching);
+        for (unsigned i = 0; i < children.size(); ++i) {
+            auto* module = container->create_component<SyntheticModule>("module_" + std::to_string(i));
+            m_statistics.modules++;
+            for (unsigned w : m_parameters.widths) {
+                forWidth(w, [&](auto width) {
+                    constexpr unsigned W = decltype(width)::value;
+                    children[i].in.push_back(&module->createInputPort<W>("in_w" + std::to_string(W)));
+                    children[i].out.push_back(&module->createOutputPort<W>("out_w" + std::to_string(W)));
+                });
+            }
+            if (level + 1 == m_parameters.hierarchyDepth) {
+                generateLeaf(module, &children[i]);
+            } else {
+                generateModule(module, &children[i], level + 1);
+            }
+        }
+
+        for (unsigned lane = 0; lane < m_parameters.widths.size(); ++lane) {
+            forWidth(m_parameters.widths[lane], [&](auto width) {
+                constexpr unsigned W = decltype(width)::value;
+                auto port = [&](std::vector<PortBase*>& lanes) { return static_cast<Port<W>*>(lanes[lane]); };
+                *port(ports ? ports->in : children.back().out) >> *port(children.front().in);
+                for (unsigned i = 1; i < children.size(); ++i) {
+                    *port(children[i - 1].out) >> *port(children[i].in);
+                }
+                if (ports) {
+                    *port(children.back().out) >> *port(ports->out);
+                }
+            });
+        }
+    }
+
+    void generateLeaf(SimComponent* container, ModulePorts* ports) {
+        const unsigned leaf = m_leafCount++;
+        for (unsigned lane = 0; lane < m_parameters.widths.size(); ++lane) {
+            forWidth(m_parameters.widths[lane], [&](auto width) {
+                constexpr unsigned W = decltype(width)::value;
+                generateLogic<W>(container, m_budgets[leaf * m_parameters.widths.size() + lane],
+                                 ports ? static_cast<Port<W>*>(ports->in[lane]) : nullptr,
+                                 ports ? static_cast<Port<W>*>(ports->out[lane]) : nullptr);
+            });
+        }
+    }
+
+    template <unsigned W>
+    void generateLogic(SimComponent* container, const Budget& budget, Port<W>* in, Port<W>* out) {
+        struct Net {
+            Port<W>* port;
+            unsigned level;
+        };
+        std::vector<Net> nets;
+        // Nets which do not yet drive any input, in order of creation. Entries are lazily removed once used.
+        std::deque<size_t> unused;
+        std::vector<bool> used;
+        size_t unusedCount = 0;
+        auto addNet = [&](Port<W>* port, unsigned level) {
+            unused.push_back(nets.size());
+            nets.push_back({port, level});
+            used.push_back(false);
+            unusedCount++;
+        };
+        auto firstUnused = [&]() -> size_t {
+            while (!unused.empty() && used[unused.front()]) {
+                unused.pop_front();
+            }
+            return unused.empty() ? SIZE_MAX : unused.front();
+        };
+        auto connect = [&](size_t net, Port<W>& to) {
+            *nets[net].port >> to;
+            if (!used[net]) {
+                used[net] = true;
+                unusedCount--;
+            }
+        };
+        const std::string prefix = "w" + std::to_string(W) + "_";
+
+        // Sources
+        const unsigned nRegisters =
+            std::max(1u, static_cast<unsigned>(std::lround(budget.gates * m_parameters.registerRatio)));
+        std::vector<Register<W>*> registers;
+        for (unsigned i = 0; i < nRegisters; ++i) {
+            auto* reg = container->template create_component<Register<W>>(prefix + "reg_" + std::to_string(i));
+            reg->setInitValue(m_rng());
+            registers.push_back(reg);
+            addNet(&reg->out, 0);
+        }
+        m_statistics.registers += nRegisters;
+
+        std::vector<MemoryAsyncRd<CHAR_BIT, W>*> memories;
+        if constexpr (W >= CHAR_BIT) {
+            for (unsigned i = 0; i < budget.memories; ++i) {
+                // Memories are addressed by a free-running counter, bounding the footprint of each memory to 2^8 bytes
+                const std::string name = prefix + "mem_" + std::to_string(i);
+                auto* mem = container->template create_component<MemoryAsyncRd<CHAR_BIT, W>>(name);
+                auto* addrReg = container->template create_component<Register<CHAR_BIT>>(name + "_addr");
+                auto* addrInc = container->template create_component<Adder<CHAR_BIT>>(name + "_inc");
+                addrReg->out >> addrInc->op1;
+                1 >> addrInc->op2;
+                addrInc->out >> addrReg->in;
+                addrReg->out >> mem->addr;
+                1 >> mem->wr_en;
+                (W / CHAR_BIT) >> mem->wr_width;
+                mem->setMemory(createMemory<AddressSpace>());
+                memories.push_back(mem);
+                addNet(&mem->data_out, 0);
+            }
+            m_statistics.memories += budget.memories;
+        }
+        if (in) {
+            addNet(in, 0);
+        }
+
+        // Levelized gates. The first input of each gate is drawn from the preceding level, ensuring the requested logic
+        // depth. The second input is preferably an otherwise unused net.
+        std::vector<size_t> levelBegin = {0};
+        for (unsigned i = 0; i < budget.gates; ++i) {
+            const unsigned level = 1 + static_cast<unsigned>(uint64_t(i) * m_parameters.depth / budget.gates);
+            while (levelBegin.size() <= level) {
+                levelBegin.push_back(nets.size());
+            }
+            const size_t prevBegin = levelBegin[level - 1] == levelBegin[level] ? 0 : levelBegin[level - 1];
+            const size_t first = skewedIndex(prevBegin, levelBegin[level]);
+            size_t second = firstUnused();
+            if (second == SIZE_MAX || nets[second].level >= level || second == first) {
+                second = skewedIndex(0, levelBegin[level]);
+            }
+
+            const std::string name = prefix + "gate_" + std::to_string(i);
+            LogicGate<W, 2>* gate = nullptr;
+            switch (random(5)) {
+                case 0:
+                    gate = container->template create_component<And<W, 2>>(name);
+                    break;
+                case 1:
+                    gate = container->template create_component<Or<W, 2>>(name);
+                    break;
+                case 2:
+                    gate = container->template create_component<Xor<W, 2>>(name);
+                    break;
+                case 3:
+                    gate = container->template create_component<Nand<W, 2>>(name);
+                    break;
+                default: {
+                    auto* inv = container->template create_component<Not<W, 1>>(name);
+                    connect(first, *inv->in[0]);
+                    addNet(&inv->out, level);
+                    continue;
+                }
+            }
+            connect(first, *gate->in[0]);
+            connect(second, *gate->in[1]);
+            addNet(&gate->out, level);
+        }
+        m_statistics.gates += budget.gates;
+
+        // Each register, memory and the module output sinks a net. Any unused nets beyond that are merged through xor
+        // gates.
+        const size_t sinks = registers.size() + memories.size();
+        for (unsigned i = 0; unusedCount > sinks; ++i) {
+            const size_t a = firstUnused();
+            unused.pop_front();
+            const size_t b = firstUnused();
+            auto* gate = container->template create_component<Xor<W, 2>>(prefix + "sink_" + std::to_string(i));
+            connect(a, *gate->in[0]);
+            connect(b, *gate->in[1]);
+            addNet(&gate->out, std::max(nets[a].level, nets[b].level) + 1);
+            m_statistics.gates++;
+        }
+        auto sinkNet = [&] {
+            const size_t net = firstUnused();
+            return net == SIZE_MAX ? skewedIndex(levelBegin.back(), nets.size()) : net;
+        };
+        for (auto* reg : registers) {
+            connect(sinkNet(), reg->in);
+        }
+        for (auto* mem : memories) {
+            connect(sinkNet(), mem->data_in);
+        }
+        if (out) {
+            registers[random(registers.size())]->out >> *out;
+        }
+    }
+
+    SyntheticDesignParameters m_parameters;
+    std::mt19937_64 m_rng;
+    std::vector<Budget> m_budgets;
+    unsigned m_leafCount = 0;
+    Statistics m_statistics;
+};
+
+}  // namespace core
+}  // namespace vsrtl
+
+#endif  // VSRTL_SYNTHETICDESIGN_H
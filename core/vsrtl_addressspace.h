@@ -6,7 +6,9 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../interface/vsrtl_breakpoints.h"
 #include "../interface/vsrtl_defines.h"
+#include "../interface/vsrtl_footprint.h"
 
 namespace vsrtl {
 namespace core {
@@ -18,7 +20,7 @@ namespace core {
  * be added, which will be re-written to the sparse array upon resetting the memory.
  *
  */
-class AddressSpace {
+class AddressSpace : public WatchableMemory {
 public:
     enum class RegionType { Program, IO };
     virtual ~AddressSpace() {}
@@ -73,6 +75,18 @@ public:
 
     void clearInitializationMemories() { m_initializationMemories.clear(); }
 
+    /// Estimated number of bytes allocated for the contents of the address space.
+    virtual size_t memoryUsage() const { return footprint::hashBytes(m_data); }
+
+    /// Estimated number of bytes allocated for the initialization memories of the address space.
+    size_t initializationMemoryUsage() const {
+        size_t bytes = footprint::bytes(m_initializationMemories);
+        for (const auto& mem : m_initializationMemories) {
+            bytes += mem.memoryUsage();
+        }
+        return bytes;
+    }
+
     virtual void reset() {
         m_data.clear();
         for (const auto& mem : m_initializationMemories) {
@@ -169,6 +183,8 @@ public:
         m_mmapRegions.erase(it);
     }
 
+    size_t memoryUsage() const override { return AddressSpace::memoryUsage() + footprint::treeBytes(m_mmapRegions); }
+
     /**
      * @brief findMMapRegion
      * Attempts to locate the memory mapped region which @param address resides in. If located, returns I/O capabilities
@@ -3,12 +3,17 @@
 
 #include "../interface/vsrtl_defines.h"
 #include "vsrtl_component.h"
+#include "vsrtl_elaborationcache.h"
 #include "vsrtl_memory.h"
+#include "vsrtl_netlistgraph.h"
 #include "vsrtl_register.h"
 
 #include <memory>
-#include <set>
+#include <optional>
+#include <sstream>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
 
 namespace vsrtl {
@@ -37,14 +42,27 @@ public:
             throw std::runtime_error("Design was not verified and initialized before clocking.");
         }
 
+        // Breakpoints fire on changes made while clocking the design, attributed to the cycle being clocked
+        getBreakpoints().arm(m_cycleCount + 1);
+
         // Save register values (to correctly clock register -> register connections)
-        for (const auto& reg : m_clockedComponents) {
-            reg->save();
+        if (m_profiling) {
+            for (uint32_t i = 0; i < m_clockedComponents.size(); ++i) {
+                const auto start = Profiler::now();
+                m_clockedComponents[i]->save();
+                m_profiler.addSave(m_clockedOrdinals[i], Profiler::now() - start);
+            }
+            m_profiler.addCycle();
+        } else {
+            for (const auto& reg : m_clockedComponents) {
+                reg->save();
+            }
         }
 
         ClockedComponent::pushReversibleCycle();
         m_cycleCount++;
         propagateDesign();
+        getBreakpoints().disarm();
         SimDesign::clock();
     }
 
@@ -54,12 +72,20 @@ public:
                 throw std::runtime_error("Design was not verified and initialized before reversing.");
             }
             // Clock registers
-            for (const auto& reg : m_clockedComponents) {
-                reg->reverse();
+            if (m_profiling) {
+                for (uint32_t i = 0; i < m_clockedComponents.size(); ++i) {
+                    const auto start = Profiler::now();
+                    m_clockedComponents[i]->reverse();
+                    m_profiler.addReverse(m_clockedOrdinals[i], Profiler::now() - start);
+                }
+            } else {
+                for (const auto& reg : m_clockedComponents) {
+                    reg->reverse();
+                }
             }
             ClockedComponent::popReversibleCycle();
             m_cycleCount--;
-            propagateDesign();
+            propagateDesignUntracked();
             SimDesign::reverse();
         }
     }
@@ -81,7 +107,7 @@ public:
         // propagate everything combinational
         for (const auto& reg : m_clockedComponents)
             reg->reset();
-        propagateDesign();
+        propagateDesignUntracked();
         ClockedComponent::resetReverseStackCount();
         m_cycleCount = 0;
         SimDesign::reset();
@@ -100,23 +126,73 @@ public:
         }
     }
 
+    /**
+     * @brief createPropagationStack
+     * Levelizes the netlist graph to find the sequence in which ports may be propagated, such that all input
+     * dependencies of each port are met when the port is propagated. With this, propagateDesign() may sequentially
+     * iterate through the propagation stack to propagate the value of each port.
+     */
     void createPropagationStack() {
-        // The circuit is traversed to find the sequence of which ports may be propagated, such that all input
-        // dependencies for each component are met when a port is propagated. With this, propagateDesign() may
-        // sequentially ierate through the propagation stack to propagate the value of each port
-        for (const auto& reg : m_clockedComponents)
-            reg->propagateComponent(m_propagationStack);
+        ElaborationTimer timer(m_elaborationReport.levelizationTime);
+        std::vector<uint32_t> levels;
+        m_propagationStack = m_netlistGraph.levelize(&levels, &m_elaborationReport.levels);
+
+        m_levelOffsets.clear();
+        for (uint32_t i = 0; i < m_propagationStack.size(); ++i) {
+            if (levels[m_propagationStack[i]->graphIndex()] == m_levelOffsets.size()) {
+                m_levelOffsets.push_back(i);
+            }
+        }
+        if (!m_propagationStack.empty()) {
+            m_levelOffsets.push_back(m_propagationStack.size());
+        }
     }
 
     void propagateDesign() {
-        for (const auto& p : m_propagationStack)
-            p->setPortValue();
+        if (m_profiling) {
+            for (const auto& p : m_propagationStack) {
+                const auto start = Profiler::now();
+                p->setPortValue();
+                m_profiler.addPortEvaluation(p->graphIndex(), Profiler::now() - start);
+            }
+        } else {
+            for (const auto& p : m_propagationStack)
+                p->setPortValue();
+        }
+        if (signalsEnabled()) {
+            emitComponentChanges();
+        }
+    }
+
+    /// Propagates the design without recording switching activity, ie. for state changes which are not the result of
+    /// clocking the design.
+    void propagateDesignUntracked() {
+        const bool tracking = m_activityTracking;
+        m_activityTracking = false;
+        propagateDesign();
+        m_activityTracking = tracking;
+    }
+
+    /**
+     * @brief setProfilingEnabled
+     * Enables profiling of port evaluations and clocked component state changes; see Profiler. Profiling incurs a
+     * timing overhead on each port evaluation, and is thus disabled by default. Enabling profiling resets the profile.
+     */
+    void setProfilingEnabled(bool enabled) override {
+        m_profilingEnabled = enabled;
+        m_profiling = false;
+        if (enabled && isVerifiedAndInitialized()) {
+            initializeProfiler();
+        }
     }
+    bool profilingEnabled() const { return m_profilingEnabled; }
+    const Profiler* getProfiler() const override { return m_profiling ? &m_profiler : nullptr; }
+    void resetProfile() { m_profiler.reset(); }
 
     void setSynchronousValue(SimSynchronous* c, VSRTL_VT_U addr, VSRTL_VT_U value) override {
         c->forceValue(addr, value);
         // Given the new output value of the register, the circuit must be repropagated
-        propagateDesign();
+        propagateDesignUntracked();
     }
 
     /**
@@ -128,70 +204,161 @@ public:
         if (isVerifiedAndInitialized())
             return;
 
-        createComponentGraph();
-
-        for (const auto& c : m_componentGraph) {
-            auto* comp = c.first->cast<Component>();
-            if (!comp) {
-                if (c.first->cast<Design>())
-                    continue;
-                else
-                    assert(false && "Trying to verify unknown component");
-            }
-            // Verify that all components has no undefined input signals
-            comp->verifyComponent();
-            // Initialize the component
-            comp->initialize();
+        m_elaborationReport = ElaborationReport();
+        collectComponents();
+        // Components are always verified and initialized; only the netlist graph and schedule may be cached.
+        verifyComponents();
+
+        ElaborationSchedule cached;
+        bool cacheHit = false;
+        if (m_elaborationCacheMode != ElaborationCacheMode::Disabled) {
+            ElaborationTimer timer(m_elaborationReport.cacheTime);
+            m_netlistGraph.indexPorts(m_components);
+            m_structuralHash.reset();
+            cacheHit =
+                cached.read(ElaborationSchedule::fileName(m_elaborationCacheDir, structuralHash()), structuralHash());
         }
 
-        if (detectCombinationalLoop()) {
-            throw std::runtime_error("Combinational loop detected in circuit");
+        if (cacheHit && m_elaborationCacheMode == ElaborationCacheMode::Enabled) {
+            ElaborationTimer timer(m_elaborationReport.cacheTime);
+            applySchedule(cached);
+        } else {
+            elaborate();
+            if (m_elaborationCacheMode != ElaborationCacheMode::Disabled) {
+                ElaborationTimer timer(m_elaborationReport.cacheTime);
+                const auto schedule = captureSchedule();
+                if (cacheHit && schedule != cached) {
+                    throw std::runtime_error("Cached elaboration schedule of design '" + getName() +
+                                             "' does not match the elaborated design");
+                }
+                if (!cacheHit) {
+                    // The cache is best-effort; failing to store a schedule only affects subsequent runs.
+                    schedule.write(ElaborationSchedule::fileName(m_elaborationCacheDir, schedule.hash));
+                }
+            }
         }
-
-        // Traverse the graph to create the optimal propagation sequence
-        createPropagationStack();
+        m_elaborationReport.cacheHit = cacheHit;
 
         // Reset the circuit to propagate initial state
         // @todo this should be changed, such that ports initially have a value of "X" until they are assigned
         reset();
 
         SimDesign::verifyAndInitialize();
+
+        if (m_profilingEnabled) {
+            initializeProfiler();
+        }
     }
 
-    bool cycleUtil(SimComponent* c, std::map<SimComponent*, bool>& visited,
-                   std::map<SimComponent*, bool>& recurseStack) {
-        visited[c] = true;
-        recurseStack[c] = true;
-        if (!dynamic_cast<ClockedComponent*>(c))  // Graph is cut at registers
-            return false;
+    /**
+     * @brief setElaborationCache
+     * Enables caching of the elaborated schedule of the design within @p directory. Schedules are keyed by a structural
+     * hash of the component and port hierarchy of the design, and a cached schedule allows verifyAndInitialize() to
+     * skip loop detection and levelization of the design.
+     * @pre Must be called prior to verifyAndInitialize().
+     */
+    void setElaborationCache(const std::string& directory, ElaborationCacheMode mode = ElaborationCacheMode::Enabled) {
+        m_elaborationCacheDir = directory;
+        m_elaborationCacheMode = mode;
+    }
 
-        for (const auto& neighbour : m_componentGraph[c]) {
-            if (!visited[neighbour] && cycleUtil(neighbour, visited, recurseStack)) {
-                return true;
-            } else if (recurseStack[neighbour]) {
-                return true;
+    /**
+     * @brief structuralHash
+     * Hash of the component and port hierarchy of the design, including port connections, propagation functions,
+     * sensitivity lists and the dynamic type of each component.
+     * @pre Only valid during verifyAndInitialize(), after the ports of the design have been indexed.
+     */
+    uint64_t structuralHash() {
+        if (m_structuralHash) {
+            return *m_structuralHash;
+        }
+        auto ordinal = [](const PortBase* p) { return p ? p->graphIndex() : NetlistGraph::NoIndex; };
+
+        StructuralHash h;
+        h.add(static_cast<uint32_t>(m_components.size()));
+        h.add(static_cast<uint32_t>(m_netlistGraph.ports().size()));
+        for (auto* c : m_components) {
+            h.add(typeid(*c).name());
+            h.add(c->getName());
+            h.add(c->isSynchronous());
+            h.add(static_cast<uint32_t>(c->getSubComponents().size()));
+            h.add(static_cast<uint32_t>(c->getSensitivityList().size()));
+            for (const auto* sens : c->getSensitivityList()) {
+                h.add(ordinal(sens));
+            }
+            for (auto* p : c->getAllPorts<PortBase>()) {
+                h.add(p->getName());
+                h.add(p->getWidth());
+                h.add(p->type());
+                h.add(p->hasPropagationFunction());
+                h.add(ordinal(p->getInputPort<PortBase>()));
             }
         }
-
-        recurseStack[c] = false;
-        return false;
+        m_structuralHash = h.value();
+        return *m_structuralHash;
     }
 
+    /**
+     * @brief detectCombinationalLoop
+     * Locates all combinational loops within the netlist graph of the design. The ports of each loop are available
+     * through getCombinationalLoops().
+     * @returns true if any combinational loops exist.
+     */
     bool detectCombinationalLoop() {
-        std::map<SimComponent*, bool> visited;
-        for (const auto& cptr : m_componentGraph) {
-            visited[cptr.first] = false;
-        }
-        std::map<SimComponent*, bool> recurseStack;
+        ElaborationTimer timer(m_elaborationReport.loopDetectionTime);
+        m_combinationalLoops = m_netlistGraph.findCombinationalLoops();
+        return !m_combinationalLoops.empty();
+    }
 
-        for (const auto& c : m_componentGraph) {
-            if (visited[c.first] == false) {
-                return cycleUtil(c.first, visited, recurseStack);
-            } else {
-                return false;
-            }
+    const std::vector<std::vector<PortBase*>>& getCombinationalLoops() const { return m_combinationalLoops; }
+
+    /**
+     * @brief getElaborationReport
+     * @returns statistics and per-phase timings of the most recent call to verifyAndInitialize().
+     */
+    const ElaborationReport& getElaborationReport() const { return m_elaborationReport; }
+
+    const std::vector<PortBase*>& getPropagationStack() const { return m_propagationStack; }
+
+    /// Registers of the design, available after verifyAndInitialize().
+    const std::vector<RegisterBase*>& getRegisterComponents() const { return m_registers; }
+
+    /// Address spaces of the design; see createMemory().
+    const std::vector<std::unique_ptr<AddressSpace>>& getMemories() const { return m_memories; }
+
+    void accountMemory(MemoryFootprint::Usage& usage) const override {
+        SimDesign::accountMemory(usage);
+        // The design object itself is not allocated within its own arena. Designs created through create() have
+        // their allocation accounted for; for other designs, the size of derived design classes is unknown.
+        if (allocatedSize() == 0) {
+            usage[MemoryFootprint::Components] += sizeof(Design);
         }
-        return false;
+        for (const auto& memory : m_memories) {
+            usage[MemoryFootprint::AddressSpaces] += sizeof(AddressSpace) + memory->memoryUsage();
+            usage[MemoryFootprint::InitializationMemories] += memory->initializationMemoryUsage();
+        }
+        size_t elaboration = footprint::bytes(m_components) + footprint::bytes(m_registers) +
+                             footprint::bytes(m_clockedComponents) + footprint::bytes(m_memories) +
+                             m_netlistGraph.memoryUsage() + footprint::bytes(m_combinationalLoops) +
+                             footprint::bytes(m_propagationStack) + footprint::bytes(m_levelOffsets);
+        for (const auto& loop : m_combinationalLoops) {
+            elaboration += footprint::bytes(loop);
+        }
+        usage[MemoryFootprint::Elaboration] += elaboration;
+        usage[MemoryFootprint::Tracing] += m_profiler.memoryUsage() + footprint::bytes(m_clockedOrdinals);
+    }
+
+    /**
+     * @brief create
+     * Allocates a design of type @p T, recording its allocation such that memory footprints of the design account for
+     * the full size of the design object (see getMemoryFootprint()).
+     */
+    template <typename T, typename... Args>
+    static std::unique_ptr<T> create(Args&&... args) {
+        static_assert(std::is_base_of<Design, T>::value);
+        auto design = std::make_unique<T>(std::forward<Args>(args)...);
+        design->recordAllocation();
+        return design;
     }
 
     template <typename T>
@@ -204,27 +371,175 @@ public:
     }
 
 private:
-    void createComponentGraph() {
-        m_componentGraph.clear();
-        getComponentGraph(m_componentGraph);
-
-        // Gather all registers in the design
-        for (const auto& c : m_componentGraph) {
-            if (auto* cc = dynamic_cast<ClockedComponent*>(c.first)) {
-                m_clockedComponents.insert(cc);
+    /**
+     * @brief verifyComponents
+     * Verifies and initializes all components of the design.
+     */
+    void verifyComponents() {
+        ElaborationTimer timer(m_elaborationReport.verifyTime);
+        for (auto* comp : m_components) {
+            // Verify that all components has no undefined input signals
+            comp->verifyComponent();
+            // Initialize the component
+            comp->initialize();
+        }
+    }
+
+    /**
+     * @brief elaborate
+     * Builds the netlist graph of the design, and creates the propagation stack from the graph.
+     */
+    void elaborate() {
+        {
+            ElaborationTimer timer(m_elaborationReport.graphTime);
+            m_netlistGraph.build(m_components);
+            m_elaborationReport.ports = m_netlistGraph.ports().size();
+            m_elaborationReport.edges = m_netlistGraph.edgeCount();
+        }
+
+        if (detectCombinationalLoop()) {
+            std::stringstream ss;
+            ss << "Combinational loop detected in circuit";
+            for (const auto& loop : m_combinationalLoops) {
+                ss << "\n  loop:";
+                for (const auto* port : loop) {
+                    ss << " " << port->getHierName();
+                }
             }
-            if (auto* rb = dynamic_cast<RegisterBase*>(c.first)) {
-                m_registers.insert(rb);
+            throw std::runtime_error(ss.str());
+        }
+
+        // Levelize the graph to create the propagation sequence
+        createPropagationStack();
+
+        for (auto* cc : m_clockedComponents) {
+            if (auto* rb = dynamic_cast<RegisterBase*>(cc)) {
+                m_registers.push_back(rb);
             }
         }
     }
 
-    std::map<SimComponent*, std::vector<SimComponent*>> m_componentGraph;
-    std::set<RegisterBase*> m_registers;
-    std::set<ClockedComponent*> m_clockedComponents;
+    /**
+     * @brief collectComponents
+     * Flattens the component hierarchy of the design, gathering all clocked components.
+     */
+    void collectComponents() {
+        ElaborationTimer timer(m_elaborationReport.collectTime);
+        m_components.clear();
+        m_clockedComponents.clear();
+        m_registers.clear();
+
+        std::vector<Component*> stack = getSubComponents<Component>();
+        while (!stack.empty()) {
+            auto* c = stack.back();
+            stack.pop_back();
+            m_components.push_back(c);
+            if (c->isSynchronous()) {
+                // Only synchronous components may be clocked components; avoid casting the remainder of the design
+                if (auto* cc = dynamic_cast<ClockedComponent*>(c)) {
+                    m_clockedComponents.push_back(cc);
+                }
+            }
+            for (auto* sc : c->getSubComponents<Component>()) {
+                stack.push_back(sc);
+            }
+        }
+        m_elaborationReport.components = m_components.size();
+    }
+
+    /// Assigns profiler ordinals to all components and ports of the design.
+    void initializeProfiler() {
+        std::unordered_map<const SimComponent*, uint32_t> ordinals;
+        std::vector<Profiler::ComponentProfile> components(m_components.size());
+        for (uint32_t i = 0; i < m_components.size(); ++i) {
+            ordinals[m_components[i]] = i;
+        }
+        for (uint32_t i = 0; i < m_components.size(); ++i) {
+            auto it = ordinals.find(m_components[i]->getParent<SimComponent>());
+            components[i].component = m_components[i];
+            components[i].name = m_components[i]->getName();
+            components[i].parent = it == ordinals.end() ? Profiler::NoParent : it->second;
+        }
+        std::vector<uint32_t> portOwners;
+        portOwners.reserve(m_netlistGraph.ports().size());
+        for (const auto* p : m_netlistGraph.ports()) {
+            portOwners.push_back(ordinals.at(p->getParent<SimComponent>()));
+        }
+        m_clockedOrdinals.clear();
+        for (const auto* c : m_clockedComponents) {
+            m_clockedOrdinals.push_back(ordinals.at(c));
+        }
+        m_profiler.initialize(std::move(components), std::move(portOwners));
+        m_profiling = true;
+    }
+
+    /**
+     * @brief captureSchedule
+     * @returns the schedule of the elaborated design, expressed in port and component ordinals.
+     */
+    ElaborationSchedule captureSchedule() {
+        ElaborationSchedule schedule;
+        schedule.hash = structuralHash();
+        schedule.components = m_components.size();
+        schedule.ports = m_netlistGraph.ports().size();
+        for (const auto* p : m_propagationStack) {
+            schedule.propagationOrder.push_back(p->graphIndex());
+        }
+        schedule.levelOffsets = m_levelOffsets;
+
+        std::unordered_map<const Component*, uint32_t> componentOrdinals;
+        for (uint32_t i = 0; i < m_components.size(); ++i) {
+            componentOrdinals[m_components[i]] = i;
+        }
+        for (const auto* r : m_registers) {
+            schedule.registers.push_back(componentOrdinals.at(r));
+        }
+        return schedule;
+    }
+
+    /**
+     * @brief applySchedule
+     * Initializes the design from a cached schedule, in place of elaborating the design.
+     */
+    void applySchedule(const ElaborationSchedule& schedule) {
+        // Constants have already been propagated when initializing the components; see verifyComponents()
+        const auto& ports = m_netlistGraph.ports();
+        m_propagationStack.clear();
+        m_propagationStack.reserve(schedule.propagationOrder.size());
+        for (uint32_t p : schedule.propagationOrder) {
+            m_propagationStack.push_back(ports[p]);
+        }
+        m_levelOffsets = schedule.levelOffsets;
+        for (uint32_t r : schedule.registers) {
+            // The dynamic type of each component is part of the structural hash
+            m_registers.push_back(static_cast<RegisterBase*>(m_components[r]));
+        }
+        m_elaborationReport.ports = ports.size();
+        m_elaborationReport.levels = schedule.levels();
+    }
+
+    std::vector<Component*> m_components;
+    std::vector<RegisterBase*> m_registers;
+    std::vector<ClockedComponent*> m_clockedComponents;
     std::vector<std::unique_ptr<AddressSpace>> m_memories;
 
+    NetlistGraph m_netlistGraph;
+    std::vector<std::vector<PortBase*>> m_combinationalLoops;
+    ElaborationReport m_elaborationReport;
     std::vector<PortBase*> m_propagationStack;
+    std::vector<uint32_t> m_levelOffsets;
+
+    // Elaboration cache
+    std::string m_elaborationCacheDir;
+    ElaborationCacheMode m_elaborationCacheMode = ElaborationCacheMode::Disabled;
+    std::optional<uint64_t> m_structuralHash;
+
+    Profiler m_profiler;
+    /// Ordinal of each clocked component within the profiler
+    std::vector<uint32_t> m_clockedOrdinals;
+    bool m_profilingEnabled = false;
+    /// Profiling is active once the design has been verified and initialized
+    bool m_profiling = false;
 };
 
 }  // namespace core
@@ -0,0 +1,169 @@
+#ifndef VSRTL_ELABORATIONCACHE_H
+#define VSRTL_ELABORATIONCACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace vsrtl {
+namespace core {
+
+enum class ElaborationCacheMode {
+    Disabled,
+    /// Elaborated schedules are loaded from, and stored to, the cache directory.
+    Enabled,
+    /// As Enabled, but a cached schedule is verified against a full elaboration of the design.
+    Verify
+};
+
+/**
+ * @brief The StructuralHash class
+ * 64-bit FNV-1a hash, used for hashing the component and port hierarchy of a design.
+ */
+class StructuralHash {
+public:
+    void add(const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ull;
+        }
+    }
+    void add(const std::string& s) {
+        add(static_cast<uint64_t>(s.size()));
+        add(s.data(), s.size());
+    }
+    void add(const char* s) {
+        const size_t size = std::strlen(s);
+        add(static_cast<uint64_t>(size));
+        add(s, size);
+    }
+    template <typename T>
+    void add(const T& v) {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value);
+        add(&v, sizeof(T));
+    }
+
+    uint64_t value() const { return m_hash; }
+
+private:
+    uint64_t m_hash = 14695981039346656037ull;
+};
+
+/**
+ * @brief The ElaborationSchedule struct
+ * The outcome of elaborating a design. Ports and components are referred to by their ordinal, being their index within
+ * the flattened port- and component lists of the design (see Design::collectComponents()).
+ */
+struct ElaborationSchedule {
+    static constexpr uint32_t Magic = 0x56534543;  // "VSEC"
+    static constexpr uint32_t Version = 2;
+
+    uint64_t hash = 0;
+    uint32_t components = 0;
+    uint32_t ports = 0;
+    /// Ports in propagation order
+    std::vector<uint32_t> propagationOrder;
+    /// Offset of the first port of each level within propagationOrder, terminated by propagationOrder.size()
+    std::vector<uint32_t> levelOffsets;
+    std::vector<uint32_t> registers;
+
+    size_t levels() const { return levelOffsets.empty() ? 0 : levelOffsets.size() - 1; }
+
+    bool operator==(const ElaborationSchedule& other) const {
+        return hash == other.hash && components == other.components && ports == other.ports &&
+               propagationOrder == other.propagationOrder && levelOffsets == other.levelOffsets &&
+               registers == other.registers;
+    }
+    bool operator!=(const ElaborationSchedule& other) const { return !(*this == other); }
+
+    static std::string fileName(const std::string& directory, uint64_t hash) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.vsrtlelab", static_cast<unsigned long long>(hash));
+        return directory + "/" + name;
+    }
+
+    bool write(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        writeValue(file, Magic);
+        writeValue(file, Version);
+        writeValue(file, hash);
+        writeValue(file, components);
+        writeValue(file, ports);
+        for (const auto* v : {&propagationOrder, &levelOffsets, &registers}) {
+            writeValue(file, static_cast<uint32_t>(v->size()));
+            file.write(reinterpret_cast<const char*>(v->data()), v->size() * sizeof(uint32_t));
+        }
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief read
+     * Reads a schedule from @p path. A schedule which cannot be read, was written by a different version, or does not
+     * match @p expectedHash is rejected.
+     */
+    bool read(const std::string& path, uint64_t expectedHash) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        uint32_t magic = 0, version = 0;
+        if (!readValue(file, magic) || magic != Magic || !readValue(file, version) || version != Version) {
+            return false;
+        }
+        if (!readValue(file, hash) || hash != expectedHash || !readValue(file, components) || !readValue(file, ports)) {
+            return false;
+        }
+        for (auto* v : {&propagationOrder, &levelOffsets, &registers}) {
+            uint32_t size = 0;
+            if (!readValue(file, size) || size > ports) {
+                return false;
+            }
+            v->resize(size);
+            if (!file.read(reinterpret_cast<char*>(v->data()), size * sizeof(uint32_t))) {
+                return false;
+            }
+        }
+        return isConsistent();
+    }
+
+private:
+    /// Guards against indexing out of bounds when applying a corrupted schedule
+    bool isConsistent() const {
+        for (uint32_t p : propagationOrder) {
+            if (p >= ports) {
+                return false;
+            }
+        }
+        for (uint32_t r : registers) {
+            if (r >= components) {
+                return false;
+            }
+        }
+        if (levelOffsets.empty() || levelOffsets.back() != propagationOrder.size()) {
+            return propagationOrder.empty() && levelOffsets.empty();
+        }
+        return true;
+    }
+
+    template <typename T>
+    static void writeValue(std::ofstream& file, const T& v) {
+        file.write(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+    template <typename T>
+    static bool readValue(std::ifstream& file, T& v) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&v), sizeof(T)));
+    }
+};
+
+}  // namespace core
+}  // namespace vsrtl
+
+#endif  // VSRTL_ELABORATIONCACHE_H
@@ -32,11 +32,24 @@ public:
     virtual AddressSpace::RegionType accessRegion() const = 0;
 
     VSRTL_VT_U read(VSRTL_VT_U address, int size, unsigned wordShift) {
+        const VSRTL_VT_U byteAddress = byteIndexed ? address : address << wordShift;
+        if (auto* watcher = m_memory->watcher()) {
+            watcher->memoryAccessed(*m_memory, byteAddress, size, BreakpointEngine::Read);
+        }
+        return m_memory->readMem(byteAddress, size);
+    }
+
+    /// Reads memory without notifying watchpoints, ie. to save the data which a write is about to overwrite.
+    VSRTL_VT_U readUnwatched(VSRTL_VT_U address, int size, unsigned wordShift) {
         return m_memory->readMem(byteIndexed ? address : address << wordShift, size);
     }
 
     void write(VSRTL_VT_U address, VSRTL_VT_U value, int size, unsigned wordShift) {
-        m_memory->writeMem(byteIndexed ? address : address << wordShift, value, size);
+        const VSRTL_VT_U byteAddress = byteIndexed ? address : address << wordShift;
+        if (auto* watcher = m_memory->watcher()) {
+            watcher->memoryAccessed(*m_memory, byteAddress, size, BreakpointEngine::Write);
+        }
+        m_memory->writeMem(byteAddress, value, size);
     }
 
     // Width-independent accessors to memory in- and output signals.
@@ -62,7 +75,7 @@ public:
         if (writeEnable) {
             const VSRTL_VT_U addr_v = addr.uValue();
             const VSRTL_VT_U data_in_v = data_in.uValue();
-            const VSRTL_VT_U data_out_v = this->read(addr_v, dataWidth / CHAR_BIT, wordshift);
+            const VSRTL_VT_U data_out_v = this->readUnwatched(addr_v, dataWidth / CHAR_BIT, wordshift);
             const VSRTL_VT_U wr_width_v = wr_width.uValue();
             // save() is called prior to cycle incrementation; WrMemory::reverse() relies on an eviction being listed
             // for the cycle which the 'reverse' call happened in.´
@@ -97,6 +110,11 @@ public:
     INPUTPORT(wr_width, ceillog2(dataWidth / CHAR_BIT + 1));  // # bytes
     INPUTPORT(wr_en, 1);
 
+    void accountMemory(MemoryFootprint::Usage& usage) const override {
+        ClockedComponent::accountMemory(usage);
+        usage[MemoryFootprint::ReverseStacks] += footprint::bytes(m_reverseStack);
+    }
+
 protected:
     void reverseStackSizeChanged() override {
         if (reverseStackSize() < m_reverseStack.size()) {
@@ -0,0 +1,331 @@
+#ifndef VSRTL_NETLISTGRAPH_H
+#define VSRTL_NETLISTGRAPH_H
+
+#include "vsrtl_component.h"
+#include "vsrtl_port.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace vsrtl {
+namespace core {
+
+/**
+ * @brief The ElaborationReport struct
+ * Statistics and per-phase wall-clock timings (in milliseconds) of the elaboration of a design.
+ */
+struct ElaborationReport {
+    double collectTime = 0;
+    double verifyTime = 0;
+    double graphTime = 0;
+    double loopDetectionTime = 0;
+    double levelizationTime = 0;
+    /// Time spent hashing the design and accessing the elaboration cache
+    double cacheTime = 0;
+    bool cacheHit = false;
+
+    size_t components = 0;
+    size_t ports = 0;
+    size_t edges = 0;
+    size_t levels = 0;
+
+    double totalTime() const {
+        return collectTime + verifyTime + graphTime + loopDetectionTime + levelizationTime + cacheTime;
+    }
+
+    void print(std::ostream& os) const {
+        os << "Elaboration: " << components << " components, " << ports << " ports, " << edges << " edges, "
+           << levels << " levels\n";
+        os << "  collect components: " << collectTime << " ms\n";
+        os << "  verify & initialize: " << verifyTime << " ms\n";
+        os << "  build netlist graph: " << graphTime << " ms\n";
+        os << "  loop detection: " << loopDetectionTime << " ms\n";
+        os << "  levelization: " << levelizationTime << " ms\n";
+        os << "  elaboration cache: " << cacheTime << " ms" << (cacheHit ? " (hit)" : "") << "\n";
+        os << "  total: " << totalTime() << " ms\n";
+    }
+};
+
+/**
+ * @brief The ElaborationTimer class
+ * Accumulates the time elapsed between construction and destruction into @p ms.
+ */
+class ElaborationTimer {
+public:
+    ElaborationTimer(double& ms) : m_ms(ms), m_start(std::chrono::steady_clock::now()) {}
+    ~ElaborationTimer() {
+        m_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    double& m_ms;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * @brief The NetlistGraph class
+ * Flat dependency graph of the ports of a design. An edge u -> v states that the value of port v is a
+ * function of the value of port u, being either:
+ *  - u is the input port of v (v copies the value of u), or
+ *  - v is an output port of a combinational component, with u being an input port (or sensitivity list entry) of
+ *    that component.
+ * Output ports of clocked components are sources of the graph; their values are a function of the state of the
+ * component, and thus the graph is cut at registers and other clocked components. Constant ports have no edges.
+ *
+ * The graph is stored as compressed adjacency arrays (fan-out of port i is m_edges[m_offsets[i]..m_offsets[i+1]]),
+ * and all algorithms are iterative, such that arbitrarily deep or large designs may be elaborated without recursion.
+ */
+class NetlistGraph {
+public:
+    static constexpr uint32_t NoIndex = UINT32_MAX;
+
+    /**
+     * @brief indexPorts
+     * Assigns a graph index to each port of @p components, being the index of the port within the flattened port list
+     * of the components.
+     */
+    void indexPorts(const std::vector<Component*>& components) {
+        clear();
+        for (auto* c : components) {
+            for (auto* p : c->getAllPorts<PortBase>()) {
+                p->setGraphIndex(static_cast<uint32_t>(m_ports.size()));
+                m_ports.push_back(p);
+            }
+        }
+    }
+
+    /**
+     * @brief build
+     * Builds the graph from the ports of @p components. Constant ports (see Component::initialize()) are isolated
+     * within the graph, and thus components must have been initialized prior to building the graph.
+     */
+    void build(const std::vector<Component*>& components) {
+        indexPorts(components);
+
+        // Count the fan-out of each port, and accumulate into offsets
+        m_offsets.assign(m_ports.size() + 1, 0);
+        for (uint32_t v = 0; v < m_ports.size(); ++v) {
+            forEachDependency(v, [&](uint32_t u) { m_offsets[u + 1]++; });
+        }
+        for (size_t i = 1; i < m_offsets.size(); ++i) {
+            m_offsets[i] += m_offsets[i - 1];
+        }
+
+        // Fill the edges
+        m_edges.resize(m_offsets.back());
+        std::vector<uint32_t> fill(m_offsets.begin(), m_offsets.end() - 1);
+        for (uint32_t v = 0; v < m_ports.size(); ++v) {
+            forEachDependency(v, [&](uint32_t u) { m_edges[fill[u]++] = v; });
+        }
+    }
+
+    void clear() {
+        for (auto* p : m_ports) {
+            p->setGraphIndex(NoIndex);
+        }
+        m_ports.clear();
+        m_offsets.clear();
+        m_edges.clear();
+    }
+
+    /**
+     * @brief findCombinationalLoops
+     * Locates all strongly connected components of the graph through an iterative implementation of Tarjan's
+     * algorithm. Each strongly connected component with more than a single port (or a port depending on itself) is a
+     * combinational loop.
+     * @returns the ports of each combinational loop in the graph.
+     */
+    std::vector<std::vector<PortBase*>> findCombinationalLoops() const {
+        const uint32_t n = static_cast<uint32_t>(m_ports.size());
+        std::vector<uint32_t> index(n, NoIndex);
+        std::vector<uint32_t> lowlink(n, 0);
+        std::vector<bool> onStack(n, false);
+        std::vector<uint32_t> sccStack;
+        std::vector<std::vector<PortBase*>> loops;
+
+        // Explicit call stack of (node, next edge to visit)
+        std::vector<std::pair<uint32_t, uint32_t>> callStack;
+        uint32_t nextIndex = 0;
+
+        for (uint32_t root = 0; root < n; ++root) {
+            if (index[root] != NoIndex) {
+                continue;
+            }
+            callStack.push_back({root, m_offsets[root]});
+            index[root] = lowlink[root] = nextIndex++;
+            sccStack.push_back(root);
+            onStack[root] = true;
+
+            while (!callStack.empty()) {
+                auto& [v, edge] = callStack.back();
+                if (edge < m_offsets[v + 1]) {
+                    const uint32_t w = m_edges[edge++];
+                    if (index[w] == NoIndex) {
+                        // Descend into w
+                        index[w] = lowlink[w] = nextIndex++;
+                        sccStack.push_back(w);
+                        onStack[w] = true;
+                        callStack.push_back({w, m_offsets[w]});
+                    } else if (onStack[w]) {
+                        lowlink[v] = std::min(lowlink[v], index[w]);
+                    }
+                    continue;
+                }
+
+                // All successors of v visited
+                const uint32_t done = v;
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    const uint32_t parent = callStack.back().first;
+                    lowlink[parent] = std::min(lowlink[parent], lowlink[done]);
+                }
+
+                if (lowlink[done] == index[done]) {
+                    std::vector<PortBase*> scc;
+                    uint32_t w;
+                    do {
+                        w = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[w] = false;
+                        scc.push_back(m_ports[w]);
+                    } while (w != done);
+
+                    if (scc.size() > 1 || hasEdge(done, done)) {
+                        std::reverse(scc.begin(), scc.end());
+                        loops.push_back(std::move(scc));
+                    }
+                }
+            }
+        }
+        return loops;
+    }
+
+    /**
+     * @brief levelize
+     * Kahn-style topological sort of the graph. Ports are assigned to levels, where level 0 contains ports without
+     * dependencies, and each port resides one level above its deepest dependency.
+     * @returns the non-constant ports of the graph in propagation order, ie. sorted by level. If @p levels is provided,
+     * the level of each port (indexed by graph index) is written to it.
+     * @pre the graph is acyclic.
+     */
+    std::vector<PortBase*> levelize(std::vector<uint32_t>* levels = nullptr, size_t* levelCount = nullptr) const {
+        const uint32_t n = static_cast<uint32_t>(m_ports.size());
+        std::vector<uint32_t> indegree(n, 0);
+        for (uint32_t w : m_edges) {
+            indegree[w]++;
+        }
+
+        std::vector<uint32_t> level(n, 0);
+        std::vector<uint32_t> frontier;
+        std::vector<uint32_t> nextFrontier;
+        uint32_t constants = 0;
+        for (uint32_t v = 0; v < n; ++v) {
+            if (m_ports[v]->isConstant()) {
+                constants++;
+            } else if (indegree[v] == 0) {
+                frontier.push_back(v);
+            }
+        }
+
+        std::vector<PortBase*> order;
+        order.reserve(n);
+        uint32_t currentLevel = 0;
+        while (!frontier.empty()) {
+            for (uint32_t v : frontier) {
+                level[v] = currentLevel;
+                order.push_back(m_ports[v]);
+                for (uint32_t e = m_offsets[v]; e < m_offsets[v + 1]; ++e) {
+                    const uint32_t w = m_edges[e];
+                    if (--indegree[w] == 0) {
+                        nextFrontier.push_back(w);
+                    }
+                }
+            }
+            frontier.swap(nextFrontier);
+            nextFrontier.clear();
+            currentLevel++;
+        }
+
+        if (order.size() + constants != n) {
+            throw std::runtime_error("Cannot levelize a netlist graph containing combinational loops");
+        }
+
+        if (levels) {
+            *levels = std::move(level);
+        }
+        if (levelCount) {
+            *levelCount = currentLevel;
+        }
+        return order;
+    }
+
+    const std::vector<PortBase*>& ports() const { return m_ports; }
+
+    /// Estimated number of bytes allocated by the graph.
+    size_t memoryUsage() const {
+        return footprint::bytes(m_ports) + footprint::bytes(m_offsets) + footprint::bytes(m_edges);
+    }
+
+    size_t edgeCount() const { return m_edges.size(); }
+
+    /// Ports which depend on the port with graph index @p i
+    template <typename F>
+    void forEachDependent(uint32_t i, const F& f) const {
+        for (uint32_t e = m_offsets[i]; e < m_offsets[i + 1]; ++e) {
+            f(m_edges[e]);
+        }
+    }
+
+private:
+    bool hasEdge(uint32_t from, uint32_t to) const {
+        for (uint32_t e = m_offsets[from]; e < m_offsets[from + 1]; ++e) {
+            if (m_edges[e] == to) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Executes @p f(u) for each port u which port v depends on.
+    template <typename F>
+    void forEachDependency(uint32_t v, const F& f) const {
+        auto visit = [&](const PortBase* u) {
+            if (u && !u->isConstant() && u->graphIndex() != NoIndex) {
+                f(u->graphIndex());
+            }
+        };
+
+        PortBase* port = m_ports[v];
+        if (port->isConstant()) {
+            return;
+        }
+        if (!port->hasPropagationFunction()) {
+            visit(port->getInputPort<PortBase>());
+            return;
+        }
+
+        auto* component = port->getParent<Component>();
+        if (component->isSynchronous()) {
+            // Outputs of clocked components are a function of the state of the component
+            return;
+        }
+        for (const auto* input : component->getPorts<SimPort::PortType::in, PortBase>()) {
+            visit(input);
+        }
+        for (const auto* sens : component->getSensitivityList()) {
+            visit(sens);
+        }
+    }
+
+    std::vector<PortBase*> m_ports;
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_edges;
+};
+
+}  // namespace core
+}  // namespace vsrtl
+
+#endif  // VSRTL_NETLISTGRAPH_H
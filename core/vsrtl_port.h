@@ -29,17 +29,32 @@ public:
         assert(parent != nullptr);
     }
 
-    bool isPropagated() const { return m_propagationState != PropagationState::unpropagated; }
     bool isConstant() const override { return m_propagationState == PropagationState::constant; }
-    void resetPropagation() {
-        m_propagationState =
-            m_propagationState == PropagationState::constant ? m_propagationState : PropagationState::unpropagated;
-    }
 
-    virtual void propagate(std::vector<PortBase*>& propagationStack) = 0;
+    /**
+     * @brief setConstant
+     * Marks the port as constant and assigns its value, without propagating the constant to connected ports.
+     */
+    void setConstant() {
+        m_propagationState = PropagationState::constant;
+        setPortValue();
+    }
     virtual void propagateConstant() = 0;
     virtual void setPortValue() = 0;
     virtual bool isConnected() const = 0;
+    /**
+     * @brief hasPropagationFunction
+     * @returns true if the value of this port is computed by its parent component, rather than being copied from its
+     * input port.
+     */
+    virtual bool hasPropagationFunction() const = 0;
+
+    /**
+     * @brief graphIndex
+     * Index of this port within the netlist graph of the design, assigned during elaboration.
+     */
+    uint32_t graphIndex() const { return m_graphIndex; }
+    void setGraphIndex(uint32_t index) { m_graphIndex = index; }
 
     /**
      * @brief stringValue
@@ -54,6 +69,7 @@ public:
 
 protected:
     PropagationState m_propagationState = PropagationState::unpropagated;
+    uint32_t m_graphIndex = UINT32_MAX;
 };
 
 template <unsigned int W>
@@ -61,6 +77,7 @@ class Port : public PortBase {
 public:
     Port(const std::string& name, SimComponent* parent, PortType type) : PortBase(name, parent, type) {}
     bool isConnected() const override { return m_inputPort != nullptr || m_propagationFunction; }
+    bool hasPropagationFunction() const override { return static_cast<bool>(m_propagationFunction); }
 
     // Port connections are doubly linked
     void operator>>(Port<W>& toThis) {
@@ -93,26 +110,29 @@ public:
             m_value = getInputPort<Port<W>>()->uValue();
         }
         if (m_value != prePropagateValue) {
+            auto* design = getDesign();
+            if (design->activityTrackingEnabled()) {
+                const VSRTL_VT_U flipped = (m_value ^ prePropagateValue) & generateBitmask(W);
+                if (flipped) {
+                    recordActivity(design, flipped);
+                }
+            }
+            if (isWatched()) {
+                design->getBreakpoints().portChanged(*this);
+            }
             // Signal all watcher of this port that the port value changed
-            if (getDesign()->signalsEnabled()) {
+            if (design->signalsEnabled()) {
                 changed.Emit();
+                if (type() == PortType::out) {
+                    // Ports are always owned by components
+                    design->queueComponentChange(static_cast<SimComponent*>(m_parent));
+                }
             }
         }
     }
 
-    void propagate(std::vector<PortBase*>& propagationStack) override {
-        if (m_propagationState == PropagationState::unpropagated) {
-            propagationStack.push_back(this);
-            // Propagate the value to the ports which connect to this
-            for (const auto& port : getOutputPorts<Port<W>>())
-                port->propagate(propagationStack);
-            m_propagationState = PropagationState::propagated;
-        }
-    }
-
     void propagateConstant() override {
-        m_propagationState = PropagationState::constant;
-        setPortValue();
+        setConstant();
         for (const auto& port : getOutputPorts<Port<W>>())
             port->propagateConstant();
     }
@@ -124,6 +144,15 @@ public:
         m_propagationFunction = propagationFunction;
     }
 
+    void accountMemory(MemoryFootprint::Usage& usage) const override {
+        PortBase::accountMemory(usage);
+        if (m_propagationFunction) {
+            // Attribute the function object to the propagation function rather than the port itself
+            usage[MemoryFootprint::Ports] -= sizeof(m_propagationFunction);
+            usage[MemoryFootprint::PropagationFunctions] += sizeof(m_propagationFunction);
+        }
+    }
+
     // Value access operators
     explicit operator VSRTL_VT_U() const { return m_value; }
     explicit operator bool() const { return m_value & 0b1; }
@@ -143,7 +172,8 @@ public:
     EnumPort(const std::string& name, Component* parent, vsrtl::SimPort::PortType type) : Port<W>(name, parent, type) {}
 
     bool isEnumPort() const override { return true; }
-    std::string valueToEnumString() const override { return E_t::_from_integral(this->uValue())._to_string(); }
+    std::string valueToEnumString() const override { return valueToEnumString(this->uValue()); }
+    std::string valueToEnumString(VSRTL_VT_U value) const override { return E_t::_from_integral(value)._to_string(); }
     VSRTL_VT_U enumStringToValue(const char* str) const override { return E_t::_from_string(str); }
 };
 
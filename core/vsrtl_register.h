@@ -148,6 +148,11 @@ public:
         }
     }
 
+    void accountMemory(MemoryFootprint::Usage& usage) const override {
+        RegisterBase::accountMemory(usage);
+        usage[MemoryFootprint::ReverseStacks] += footprint::bytes(m_reverseStack);
+    }
+
 protected:
     void saveToStack() {
         m_reverseStack.push_front(m_savedValue);
@@ -245,6 +250,12 @@ public:
         }
     }
 
+    void accountMemory(MemoryFootprint::Usage& usage) const override {
+        RegisterBase::accountMemory(usage);
+        usage[MemoryFootprint::Components] += footprint::bytes(m_savedValues);
+        usage[MemoryFootprint::ReverseStacks] += footprint::bytes(m_reverseStack);
+    }
+
 protected:
     void stagesChanged() { m_savedValues.resize(stages.getValue()); }
 
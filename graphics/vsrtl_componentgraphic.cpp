@@ -1,9 +1,11 @@
 #include "vsrtl_componentgraphic.h"
 
 #include "vsrtl_componentbutton.h"
+#include "vsrtl_elaborationcache.h"
 #include "vsrtl_graphics_defines.h"
 #include "vsrtl_graphics_util.h"
 #include "vsrtl_label.h"
+#include "vsrtl_layoutfile.h"
 #include "vsrtl_multiplexergraphic.h"
 #include "vsrtl_parameterdialog.h"
 #include "vsrtl_placeroute.h"
@@ -12,10 +14,12 @@
 #include "vsrtl_wiregraphic.h"
 
 #include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
 
 #include <qmath.h>
 #include <deque>
 #include <fstream>
+#include <sstream>
 
 #include <QAction>
 #include <QApplication>
@@ -31,6 +35,7 @@
 #include <QPushButton>
 #include <QStyleOptionGraphicsItem>
 
+#include <functional>
 #include <memory>
 
 namespace vsrtl {
@@ -42,6 +47,10 @@ ComponentGraphic::ComponentGraphic(SimComponent* c, ComponentGraphic* parent) :
     wrapSimSignal(c->changed);
     c->registerGraphic(this);
     verifySpecialSignals();
+
+    // Collapsed components are drawn from a pixmap cache, which is invalidated whenever the component schedules a
+    // redraw of itself (ie. when an indicator changes value).
+    setCacheMode(DeviceCoordinateCache);
 }
 
 void ComponentGraphic::verifySpecialSignals() const {
@@ -87,16 +96,12 @@ void ComponentGraphic::initialize(bool doPlaceAndRoute) {
         m_outputPorts[p_out] = new PortGraphic(p_out, vsrtl::SimPort::PortType::out, this);
     }
 
-    m_restrictSubcomponentPositioning = false;
+    // Subcomponent graphics are created upon first expanding the component; see createSubcomponentGraphics()
+    m_placeAndRoute = doPlaceAndRoute;
     if (hasSubcomponents()) {
         // Setup expand button
         m_expandButton = new ComponentButton(this);
         connect(m_expandButton, &ComponentButton::toggled, [this](bool expanded) { setExpanded(expanded); });
-
-        createSubcomponents(doPlaceAndRoute);
-        if (doPlaceAndRoute) {
-            placeAndRouteSubcomponents();
-        }
     }
 
     connect(this, &GridComponent::gridRectChanged, this, &ComponentGraphic::updateGeometry);
@@ -111,6 +116,48 @@ void ComponentGraphic::initialize(bool doPlaceAndRoute) {
     spreadPorts();
 }
 
+void ComponentGraphic::createSubcomponentGraphics(bool placeAndRoute) {
+    if (m_subcomponentGraphicsCreated || !hasSubcomponents()) {
+        return;
+    }
+    m_subcomponentGraphicsCreated = true;
+    placeAndRoute &= m_placeAndRoute;
+
+    m_restrictSubcomponentPositioning = false;
+    createSubcomponents(m_placeAndRoute);
+    if (placeAndRoute) {
+        placeAndRouteSubcomponents();
+    }
+    m_restrictSubcomponentPositioning = true;
+
+    if (m_initialized) {
+        // The scene has already been constructed; initialize the new items as if they had been part of it. Output
+        // wires of the subcomponents, and the wires from the input ports of this component, are scoped to this
+        // component, and connect to the ports of the new subcomponents.
+        for (auto* c : m_subcomponents) {
+            c->postSceneConstructionInitialize1();
+        }
+        for (auto* w : m_wires) {
+            w->postSceneConstructionInitialize1();
+        }
+        for (auto* c : m_subcomponents) {
+            c->postSceneConstructionInitialize2();
+        }
+        for (auto* w : m_wires) {
+            w->postSceneConstructionInitialize2();
+        }
+    }
+    // Layouts loaded from a binary layout file are applied once the component is first expanded
+    if (!applyPendingLayout() && m_initialized && placeAndRoute) {
+        routeWires();
+    }
+    for (auto* w : m_wires) {
+        w->setVisible(isExpanded());
+    }
+
+    emit subcomponentGraphicsCreated(this);
+}
+
 /**
  * @brief ComponentGraphic::createSubcomponents
  * In charge of hide()ing subcomponents if the parent component (this) is not expanded
@@ -131,6 +178,9 @@ void ComponentGraphic::createSubcomponents(bool doPlaceAndRoute) {
         nc->initialize(doPlaceAndRoute);
         nc->setParentItem(this);
         nc->setZValue(VSRTLScene::Z_Component);
+        // Creation of graphics within the subcomponent is announced through the top-level component
+        connect(nc, &ComponentGraphic::subcomponentGraphicsCreated, this,
+                &ComponentGraphic::subcomponentGraphicsCreated);
         m_subcomponents.push_back(nc);
         if (!isExpanded()) {
             nc->hide();
@@ -138,11 +188,71 @@ void ComponentGraphic::createSubcomponents(bool doPlaceAndRoute) {
     }
 }
 
+void ComponentGraphic::routeWires(bool reuseRoutes) {
+    if (!m_subcomponentGraphicsCreated || PlaceRoute::get()->routingAlgorithm() != RouteAlg::Grid) {
+        return;
+    }
+
+    // Wires may be routed along the border of the component, and to ports outside of it
+    const QRect& rect = getCurrentComponentRect();
+    QRect bounds(rect.topLeft(), rect.size() + QSize(1, 1));
+    std::vector<WireGraphic*> wires;
+    std::vector<GridRouter::Net> nets;
+    std::vector<RouteTree> previous;
+    for (auto* w : m_wires) {
+        if (w->getToPorts().empty()) {
+            continue;
+        }
+        wires.push_back(w);
+        nets.push_back(w->routingNet());
+        previous.push_back(reuseRoutes ? w->currentRoute() : RouteTree());
+        bounds |= QRect(nets.back().source.pos, QSize(1, 1));
+        for (const auto& sink : nets.back().sinks) {
+            bounds |= QRect(sink.pos, QSize(1, 1));
+        }
+    }
+    for (size_t i = 0; i < nets.size(); ++i) {
+        nets[i].previous = &previous[i];
+    }
+
+    GridRouter router(bounds);
+    for (auto* c : m_subcomponents) {
+        if (!c->userHidden()) {
+            // The border of a component is drawn on the grid line following its last grid point
+            const QRect r = c->getCurrentComponentRect().translated(c->getGridPos());
+            router.addObstacle(QRect(r.topLeft(), r.size() + QSize(1, 1)));
+        }
+    }
+    const auto routes = router.route(nets);
+    for (size_t i = 0; i < wires.size(); ++i) {
+        if (!router.wasReused(i)) {
+            wires[i]->applyRoute(routes[i]);
+        }
+    }
+}
+
+void ComponentGraphic::scheduleWireRouting() {
+    if (!m_routingTimer) {
+        m_routingTimer = new QTimer(this);
+        m_routingTimer->setSingleShot(true);
+        m_routingTimer->setInterval(100);
+        connect(m_routingTimer, &QTimer::timeout, this, [=] { routeWires(); });
+    }
+    m_routingTimer->start();
+}
+
 void ComponentGraphic::resetWires() {
     const QString text =
         "Reset wires?\nThis will remove all interconnecting points for all wires within this subcomponent";
 
-    if (QMessageBox::Yes == QMessageBox::question(QApplication::activeWindow(), "Reset wires", text)) {
+    if (QMessageBox::Yes != QMessageBox::question(QApplication::activeWindow(), "Reset wires", text)) {
+        return;
+    }
+
+    if (PlaceRoute::get()->routingAlgorithm() == RouteAlg::Grid) {
+        // Grid routed wires are rerouted from scratch rather than left without interconnecting points
+        routeWires(false);
+    } else {
         // Clear subcomponent wires
         for (const auto& c : m_subcomponents) {
             for (const auto& p : c->outputPorts()) {
@@ -157,6 +267,21 @@ void ComponentGraphic::resetWires() {
 }
 
 void ComponentGraphic::loadLayoutFile(const QString& fileName) {
+    // Layouts of a previously loaded binary layout which have yet to be applied are superseded by this layout
+    std::function<void(ComponentGraphic*)> discardPendingLayouts = [&](ComponentGraphic* c) {
+        c->m_pendingLayout.reset();
+        for (auto* sub : c->getGraphicSubcomponents()) {
+            discardPendingLayouts(sub);
+        }
+    };
+    discardPendingLayouts(this);
+
+    if (LayoutFile::isLayoutFile(fileName.toStdString())) {
+        loadBinaryLayout(fileName.toStdString());
+        return;
+    }
+
+    // JSON layout
     std::ifstream file(fileName.toStdString());
     cereal::JSONInputArchive archive(file);
     m_isTopLevelSerializedComponent = true;
@@ -179,9 +304,9 @@ void ComponentGraphic::loadLayoutFile(const QString& fileName) {
 }
 
 void ComponentGraphic::loadLayout() {
-    QString fileName = QFileDialog::getOpenFileName(QApplication::activeWindow(),
-                                                    "Save Layout " + QString::fromStdString(m_component->getName()),
-                                                    QString(), tr("JSON (*.json)"));
+    QString fileName = QFileDialog::getOpenFileName(
+        QApplication::activeWindow(), "Load Layout " + QString::fromStdString(m_component->getName()), QString(),
+        tr("Layout (*%1 *.json);;Binary layout (*%1);;JSON (*.json)").arg(LayoutFile::Extension));
 
     if (fileName.isEmpty())
         return;
@@ -190,14 +315,24 @@ void ComponentGraphic::loadLayout() {
 }
 
 void ComponentGraphic::saveLayout() {
-    QString fileName = QFileDialog::getSaveFileName(QApplication::activeWindow(),
-                                                    "Save Layout " + QString::fromStdString(m_component->getName()),
-                                                    QString(), tr("JSON (*.json)"));
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(
+        QApplication::activeWindow(), "Save Layout " + QString::fromStdString(m_component->getName()), QString(),
+        tr("Binary layout (*%1);;JSON (*.json)").arg(LayoutFile::Extension), &selectedFilter);
 
     if (fileName.isEmpty())
         return;
-    if (!fileName.endsWith(".json"))
-        fileName += ".json";
+
+    if (fileName.endsWith(".json") || selectedFilter.contains("*.json")) {
+        if (!fileName.endsWith(".json"))
+            fileName += ".json";
+    } else {
+        if (!fileName.endsWith(LayoutFile::Extension))
+            fileName += LayoutFile::Extension;
+        saveBinaryLayout(fileName.toStdString());
+        return;
+    }
+
     std::ofstream file(fileName.toStdString());
     cereal::JSONOutputArchive archive(file);
 
@@ -214,6 +349,174 @@ void ComponentGraphic::saveLayout() {
     m_isTopLevelSerializedComponent = false;
 }
 
+std::vector<PortGraphic*> ComponentGraphic::portsByName(const QMap<SimPort*, PortGraphic*>& ports) {
+    std::vector<PortGraphic*> sorted(ports.begin(), ports.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](PortGraphic* a, PortGraphic* b) { return a->getPort()->getName() < b->getPort()->getName(); });
+    return sorted;
+}
+
+uint64_t ComponentGraphic::layoutSignature() const {
+    core::StructuralHash hash;
+    for (const auto& pm : {m_inputPorts, m_outputPorts}) {
+        hash.add(static_cast<uint64_t>(pm.size()));
+        for (const auto& p : portsByName(pm)) {
+            hash.add(p->getPort()->getName());
+        }
+    }
+    hash.add(static_cast<uint64_t>(m_component->getSubComponents().size()));
+    for (const auto& c : m_component->getSubComponents()) {
+        hash.add(c->getName());
+    }
+    return hash.value();
+}
+
+void ComponentGraphic::loadBinaryLayout(const std::string& fileName) {
+    std::shared_ptr<LayoutFile> file;
+    try {
+        file = std::make_shared<LayoutFile>(fileName);
+    } catch (const std::runtime_error& e) {
+        QMessageBox::warning(QApplication::activeWindow(), "Load layout", e.what());
+        return;
+    }
+
+    m_isTopLevelSerializedComponent = true;
+    m_layoutVersion = file->layoutVersion();
+    // The layout of the subcomponents of this component is stored at the root path
+    applyLayoutRecord(file->readRoot(), file, "");
+    m_isTopLevelSerializedComponent = false;
+}
+
+void ComponentGraphic::saveBinaryLayout(const std::string& fileName) {
+    m_isTopLevelSerializedComponent = true;
+    m_layoutVersion = LatestLayoutVersion - 1;
+    std::map<std::string, std::string> records;
+    const std::string root = layoutRecord();
+    collectLayoutRecords("", records);
+    m_isTopLevelSerializedComponent = false;
+
+    if (!LayoutFile::write(fileName, m_layoutVersion, root, records)) {
+        QMessageBox::warning(QApplication::activeWindow(), "Save layout",
+                             "Could not write layout file '" + QString::fromStdString(fileName) + "'");
+    }
+}
+
+std::string ComponentGraphic::layoutRecord() {
+    std::ostringstream stream;
+    try {
+        cereal::PortableBinaryOutputArchive archive(stream);
+        archive(layoutSignature());
+        m_serializingRecord = true;
+        archive(*this);
+    } catch (const cereal::Exception& e) {
+        /// @todo: build an error report
+    }
+    m_serializingRecord = false;
+    return stream.str();
+}
+
+void ComponentGraphic::applyLayoutRecord(const std::string& record, const std::shared_ptr<LayoutFile>& file,
+                                         const std::string& path) {
+    // The layout of the subcomponents is applied once their graphics are created, which may happen while restoring
+    // the expansion state of this component
+    m_pendingLayout = file;
+    m_pendingLayoutPath = path;
+    if (!record.empty()) {
+        std::istringstream stream(record);
+        try {
+            cereal::PortableBinaryInputArchive archive(stream);
+            uint64_t signature = 0;
+            archive(signature);
+            if (signature == layoutSignature()) {
+                m_serializingRecord = true;
+                archive(*this);
+            }
+        } catch (const cereal::Exception& e) {
+            /// @todo: build an error report
+        }
+        m_serializingRecord = false;
+    }
+    if (m_subcomponentGraphicsCreated) {
+        applyPendingLayout();
+    }
+}
+
+std::string ComponentGraphic::subcomponentsRecord() {
+    // Subcomponents are keyed by name, followed by the wires from the input ports of this component to them
+    std::map<std::string, std::string> subcomponents;
+    for (const auto& c : m_subcomponents) {
+        subcomponents[c->getComponent()->getName()] = c->layoutRecord();
+    }
+    std::ostringstream stream;
+    try {
+        cereal::PortableBinaryOutputArchive archive(stream);
+        archive(layoutSignature(), subcomponents);
+        for (const auto& p : portsByName(m_inputPorts)) {
+            archive(*p->getOutputWire());
+        }
+    } catch (const cereal::Exception& e) {
+        /// @todo: build an error report
+    }
+    return stream.str();
+}
+
+void ComponentGraphic::collectLayoutRecords(const std::string& path, std::map<std::string, std::string>& records) {
+    if (m_subcomponentGraphicsCreated) {
+        records[path] = subcomponentsRecord();
+        for (const auto& c : m_subcomponents) {
+            c->collectLayoutRecords(path + "/" + c->getComponent()->getName(), records);
+        }
+    } else if (m_pendingLayout) {
+        // The layout of this component and its descendants has not been applied yet; carry it over from the layout
+        // file which it was loaded from
+        const std::string& from = m_pendingLayoutPath;
+        for (const auto& p : m_pendingLayout->paths()) {
+            if (p.compare(0, from.size(), from) == 0 && (p.size() == from.size() || p[from.size()] == '/')) {
+                records[path + p.substr(from.size())] = m_pendingLayout->read(p);
+            }
+        }
+    }
+}
+
+bool ComponentGraphic::applyPendingLayout() {
+    if (!m_pendingLayout) {
+        return false;
+    }
+    const auto file = std::move(m_pendingLayout);
+    const std::string record = file->read(m_pendingLayoutPath);
+    if (record.empty()) {
+        return false;
+    }
+
+    std::istringstream stream(record);
+    try {
+        cereal::PortableBinaryInputArchive archive(stream);
+        uint64_t signature = 0;
+        std::map<std::string, std::string> subcomponents;
+        archive(signature);
+        if (signature != layoutSignature()) {
+            return false;
+        }
+        archive(subcomponents);
+        for (const auto& c : m_subcomponents) {
+            auto it = subcomponents.find(c->getComponent()->getName());
+            if (it != subcomponents.end()) {
+                c->applyLayoutRecord(it->second, file, m_pendingLayoutPath + "/" + it->first);
+            }
+        }
+        setSerializing(true);
+        for (const auto& p : portsByName(m_inputPorts)) {
+            archive(*p->getOutputWire());
+        }
+        setSerializing(false);
+    } catch (const cereal::Exception& e) {
+        /// @todo: build an error report
+        setSerializing(false);
+    }
+    updateGeometry();
+    return true;
+}
+
 void ComponentGraphic::parameterDialogTriggered() {
     ParameterDialog dialog(m_component);
 
@@ -328,9 +631,39 @@ void ComponentGraphic::registerWire(WireGraphic* wire) {
     m_wires.push_back(wire);
 }
 
-void ComponentGraphic::setExpanded(bool state) {
+void ComponentGraphic::accountMemory(MemoryFootprint::Usage& usage) const {
+    size_t bytes = sizeof(ComponentGraphic) + footprint::bytes(m_subcomponents) + footprint::bytes(m_wires) +
+                   footprint::treeBytes(m_indicators) + footprint::treeBytes(m_virtualChildren) +
+                   footprint::treeBytes(m_virtualParents);
+    // QMap nodes hold a key/value pair next to the tree node pointers
+    bytes += (m_inputPorts.size() + m_outputPorts.size()) * (2 * sizeof(void*) + 4 * sizeof(void*));
+    bytes += m_shape.elementCount() * sizeof(QPainterPath::Element) + m_gridPoints.capacity() * sizeof(QPoint);
+    if (m_label) {
+        bytes += sizeof(Label);
+    }
+    if (m_expandButton) {
+        bytes += sizeof(ComponentButton);
+    }
+    usage[MemoryFootprint::ComponentGraphics] += bytes;
+
+    for (const auto* ports : {&m_inputPorts, &m_outputPorts}) {
+        for (const auto* portGraphic : *ports) {
+            usage[MemoryFootprint::PortGraphics] += portGraphic->memoryUsage();
+        }
+    }
+    for (const auto* wire : m_wires) {
+        usage[MemoryFootprint::WireGraphics] += wire->memoryUsage();
+    }
+}
+
+void ComponentGraphic::setExpanded(bool state, bool placeAndRoute) {
+    if (state) {
+        createSubcomponentGraphics(placeAndRoute);
+    }
     GridComponent::setExpanded(state);
     bool areWeExpanded = isExpanded();
+    // Expanded components cover large parts of the scene, and are thus not worth caching
+    setCacheMode(areWeExpanded ? NoCache : DeviceCoordinateCache);
     if (m_expandButton != nullptr) {
         m_expandButton->setChecked(areWeExpanded);
         for (const auto& c : m_subcomponents) {
@@ -515,6 +848,13 @@ QVariant ComponentGraphic::itemChange(QGraphicsItem::GraphicsItemChange change,
                 p->modulePositionHasChanged();
             }
         }
+        // Components moved by the user reroute the wires around them. Components moved through placement are routed
+        // by their parent once placed.
+        if (m_initialized && !parentIsPlacing() && !isSerializing()) {
+            if (auto* parent = getParent()) {
+                parent->scheduleWireRouting();
+            }
+        }
     }
 
     return GraphicsBaseItem::itemChange(change, value);
@@ -547,10 +887,19 @@ void ComponentGraphic::paint(QPainter* painter, const QStyleOptionGraphicsItem*
     painter->setPen(pen);
     painter->drawPath(m_shape);
 
+    // Profiling heat overlay, shaded by the share of simulation time spent within this component. The share is square
+    // root scaled, to keep components with small shares of large designs distinguishable.
+    if (const auto* profiler = m_component->getDesign()->observedProfiler()) {
+        const double heat = std::sqrt(profiler->share(m_component));
+        if (heat > 0) {
+            painter->fillPath(m_shape, QColor::fromRgbF(1.0, 0.0, 0.0, 0.1 + 0.6 * heat));
+        }
+    }
+
     painter->setPen(oldPen);
 
     if (hasSubcomponents()) {
-        if (lod >= 0.35) {
+        if (lod >= LOD_DETAILS) {
             // Determine whether expand button should be shown. If we are in locked state, do not interfere with the
             // view state of the expand button
             if (!isLocked()) {
@@ -569,13 +918,15 @@ void ComponentGraphic::paint(QPainter* painter, const QStyleOptionGraphicsItem*
         }
     }
 
-    // Paint boolean indicators
-    for (const auto& p : m_indicators) {
-        paintIndicator(painter, p, p->getPort()->uValue() ? Qt::green : Qt::red);
-    }
+    if (lod >= LOD_DETAILS) {
+        // Paint boolean indicators
+        for (const auto& p : m_indicators) {
+            paintIndicator(painter, p, p->getPort()->observedValue() ? Qt::green : Qt::red);
+        }
 
-    // Paint overlay
-    paintOverlay(painter, option, w);
+        // Paint overlay
+        paintOverlay(painter, option, w);
+    }
 
 #ifdef VSRTL_DEBUG_DRAW
     painter->save();
@@ -2,6 +2,7 @@
 #define VSRTL_COMPONENTGRAPHIC_H
 
 #include <QFont>
+#include <QTimer>
 #include <QToolButton>
 
 #include "../interface/vsrtl_gfxobjecttypes.h"
@@ -44,6 +45,7 @@ static inline QPointF gridToScene(QPoint p) {
 
 class PortGraphic;
 class ComponentButton;
+class LayoutFile;
 
 class ComponentGraphic : public GridComponent {
     Q_OBJECT
@@ -62,6 +64,17 @@ public:
      */
     virtual void paintOverlay(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) {}
 
+    /**
+     * @brief portValueChanged
+     * Called by the port graphics of this component when the value of their port has changed. Components which paint
+     * port values (ie. indicators) schedule a redraw of themselves.
+     */
+    virtual void portValueChanged(PortGraphic* port) {
+        if (m_indicators.count(port)) {
+            update();
+        }
+    }
+
     void initialize(bool placeAndRoute = false);
     bool restrictSubcomponentPositioning() const { return m_restrictSubcomponentPositioning; }
     std::vector<ComponentGraphic*>& getGraphicSubcomponents() { return m_subcomponents; }
@@ -70,9 +83,31 @@ public:
     void setLocked(bool locked) override;
     bool handlePortGraphicMoveAttempt(const PortGraphic* port, const QPointF& newBorderPos);
 
-    void setExpanded(bool isExpanded);
+    /**
+     * @brief setExpanded
+     * Expands or collapses this component. If @p placeAndRoute is false, subcomponent graphics created upon expanding
+     * are not placed and routed, which is then left to the caller (see PlaceRouteJob).
+     */
+    void setExpanded(bool isExpanded, bool placeAndRoute = true);
     void registerWire(WireGraphic* wire);
 
+    /**
+     * @brief createSubcomponentGraphics
+     * Creates the graphics of the subcomponents of this component, if not yet created. Subcomponent graphics (and their
+     * place & route, unless @p placeAndRoute is false) are created upon first expanding the component; collapsed
+     * components are drawn from their border ports only.
+     */
+    void createSubcomponentGraphics(bool placeAndRoute = true);
+    bool hasSubcomponentGraphics() const { return m_subcomponentGraphicsCreated; }
+
+    /**
+     * @brief routeWires
+     * Routes the wires within this component on the component grid, if grid routing is selected. The subcomponents of
+     * this component are treated as obstacles. If @p reuseRoutes, wires whose current layout remains a valid route are
+     * left as-is.
+     */
+    void routeWires(bool reuseRoutes = true);
+
     GraphicsBaseItem<QGraphicsItem>* moduleParent() override;
 
     /**
@@ -82,6 +117,18 @@ public:
     void setUserVisible(bool state);
     const auto& outputPorts() const { return m_outputPorts; }
 
+    /**
+     * @brief accountMemory
+     * Adds the estimated memory of this component graphic, as well as the port graphics and wires which it manages, to
+     * @p usage. Subcomponent graphics are not included.
+     */
+    void accountMemory(MemoryFootprint::Usage& usage) const;
+
+signals:
+    /// Emitted when the subcomponent graphics of @p component, being this component or any component nested within
+    /// it, have been created.
+    void subcomponentGraphicsCreated(vsrtl::ComponentGraphic* component);
+
 private slots:
     /**
      * @brief handleGridPosChange
@@ -114,7 +161,34 @@ protected:
     void createSubcomponents(bool doPlaceAndRoute);
     QRectF sceneGridRect() const;
 
+    /// @returns @p ports ordered by name, being the order in which ports are serialized.
+    static std::vector<PortGraphic*> portsByName(const QMap<SimPort*, PortGraphic*>& ports);
+
+    // Binary layouts (see LayoutFile)
+    void loadBinaryLayout(const std::string& fileName);
+    void saveBinaryLayout(const std::string& fileName);
+    /// Hash of the names of the ports and subcomponents of this component, which a layout record must match.
+    uint64_t layoutSignature() const;
+    /// @returns the layout record of this component itself, excluding its subcomponents.
+    std::string layoutRecord();
+    void applyLayoutRecord(const std::string& record, const std::shared_ptr<LayoutFile>& file, const std::string& path);
+    /// @returns the layout record of the subcomponents of this component and the wires between them.
+    std::string subcomponentsRecord();
+    /// Adds the subcomponent records of this component and its descendants at @p path to @p records.
+    void collectLayoutRecords(const std::string& path, std::map<std::string, std::string>& records);
+    /**
+     * @brief applyPendingLayout
+     * Applies the layout of the subcomponents of this component from the binary layout from which this component was
+     * loaded, if any. Called once the subcomponent graphics have been created.
+     * @returns whether a layout was applied.
+     */
+    bool applyPendingLayout();
+    /// Reroutes the wires of this component once subcomponents have stopped moving.
+    void scheduleWireRouting();
+
     bool m_restrictSubcomponentPositioning = false;
+    bool m_subcomponentGraphicsCreated = false;
+    bool m_placeAndRoute = false;
     bool m_inResizeDragZone = false;
     bool m_resizeDragging = false;
     bool m_isTopLevelSerializedComponent = false;
@@ -152,6 +226,16 @@ protected:
 
     QPointF m_expandButtonPos;  // Draw position of expand/collapse button in scene coordinates
     ComponentButton* m_expandButton = nullptr;
+    QTimer* m_routingTimer = nullptr;
+
+    /**
+     * @brief m_pendingLayout
+     * Binary layout file containing the not yet applied layout of the subcomponents of this component, at
+     * m_pendingLayoutPath. Subcomponent layouts are read once the subcomponent graphics are created.
+     */
+    std::shared_ptr<LayoutFile> m_pendingLayout;
+    std::string m_pendingLayoutPath;
+    bool m_serializingRecord = false;
 
 public slots:
     void loadLayoutFile(const QString& file);
@@ -244,7 +328,7 @@ public:
 
         // Serialize ports
         for (const auto& pm : {m_inputPorts, m_outputPorts}) {
-            for (const auto& p : pm) {
+            for (const auto& p : portsByName(pm)) {
                 try {
                     archive(cereal::make_nvp(p->getPort()->getName(), *p));
                 } catch (const cereal::Exception& e) {
@@ -253,10 +337,14 @@ public:
             }
         }
 
-        if (hasSubcomponents()) {
+        // Layout records only describe the component itself; subcomponents are described by records of their own
+        if (hasSubcomponents() && !m_serializingRecord) {
+            // Layouts describe collapsed subcomponents as well, which thus must have their graphics created
+            createSubcomponentGraphics();
+
             // Serialize wires from input ports to subcomponents
             // @todo: should this be in port serialization?
-            for (auto& p : m_inputPorts) {
+            for (auto& p : portsByName(m_inputPorts)) {
                 try {
                     archive(cereal::make_nvp(p->getPort()->getName() + "_in_wire", *p->getOutputWire()));
                 } catch (const cereal::Exception& e) {
@@ -279,7 +367,7 @@ public:
         // which are present in óne design but not another.
         if (!m_isTopLevelSerializedComponent) {
             // Serialize output wire
-            for (auto& p : m_outputPorts) {
+            for (auto& p : portsByName(m_outputPorts)) {
                 try {
                     archive(cereal::make_nvp(p->getPort()->getName() + "_out_wire", *p->getOutputWire()));
                 } catch (const cereal::Exception& e) {
@@ -50,5 +50,10 @@ constexpr QColor BUTTON_EXPAND_COLOR = {0x26, 0xa6, 0x5b};
 
 #define PORT_INNER_MARGIN 5
 
+// Level of detail thresholds, as given by QStyleOptionGraphicsItem::levelOfDetailFromTransform(). Below LOD_DETAILS,
+// port stubs, wire points, indicators and component grids are not drawn. Below LOD_TEXT, text is not drawn.
+#define LOD_DETAILS 0.35
+#define LOD_TEXT 0.5
+
 }  // namespace vsrtl
 #endif  // VSRTL_GRAPHICS_DEFINES_H
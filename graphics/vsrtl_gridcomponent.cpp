@@ -114,8 +114,11 @@ bool GridComponent::move(const QPoint& pos) {
 }
 
 void GridComponent::placeAndRouteSubcomponents() {
+    applyPlacements(PlaceRoute::get()->placeAndRoute(getGridSubcomponents()));
+}
+
+void GridComponent::applyPlacements(const std::map<GridComponent*, QPoint>& placements) {
     m_isPlacing = true;
-    const auto& placements = PlaceRoute::get()->placeAndRoute(getGridSubcomponents());
     for (const auto& p : placements) {
         p.first->move(p.second);
     }
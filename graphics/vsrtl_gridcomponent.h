@@ -71,6 +71,8 @@ public:
     bool hasSubcomponents() const;
 
     void placeAndRouteSubcomponents();
+    /// Moves the subcomponents of this component to the given grid positions, as computed by PlaceRoute.
+    void applyPlacements(const std::map<GridComponent*, QPoint>& placements);
 
     template <class Archive>
     void serializeBorder(Archive& archive) {
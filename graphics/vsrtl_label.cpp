@@ -28,6 +28,9 @@ Label::Label(QGraphicsItem* parent, const QString& text, std::shared_ptr<QAction
 
     setMoveable();
     setText(text);
+
+    // Text layouting and rendering is expensive; labels are redrawn from a pixmap cache until their text changes
+    setCacheMode(DeviceCoordinateCache);
 }
 
 void Label::forceDefaultTextColor(const QColor& color) {
@@ -88,6 +91,10 @@ void Label::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
 };
 
 void Label::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* w) {
+    // Text is illegible below LOD_TEXT, and is left out unless being edited
+    if (!hasFocus() && option->levelOfDetailFromTransform(painter->worldTransform()) < LOD_TEXT)
+        return;
+
     // There exists a bug within the drawing of QGraphicsTextItem wherein the painter pen does not return to its initial
     // state wrt. the draw style (the pen draw style is set to Qt::DashLine after finishing painting whilst the
     // QGraphicsTextItem is selected).
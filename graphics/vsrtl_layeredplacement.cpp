@@ -0,0 +1,352 @@
+#include "vsrtl_graphics_defines.h"
+#include "vsrtl_placeroute.h"
+
+#include "../interface/vsrtl_interface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace vsrtl {
+
+namespace {
+
+/// Number of crossing minimization sweeps without improvement after which minimization stops
+constexpr int MaxSweepsWithoutImprovement = 2;
+constexpr int MaxSweeps = 24;
+
+/**
+ * @brief The Adjacency struct
+ * Adjacency lists of a graph over node indices, stored in compressed sparse row format. Also used for the node lists of
+ * each layer.
+ */
+struct Adjacency {
+    struct Range {
+        int* first;
+        int* last;
+        int* begin() const { return first; }
+        int* end() const { return last; }
+        int size() const { return last - first; }
+    };
+
+    /// Builds the lists of @p nodes from @p edges. If @p reverse, lists contain the sources of edges into each node.
+    Adjacency(int nodes, const std::vector<std::pair<int, int>>& edges, bool reverse = false)
+        : offsets(nodes + 1, 0), targets(edges.size()) {
+        for (const auto& [from, to] : edges) {
+            offsets[(reverse ? to : from) + 1]++;
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<int> next(offsets.begin(), offsets.end() - 1);
+        for (const auto& [from, to] : edges) {
+            targets[next[reverse ? to : from]++] = reverse ? from : to;
+        }
+    }
+
+    Range operator[](int node) { return {targets.data() + offsets[node], targets.data() + offsets[node + 1]}; }
+    int degree(int node) const { return offsets[node + 1] - offsets[node]; }
+
+    std::vector<int> offsets;
+    std::vector<int> targets;
+};
+
+/**
+ * @brief feedbackOrder
+ * Orders the nodes such that as few edges as possible point backwards, and such that the backwards edges of cycles
+ * preferably end at synchronous components (registers). Nodes are ordered topologically until only cycles remain, at
+ * which point the remaining register with the fewest unordered predecessors is ordered next. Combinational cycles only
+ * exist across hierarchy boundaries, and are broken at the remaining node with the fewest unordered predecessors.
+ * @returns the rank of each node within the order.
+ */
+std::vector<int> feedbackOrder(const std::vector<PlacementNode>& nodes, Adjacency& succs, const Adjacency& preds) {
+    const int n = nodes.size();
+    std::vector<int> indegree(n);
+    std::vector<int> rank(n, -1);
+    using Entry = std::pair<int, int>;  // remaining in-degree, node
+    using Heap = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+    Heap registers, others;
+    std::vector<int> queue;
+    queue.reserve(n);
+
+    auto heapOf = [&](int v) -> Heap& { return nodes[v].component->isSynchronous() ? registers : others; };
+    for (int v = 0; v < n; ++v) {
+        indegree[v] = preds.degree(v);
+        if (indegree[v] == 0) {
+            queue.push_back(v);
+        } else {
+            heapOf(v).push({indegree[v], v});
+        }
+    }
+
+    // Heaps are updated lazily; stale entries are skipped when popped
+    auto pop = [&](Heap& heap) {
+        while (!heap.empty()) {
+            const auto [degree, v] = heap.top();
+            heap.pop();
+            if (rank[v] == -1 && indegree[v] == degree) {
+                return v;
+            }
+        }
+        return -1;
+    };
+
+    int next = 0;
+    for (size_t head = 0; next < n; ++head) {
+        if (head == queue.size()) {
+            int v = pop(registers);
+            if (v == -1) {
+                v = pop(others);
+            }
+            // The remaining edges into v become feedback edges
+            indegree[v] = 0;
+            queue.push_back(v);
+        }
+        const int v = queue[head];
+        rank[v] = next++;
+        for (const int s : succs[v]) {
+            if (rank[s] != -1 || indegree[s] == 0) {
+                continue;
+            }
+            if (--indegree[s] == 0) {
+                queue.push_back(s);
+            } else {
+                heapOf(s).push({indegree[s], s});
+            }
+        }
+    }
+    return rank;
+}
+
+/**
+ * @brief countCrossings
+ * Counts the edge crossings between @p upper and the layer below it, by counting inversions of the positions of the
+ * lower endpoints of the edges when sorted by their upper endpoints.
+ */
+long long countCrossings(Adjacency::Range upper, int lowerSize, Adjacency& succs, const std::vector<int>& pos,
+                         std::vector<int>& tree, std::vector<int>& endpoints) {
+    // Fenwick tree over the positions of the lower layer
+    tree.assign(lowerSize + 1, 0);
+    long long crossings = 0;
+    int inserted = 0;
+    for (const int v : upper) {
+        endpoints.clear();
+        for (const int s : succs[v]) {
+            endpoints.push_back(pos[s]);
+        }
+        std::sort(endpoints.begin(), endpoints.end());
+        for (const int p : endpoints) {
+            int atOrBelow = 0;
+            for (int i = p + 1; i > 0; i -= i & -i) {
+                atOrBelow += tree[i];
+            }
+            crossings += inserted - atOrBelow;
+            for (int i = p + 1; i <= lowerSize; i += i & -i) {
+                tree[i]++;
+            }
+            inserted++;
+        }
+    }
+    return crossings;
+}
+
+}  // namespace
+
+std::vector<QPoint> layeredPlacement(const std::vector<PlacementNode>& nodes) {
+    const int n = nodes.size();
+    if (n == 0) {
+        return {};
+    }
+
+    // 1. Collect the edges between the nodes. Edges to components outside of the nodes are disregarded.
+    std::unordered_map<const SimComponent*, int> index;
+    index.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        index[nodes[i].component] = i;
+    }
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < n; ++i) {
+        for (const auto* c : nodes[i].component->getOutputComponents()) {
+            auto it = index.find(c);
+            if (it != index.end() && it->second != i) {
+                edges.push_back({i, it->second});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // 2. Break cycles by reversing the edges which point backwards in the feedback order
+    std::vector<int> rank;
+    {
+        Adjacency succs(n, edges), preds(n, edges, true);
+        rank = feedbackOrder(nodes, succs, preds);
+    }
+    std::vector<int> order(n);
+    for (int v = 0; v < n; ++v) {
+        order[rank[v]] = v;
+    }
+    for (auto& [from, to] : edges) {
+        if (rank[from] > rank[to]) {
+            std::swap(from, to);
+        }
+    }
+    // Reversing may duplicate edges of two-node cycles
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    Adjacency succs(n, edges), preds(n, edges, true);
+
+    // 3. Assign layers by longest path. Sources are subsequently moved to the layer right before their first successor,
+    // such that ie. constants are placed next to their consumers.
+    std::vector<int> layer(n, 0);
+    for (const int v : order) {
+        for (const int p : preds[v]) {
+            layer[v] = std::max(layer[v], layer[p] + 1);
+        }
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const int v = *it;
+        if (preds.degree(v) == 0 && succs.degree(v) != 0) {
+            int first = std::numeric_limits<int>::max();
+            for (const int s : succs[v]) {
+                first = std::min(first, layer[s]);
+            }
+            layer[v] = first - 1;
+        }
+    }
+    const int layers = *std::max_element(layer.begin(), layer.end()) + 1;
+
+    // 4. Split edges spanning multiple layers through dummy nodes, such that all edges connect adjacent layers. Nodes
+    // [0; n) are the placed nodes, and nodes [n; N) are dummy nodes.
+    std::vector<std::pair<int, int>> unitEdges;
+    unitEdges.reserve(edges.size());
+    for (const int v : order) {
+        for (const int s : succs[v]) {
+            int prev = v;
+            for (int l = layer[v] + 1; l < layer[s]; ++l) {
+                const int dummy = layer.size();
+                layer.push_back(l);
+                unitEdges.push_back({prev, dummy});
+                prev = dummy;
+            }
+            unitEdges.push_back({prev, s});
+        }
+    }
+    const int N = layer.size();
+    Adjacency unitSuccs(N, unitEdges), unitPreds(N, unitEdges, true);
+
+    // The nodes of each layer, initially in the feedback order
+    std::vector<std::pair<int, int>> layerMembers;
+    layerMembers.reserve(N);
+    for (const int v : order) {
+        layerMembers.push_back({layer[v], v});
+    }
+    for (int v = n; v < N; ++v) {
+        layerMembers.push_back({layer[v], v});
+    }
+    Adjacency layerNodes(layers, layerMembers);
+    std::vector<int> pos(N);
+    for (int l = 0; l < layers; ++l) {
+        int i = 0;
+        for (const int v : layerNodes[l]) {
+            pos[v] = i++;
+        }
+    }
+
+    // 5. Minimize crossings through alternating down- and upwards barycenter sweeps, keeping the best ordering found
+    std::vector<int> tree, endpoints;
+    auto crossings = [&] {
+        long long total = 0;
+        for (int l = 0; l + 1 < layers; ++l) {
+            total += countCrossings(layerNodes[l], layerNodes.degree(l + 1), unitSuccs, pos, tree, endpoints);
+        }
+        return total;
+    };
+    std::vector<double> key(N);
+    auto sweep = [&](int l, Adjacency& adjacent) {
+        auto members = layerNodes[l];
+        for (const int v : members) {
+            if (adjacent.degree(v) == 0) {
+                key[v] = pos[v];
+                continue;
+            }
+            double sum = 0;
+            for (const int a : adjacent[v]) {
+                sum += pos[a];
+            }
+            key[v] = sum / adjacent.degree(v);
+        }
+        std::stable_sort(members.begin(), members.end(), [&](int a, int b) { return key[a] < key[b]; });
+        int i = 0;
+        for (const int v : members) {
+            pos[v] = i++;
+        }
+    };
+
+    long long best = crossings();
+    std::vector<int> bestOrder = layerNodes.targets;
+    for (int i = 0, withoutImprovement = 0; i < MaxSweeps && best > 0; ++i) {
+        if (i % 2 == 0) {
+            for (int l = 1; l < layers; ++l) {
+                sweep(l, unitPreds);
+            }
+        } else {
+            for (int l = layers - 2; l >= 0; --l) {
+                sweep(l, unitSuccs);
+            }
+        }
+        const long long current = crossings();
+        if (current < best) {
+            best = current;
+            bestOrder = layerNodes.targets;
+            withoutImprovement = 0;
+        } else if (++withoutImprovement == MaxSweepsWithoutImprovement) {
+            break;
+        }
+    }
+    layerNodes.targets = bestOrder;
+
+    // 6. Assign coordinates. Layers form columns, and each node is placed as close as possible to the barycenter of its
+    // predecessors, without overlapping the nodes above it within its column. Dummy nodes occupy no space.
+    const QPoint start{SUBCOMPONENT_INDENT, SUBCOMPONENT_INDENT};
+    auto height = [&](int v) { return v < n ? nodes[v].size.height() : 0; };
+    std::vector<int> columnX(layers);
+    int x = start.x();
+    for (int l = 0; l < layers; ++l) {
+        columnX[l] = x;
+        int width = 0;
+        for (const int v : layerNodes[l]) {
+            width = v < n ? std::max(width, nodes[v].size.width()) : width;
+        }
+        x += width + 2 * COMPONENT_COLUMN_MARGIN;
+    }
+
+    std::vector<int> y(N);
+    for (int l = 0; l < layers; ++l) {
+        int next = start.y();
+        for (const int v : layerNodes[l]) {
+            y[v] = next;
+            if (unitPreds.degree(v) != 0) {
+                double center = 0;
+                for (const int p : unitPreds[v]) {
+                    center += y[p] + height(p) / 2.0;
+                }
+                center /= unitPreds.degree(v);
+                y[v] = std::max(next, static_cast<int>(std::lround(center - height(v) / 2.0)));
+            }
+            if (v < n) {
+                next = y[v] + height(v) + COMPONENT_COLUMN_MARGIN;
+            }
+        }
+    }
+
+    std::vector<QPoint> positions(n);
+    for (int v = 0; v < n; ++v) {
+        positions[v] = QPoint(columnX[layer[v]], y[v]);
+    }
+    return positions;
+}
+
+}  // namespace vsrtl
@@ -0,0 +1,144 @@
+#include "vsrtl_layoutfile.h"
+
+#include <stdexcept>
+
+namespace vsrtl {
+
+namespace {
+
+/// Layout files are shared between machines; integers are stored in little-endian byte order regardless of the host.
+template <typename T>
+void writeValue(std::ofstream& file, T v) {
+    char bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+    file.write(bytes, sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& v) {
+    unsigned char bytes[sizeof(T)];
+    if (!file.read(reinterpret_cast<char*>(bytes), sizeof(T))) {
+        return false;
+    }
+    v = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        v |= static_cast<T>(bytes[i]) << (8 * i);
+    }
+    return true;
+}
+
+/// Size of the header preceding the record table: magic, version, layout version, record count and the root entry
+constexpr uint64_t HeaderSize = 4 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+}  // namespace
+
+LayoutFile::LayoutFile(const std::string& path) : m_file(path, std::ios::binary) {
+    if (!m_file) {
+        throw std::runtime_error("Could not open layout file '" + path + "'");
+    }
+    m_file.seekg(0, std::ios::end);
+    const uint64_t fileSize = m_file.tellg();
+    m_file.seekg(0);
+
+    auto invalid = [&] { return std::runtime_error("'" + path + "' is not a valid layout file"); };
+    uint32_t magic = 0, version = 0, records = 0;
+    if (!readValue(m_file, magic) || magic != Magic || !readValue(m_file, version) || version != Version ||
+        !readValue(m_file, m_layoutVersion) || !readValue(m_file, records) || !readValue(m_file, m_root.offset) ||
+        !readValue(m_file, m_root.size)) {
+        throw invalid();
+    }
+
+    auto inBounds = [&](const Entry& e) { return e.offset <= fileSize && e.size <= fileSize - e.offset; };
+    if (!inBounds(m_root)) {
+        throw invalid();
+    }
+    for (uint32_t i = 0; i < records; ++i) {
+        uint32_t length = 0;
+        Entry entry;
+        // Guards against allocating a path for a corrupted length
+        if (!readValue(m_file, length) || length > fileSize) {
+            throw invalid();
+        }
+        std::string recordPath(length, '\0');
+        if (!m_file.read(&recordPath[0], length) || !readValue(m_file, entry.offset) ||
+            !readValue(m_file, entry.size) || !inBounds(entry)) {
+            throw invalid();
+        }
+        m_records[recordPath] = entry;
+    }
+}
+
+bool LayoutFile::isLayoutFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic = 0;
+    return file && readValue(file, magic) && magic == Magic;
+}
+
+bool LayoutFile::write(const std::string& path, uint32_t layoutVersion, const std::string& root,
+                       const std::map<std::string, std::string>& records) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    // Records are stored after the table, with the root record first
+    uint64_t offset = HeaderSize;
+    for (const auto& [recordPath, record] : records) {
+        offset += sizeof(uint32_t) + recordPath.size() + 2 * sizeof(uint64_t);
+    }
+    writeValue(file, Magic);
+    writeValue(file, Version);
+    writeValue(file, layoutVersion);
+    writeValue(file, static_cast<uint32_t>(records.size()));
+    writeValue(file, offset);
+    writeValue(file, static_cast<uint64_t>(root.size()));
+    offset += root.size();
+    for (const auto& [recordPath, record] : records) {
+        writeValue(file, static_cast<uint32_t>(recordPath.size()));
+        file.write(recordPath.data(), recordPath.size());
+        writeValue(file, offset);
+        writeValue(file, static_cast<uint64_t>(record.size()));
+        offset += record.size();
+    }
+
+    file.write(root.data(), root.size());
+    for (const auto& [recordPath, record] : records) {
+        file.write(record.data(), record.size());
+    }
+    return static_cast<bool>(file);
+}
+
+std::string LayoutFile::readRoot() {
+    return read(m_root);
+}
+
+std::string LayoutFile::read(const std::string& path) {
+    auto it = m_records.find(path);
+    if (it == m_records.end()) {
+        return {};
+    }
+    return read(it->second);
+}
+
+std::string LayoutFile::read(const Entry& entry) {
+    std::string record(entry.size, '\0');
+    m_file.clear();
+    m_file.seekg(entry.offset);
+    if (entry.size != 0 && !m_file.read(&record[0], entry.size)) {
+        return {};
+    }
+    return record;
+}
+
+std::vector<std::string> LayoutFile::paths() const {
+    std::vector<std::string> paths;
+    paths.reserve(m_records.size());
+    for (const auto& [path, entry] : m_records) {
+        paths.push_back(path);
+    }
+    return paths;
+}
+
+}  // namespace vsrtl
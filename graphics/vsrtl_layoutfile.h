@@ -0,0 +1,70 @@
+#ifndef VSRTL_LAYOUTFILE_H
+#define VSRTL_LAYOUTFILE_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vsrtl {
+
+/**
+ * @brief The LayoutFile class
+ * Binary layout file. A layout consists of a root record, describing the top-level component of the layout, and a
+ * record for each component whose subcomponents are laid out, keyed by the path of the component relative to the
+ * top-level component ("" for the top-level component, "/alu", "/alu/adder", ...). Records are opaque to the file.
+ *
+ * The file starts with a table of the offset and size of each record, such that opening a layout only reads the table,
+ * and each record is read once requested. This allows the layout of a component to be read once it is first expanded.
+ */
+class LayoutFile {
+public:
+    static constexpr uint32_t Magic = 0x56534c59;  // "VSLY"
+    static constexpr uint32_t Version = 1;
+    static constexpr const char* Extension = ".vsrtllayout";
+
+    /**
+     * @brief LayoutFile
+     * Opens the layout at @p path and reads its record table. The file is kept open for reading records.
+     * @throws std::runtime_error if @p path cannot be opened, or is not a valid layout file.
+     */
+    explicit LayoutFile(const std::string& path);
+
+    /// @returns whether @p path starts with the magic number of a binary layout file.
+    static bool isLayoutFile(const std::string& path);
+
+    /**
+     * @brief write
+     * Writes a layout consisting of @p root and @p records to @p path.
+     * @returns whether the file was successfully written.
+     */
+    static bool write(const std::string& path, uint32_t layoutVersion, const std::string& root,
+                      const std::map<std::string, std::string>& records);
+
+    /// Version of the layout records, as provided when the file was written.
+    uint32_t layoutVersion() const { return m_layoutVersion; }
+    std::string readRoot();
+    bool contains(const std::string& path) const { return m_records.count(path) != 0; }
+    /// @returns the record of the component at @p path, or an empty record if the layout has no such record.
+    std::string read(const std::string& path);
+    /// @returns the paths of all records, in lexicographical order.
+    std::vector<std::string> paths() const;
+
+private:
+    struct Entry {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    std::string read(const Entry& entry);
+
+    std::ifstream m_file;
+    uint32_t m_layoutVersion = 0;
+    Entry m_root;
+    std::map<std::string, Entry> m_records;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_LAYOUTFILE_H
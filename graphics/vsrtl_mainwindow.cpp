@@ -3,19 +3,28 @@
 #include "vsrtl_design.h"
 #include "vsrtl_netlist.h"
 #include "vsrtl_netlistmodel.h"
+#include "vsrtl_waveformwidget.h"
 #include "vsrtl_widget.h"
 
 #include <QAction>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDockWidget>
+#include <QFileDialog>
 #include <QHeaderView>
 #include <QLineEdit>
+#include <QPushButton>
 #include <QSpinBox>
-#include <QThread>
 #include <QTimer>
 #include <QToolBar>
 
 #include <QSplitter>
 
 #include <QTreeView>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <fstream>
 
 namespace vsrtl {
 
@@ -33,10 +42,22 @@ MainWindow::MainWindow(SimDesign& arch, QWidget* parent) : QMainWindow(parent),
     splitter->addWidget(m_vsrtlWidget);
 
     connect(m_netlist, &Netlist::selectionChanged, m_vsrtlWidget, &VSRTLWidget::handleSelectionChanged);
+    connect(m_netlist, &Netlist::locateComponent, m_vsrtlWidget, &VSRTLWidget::locateComponent);
     connect(m_vsrtlWidget, &VSRTLWidget::componentSelectionChanged, m_netlist, &Netlist::updateSelection);
 
     setCentralWidget(splitter);
 
+    m_waveform = new WaveformWidget(this);
+    m_waveform->setDesign(&arch);
+    QDockWidget* waveformDock = new QDockWidget("Waveform", this);
+    waveformDock->setObjectName("waveformDock");
+    waveformDock->setWidget(m_waveform);
+    addDockWidget(Qt::BottomDockWidgetArea, waveformDock);
+    waveformDock->hide();
+
+    connect(m_vsrtlWidget, &VSRTLWidget::portSelectionChanged,
+            [this](const std::vector<SimPort*>& ports) { m_selectedPorts = ports; });
+
     createToolbar();
 
     setWindowTitle("VSRTL - Visual Simulation of Register Transfer Logic");
@@ -113,13 +134,33 @@ void MainWindow::createToolbar() {
     runAct->setChecked(false);
     connect(runAct, &QAction::triggered, [this](bool state) {
         if (state) {
-            auto thread = QThread::create([=] { this->m_vsrtlWidget->run(); });
-            thread->start();
+            this->m_vsrtlWidget->run();
         } else {
             this->m_vsrtlWidget->stop();
         }
     });
     simulatorToolBar->addAction(runAct);
+    // Actions which modify the state of the design are unavailable while the design is simulated on another thread
+    m_runExclusiveActions << resetAct << clockAct;
+    connect(m_vsrtlWidget, &VSRTLWidget::runStarted, this, [this, reverseAct] {
+        for (auto* action : qAsConst(m_runExclusiveActions)) {
+            action->setEnabled(false);
+        }
+        reverseAct->setEnabled(false);
+        m_netlist->setEditable(false);
+    });
+    // Runs may finish by themselves upon hitting a breakpoint
+    connect(m_vsrtlWidget, &VSRTLWidget::runFinished, runAct, [this, runAct, reverseAct] {
+        runAct->setChecked(false);
+        for (auto* action : qAsConst(m_runExclusiveActions)) {
+            action->setEnabled(true);
+        }
+        reverseAct->setEnabled(m_vsrtlWidget->isReversible());
+        m_netlist->setEditable(true);
+        m_netlist->reloadNetlist();
+    });
+    // Values of the netlist are shown from the latest snapshot while running
+    connect(m_vsrtlWidget, &VSRTLWidget::snapshotPublished, m_netlist, &Netlist::reloadNetlist);
 
     simulatorToolBar->addSeparator();
 
@@ -136,9 +177,147 @@ void MainWindow::createToolbar() {
 
     const QIcon expandAllComponentsIcon = QIcon(":/vsrtl_icons/expandSquare.svg");
     QAction* expandAllComponents = new QAction(expandAllComponentsIcon, "Expand all components", this);
-    connect(expandAllComponents, &QAction::triggered, [this] { m_vsrtlWidget->expandAllComponents(); });
+    expandAllComponents->setToolTip("Expand all components; trigger again to cancel");
+    connect(expandAllComponents, &QAction::triggered, [this] {
+        if (m_vsrtlWidget->isExpandingAll()) {
+            m_vsrtlWidget->cancelExpandAll();
+        } else {
+            m_vsrtlWidget->expandAllComponents();
+        }
+    });
     simulatorToolBar->addAction(expandAllComponents);
 
+    QAction* gridRoutingAct = new QAction("Grid routing", this);
+    gridRoutingAct->setToolTip("Route wires orthogonally around components, rather than as direct segments");
+    gridRoutingAct->setCheckable(true);
+    gridRoutingAct->setChecked(PlaceRoute::get()->routingAlgorithm() == RouteAlg::Grid);
+    connect(gridRoutingAct, &QAction::toggled, [](bool enabled) {
+        PlaceRoute::get()->setRoutingAlgorithm(enabled ? RouteAlg::Grid : RouteAlg::Direct);
+    });
+    simulatorToolBar->addAction(gridRoutingAct);
+
+    const QIcon waveformIcon = QIcon(":/vsrtl_icons/time.svg");
+    QAction* addToWaveform = new QAction(waveformIcon, "Add selected wire to waveform", this);
+    connect(addToWaveform, &QAction::triggered, [this] {
+        // A selection contains all ports of a wire; the wire is traced through its driving port.
+        for (auto* port : m_selectedPorts) {
+            if (port->getInputPort() == nullptr) {
+                m_waveform->addPort(port);
+            }
+        }
+        m_waveform->parentWidget()->show();
+    });
+    simulatorToolBar->addAction(addToWaveform);
+
+    QAction* breakOnWire = new QAction("Break on selected wire", this);
+    breakOnWire->setToolTip("Stop running when the value of the selected wire changes");
+    connect(breakOnWire, &QAction::triggered, [this] {
+        for (auto* port : m_selectedPorts) {
+            if (port->getInputPort() == nullptr && !port->isWatched()) {
+                m_vsrtlWidget->getDesign()->getBreakpoints().addPortBreakpoint(*port);
+            }
+        }
+    });
+    simulatorToolBar->addAction(breakOnWire);
+
+    QAction* clearBreakpoints = new QAction("Clear breakpoints", this);
+    connect(clearBreakpoints, &QAction::triggered, [this] { m_vsrtlWidget->getDesign()->getBreakpoints().clear(); });
+    simulatorToolBar->addAction(clearBreakpoints);
+    // Breakpoints are evaluated by the simulation thread while running
+    m_runExclusiveActions << breakOnWire << clearBreakpoints;
+
+    simulatorToolBar->addSeparator();
+
+    QAction* exportProfile = new QAction("Export profile", this);
+    exportProfile->setToolTip("Export the profile as folded stacks, for use with flame graph tools");
+    exportProfile->setEnabled(false);
+    connect(exportProfile, &QAction::triggered, [this] {
+        const auto* profiler = m_vsrtlWidget->getDesign()->observedProfiler();
+        if (!profiler) {
+            return;
+        }
+        const QString fileName =
+            QFileDialog::getSaveFileName(this, "Export profile", QString(), "Folded stacks (*.folded)");
+        if (fileName.isEmpty()) {
+            return;
+        }
+        std::ofstream file(fileName.toStdString());
+        profiler->writeFoldedStacks(file, m_vsrtlWidget->getDesign()->getName());
+    });
+
+    QAction* profileAct = new QAction("Profile", this);
+    profileAct->setToolTip("Profile the time spent evaluating each component");
+    profileAct->setCheckable(true);
+    connect(profileAct, &QAction::toggled, [this, exportProfile](bool enabled) {
+        m_vsrtlWidget->getDesign()->setProfilingEnabled(enabled);
+        exportProfile->setEnabled(enabled);
+        m_vsrtlWidget->syncAll();
+        m_netlist->reloadNetlist();
+    });
+    simulatorToolBar->addAction(profileAct);
+    simulatorToolBar->addAction(exportProfile);
+    // Profiling state is owned by the simulation thread while running
+    m_runExclusiveActions << profileAct;
+
+    QAction* footprintAct = new QAction("Memory footprint", this);
+    footprintAct->setToolTip("Show the estimated memory used by each component of the design");
+    connect(footprintAct, &QAction::triggered, this, &MainWindow::showMemoryFootprint);
+    simulatorToolBar->addAction(footprintAct);
+}
+
+void MainWindow::showMemoryFootprint() {
+    auto footprint = m_vsrtlWidget->getDesign()->getMemoryFootprint();
+    m_vsrtlWidget->accountMemory(footprint);
+
+    auto* dialog = new QDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle("Memory footprint: " +
+                           QString::fromStdString(MemoryFootprint::formatBytes(footprint.total().total())));
+    dialog->resize(900, 600);
+
+    auto* tree = new QTreeWidget(dialog);
+    QStringList headers = {"Component", "Total", "Self"};
+    for (int c = 0; c < MemoryFootprint::NumCategories; ++c) {
+        headers << MemoryFootprint::categoryName(static_cast<MemoryFootprint::Category>(c));
+    }
+    tree->setHeaderLabels(headers);
+
+    // Nodes are ordered such that parents precede their subcomponents
+    const auto& nodes = footprint.nodes();
+    std::vector<QTreeWidgetItem*> items(nodes.size());
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        const auto& node = nodes[i];
+        auto* item = node.parent == MemoryFootprint::NoParent ? new QTreeWidgetItem(tree)
+                                                              : new QTreeWidgetItem(items[node.parent]);
+        item->setText(0, QString::fromStdString(node.name));
+        item->setText(1, QString::fromStdString(MemoryFootprint::formatBytes(node.total.total())));
+        item->setText(2, QString::fromStdString(MemoryFootprint::formatBytes(node.self.total())));
+        for (int c = 0; c < MemoryFootprint::NumCategories; ++c) {
+            item->setText(3 + c, QString::fromStdString(MemoryFootprint::formatBytes(node.total.bytes[c])));
+        }
+        items[i] = item;
+    }
+    tree->expandToDepth(0);
+    tree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, dialog);
+    auto* exportButton = buttons->addButton("Export CSV", QDialogButtonBox::ActionRole);
+    connect(buttons, &QDialogButtonBox::rejected, dialog, &QDialog::close);
+    connect(exportButton, &QPushButton::clicked, [dialog, footprint] {
+        const QString fileName =
+            QFileDialog::getSaveFileName(dialog, "Export memory footprint", QString(), "CSV (*.csv)");
+        if (fileName.isEmpty()) {
+            return;
+        }
+        std::ofstream file(fileName.toStdString());
+        footprint.writeCsv(file);
+    });
+
+    auto* layout = new QVBoxLayout(dialog);
+    layout->addWidget(tree);
+    layout->addWidget(buttons);
+    dialog->show();
+
 }  // namespace vsrtl
 
 }  // namespace vsrtl
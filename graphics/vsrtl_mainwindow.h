@@ -1,11 +1,13 @@
 #ifndef VSRTL_MAINWINDOW_H
 #define VSRTL_MAINWINDOW_H
 
+#include <QList>
 #include <QMainWindow>
 #include <memory>
 
 #include "../interface/vsrtl_interface.h"
 
+QT_FORWARD_DECLARE_CLASS(QAction)
 QT_FORWARD_DECLARE_CLASS(QTreeView)
 
 namespace vsrtl {
@@ -13,6 +15,7 @@ namespace vsrtl {
 class VSRTLWidget;
 class NetlistModel;
 class Netlist;
+class WaveformWidget;
 
 namespace Ui {
 class MainWindow;
@@ -30,8 +33,13 @@ private:
 
     VSRTLWidget* m_vsrtlWidget;
     Netlist* m_netlist;
+    WaveformWidget* m_waveform;
+    std::vector<SimPort*> m_selectedPorts;
+    /// Actions which are disabled while the design is running
+    QList<QAction*> m_runExclusiveActions;
 
     void createToolbar();
+    void showMemoryFootprint();
 };
 
 }  // namespace vsrtl
@@ -15,13 +15,22 @@ SimPort* MultiplexerGraphic::getSelect() {
     return m_component->getSpecialPort(GFX_MUX_SELECT);
 }
 
+void MultiplexerGraphic::portValueChanged(PortGraphic* port) {
+    // The selected input is highlighted
+    if (port->getPort() == getSelect()) {
+        update();
+    } else {
+        ComponentGraphic::portValueChanged(port);
+    }
+}
+
 void MultiplexerGraphic::paintOverlay(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
     // Mark input IO with circles, highlight selected input with green
     painter->save();
 
     const auto inputPorts = m_component->getPorts<SimPort::PortType::in>();
     const auto* select = getSelect();
-    const unsigned int index = select->uValue();
+    const unsigned int index = select->observedValue();
     Q_ASSERT(static_cast<long>(index) < m_inputPorts.size());
 
     for (const auto& ip : qAsConst(m_inputPorts)) {
@@ -11,6 +11,7 @@ class MultiplexerGraphic : public ComponentGraphic {
 public:
     MultiplexerGraphic(SimComponent* c, ComponentGraphic* parent);
     void paintOverlay(QPainter* painter, const QStyleOptionGraphicsItem* item, QWidget* w) override;
+    void portValueChanged(PortGraphic* port) override;
 
 private:
     SimPort* getSelect();
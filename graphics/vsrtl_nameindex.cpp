@@ -0,0 +1,204 @@
+#include "vsrtl_nameindex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <regex>
+#include <string_view>
+
+namespace vsrtl {
+
+namespace {
+
+std::string fold(std::string_view s) {
+    std::string folded(s);
+    std::transform(folded.begin(), folded.end(), folded.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return folded;
+}
+
+uint32_t trigram(const std::string& s, size_t i) {
+    return static_cast<uint8_t>(s[i]) | static_cast<uint8_t>(s[i + 1]) << 8 | static_cast<uint8_t>(s[i + 2]) << 16;
+}
+
+std::vector<std::string> globLiterals(const std::string& pattern) {
+    std::vector<std::string> literals(1);
+    for (char c : pattern) {
+        if (c == '*' || c == '?') {
+            literals.emplace_back();
+        } else {
+            literals.back() += c;
+        }
+    }
+    return literals;
+}
+
+/**
+ * Extracts literal strings which must be contained within any match of @p pattern. Conservative; characters which are
+ * optional, within groups, within character classes or part of escape sequences are not included, and patterns with
+ * alternations yield no literals at all.
+ */
+std::vector<std::string> regexLiterals(const std::string& pattern) {
+    std::vector<std::string> literals(1);
+    int depth = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (depth != 0 && c != '(' && c != ')' && c != '\\' && c != '[' && c != '|') {
+            continue;
+        }
+        switch (c) {
+            case '|':
+                // Alternations within groups only affect the group, which is not considered anyways
+                if (depth == 0) {
+                    return {};
+                }
+                break;
+            case '\\': {
+                if (depth == 0 && i + 1 < pattern.size() && !std::isalnum(static_cast<unsigned char>(pattern[i + 1]))) {
+                    literals.back() += pattern[++i];
+                } else {
+                    // Character class escape (ie. \d) or back reference
+                    i++;
+                    literals.emplace_back();
+                }
+                break;
+            }
+            case '[': {
+                // Skip the character class
+                for (++i; i < pattern.size() && pattern[i] != ']'; ++i) {
+                    if (pattern[i] == '\\') {
+                        ++i;
+                    }
+                }
+                literals.emplace_back();
+                break;
+            }
+            case '*':
+            case '?':
+            case '{': {
+                // The preceding character is optional
+                if (!literals.back().empty()) {
+                    literals.back().pop_back();
+                }
+                if (c == '{') {
+                    i = std::min(pattern.find('}', i), pattern.size());
+                }
+                literals.emplace_back();
+                break;
+            }
+            case '(':
+                depth++;
+                literals.emplace_back();
+                break;
+            case ')':
+                depth = std::max(depth - 1, 0);
+                literals.emplace_back();
+                break;
+            case '+':
+            case '.':
+            case '^':
+            case '$':
+                literals.emplace_back();
+                break;
+            default:
+                literals.back() += c;
+        }
+    }
+    return literals;
+}
+
+}  // namespace
+
+void NameIndex::build(const HierarchyIndex& index) {
+    m_index = &index;
+    m_folded.clear();
+    m_trigrams.clear();
+
+    std::vector<uint32_t> trigrams;
+    for (const auto& entry : index.entries()) {
+        const uint32_t id = static_cast<uint32_t>(m_folded.size());
+        m_folded.push_back(fold(entry.path));
+
+        const std::string& folded = m_folded.back();
+        trigrams.clear();
+        for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+            trigrams.push_back(trigram(folded, i));
+        }
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        for (const auto t : trigrams) {
+            m_trigrams[t].push_back(id);
+        }
+    }
+}
+
+std::vector<uint32_t> NameIndex::candidates(const std::vector<std::string>& literals) const {
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (const auto& literal : literals) {
+        const std::string folded = fold(literal);
+        for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+            auto it = m_trigrams.find(trigram(folded, i));
+            if (it == m_trigrams.end()) {
+                return {};
+            }
+            lists.push_back(&it->second);
+        }
+    }
+
+    if (lists.empty()) {
+        // No trigrams to filter by; all paths are candidates
+        std::vector<uint32_t> all(m_folded.size());
+        for (uint32_t id = 0; id < all.size(); ++id) {
+            all[id] = id;
+        }
+        return all;
+    }
+
+    // Intersect from the shortest posting list and onwards
+    std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+    std::vector<uint32_t> result = *lists.front();
+    std::vector<uint32_t> intersection;
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        intersection.clear();
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(intersection));
+        std::swap(result, intersection);
+    }
+    return result;
+}
+
+std::vector<uint32_t> NameIndex::find(const std::string& query, Syntax syntax) const {
+    std::vector<uint32_t> matches;
+    switch (syntax) {
+        case Syntax::Substring: {
+            const std::string folded = fold(query);
+            for (const auto id : candidates({folded})) {
+                if (m_folded[id].find(folded) != std::string::npos) {
+                    matches.push_back(id);
+                }
+            }
+            break;
+        }
+        case Syntax::Glob: {
+            const std::string folded = fold(query);
+            for (const auto id : candidates(globLiterals(folded))) {
+                if (globMatch(folded, m_folded[id])) {
+                    matches.push_back(id);
+                }
+            }
+            break;
+        }
+        case Syntax::Regex: {
+            const std::regex re(query, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+            for (const auto id : candidates(regexLiterals(query))) {
+                const std::string_view path = entry(id).path;
+                if (std::regex_search(path.begin(), path.end(), re)) {
+                    matches.push_back(id);
+                }
+            }
+            break;
+        }
+    }
+    return matches;
+}
+
+}  // namespace vsrtl
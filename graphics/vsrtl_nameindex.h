@@ -0,0 +1,56 @@
+#ifndef VSRTL_NAMEINDEX_H
+#define VSRTL_NAMEINDEX_H
+
+#include "../interface/vsrtl_hierarchyindex.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vsrtl {
+
+/**
+ * @brief The NameIndex class
+ * Trigram index over the paths of a HierarchyIndex, for queries matching anywhere within a path. Queries are answered
+ * by intersecting the posting lists of the trigrams of the literal parts of the query, after which only the remaining
+ * candidates are matched against the query itself. Matching is case insensitive.
+ */
+class NameIndex {
+public:
+    enum class Syntax {
+        Substring,  // Paths containing the query
+        Glob,       // Paths matching the query in their entirety (see globMatch())
+        Regex       // Paths containing a match of the query, as an ECMAScript regular expression
+    };
+
+    /**
+     * @brief build
+     * Indexes the paths of all entries of @p index, which must be finalized and outlive this index. The id of a path
+     * is the position of its entry within HierarchyIndex::entries().
+     */
+    void build(const HierarchyIndex& index);
+    const HierarchyIndex::Entry& entry(uint32_t id) const { return m_index->entries().at(id); }
+    size_t size() const { return m_folded.size(); }
+
+    /**
+     * @brief find
+     * @returns the ids of the paths matching @p query, in ascending order.
+     * @throws std::regex_error if @p syntax is Regex and @p query is not a valid regular expression.
+     */
+    std::vector<uint32_t> find(const std::string& query, Syntax syntax) const;
+
+private:
+    /// @returns the ids of the paths which may contain all of @p literals.
+    std::vector<uint32_t> candidates(const std::vector<std::string>& literals) const;
+
+    const HierarchyIndex* m_index = nullptr;
+    /// Lower case paths, for case insensitive matching
+    std::vector<std::string> m_folded;
+    /// Ids of the paths containing each trigram, in ascending order
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_trigrams;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_NAMEINDEX_H
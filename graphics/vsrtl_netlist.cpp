@@ -6,9 +6,15 @@
 
 #include "vsrtl_netlistview.h"
 
+#include "../interface/vsrtl_gfxobjecttypes.h"
+
 #include <QAction>
 #include <QHeaderView>
 
+#include <functional>
+#include <regex>
+#include <set>
+
 namespace vsrtl {
 
 Netlist::Netlist(SimDesign& design, QWidget* parent) : QWidget(parent), ui(new Ui::Netlist) {
@@ -38,8 +44,10 @@ Netlist::Netlist(SimDesign& design, QWidget* parent) : QWidget(parent), ui(new U
     m_netlistView->setSelectionMode(QAbstractItemView::ExtendedSelection);
     m_netlistView->setSelectionBehavior(QAbstractItemView::SelectRows);
 
+    // Items are created as they are expanded, so only the first levels of the netlist are expanded up front
+    m_registerModel->fetchAll();
     m_registerView->expandAll();
-    m_netlistView->expandAll();
+    m_netlistView->expandToDepth(0);
 
     m_registerView->setItemDelegate(new NetlistDelegate(this));
 
@@ -54,6 +62,147 @@ Netlist::Netlist(SimDesign& design, QWidget* parent) : QWidget(parent), ui(new U
     connect(collapseAct, &QAction::triggered, [=] { this->setCurrentViewExpandState(false); });
     ui->collapse->setIcon(collapseIcon);
     connect(ui->collapse, &QPushButton::clicked, collapseAct, &QAction::trigger);
+
+    // Filtering. The filter is applied once the user has stopped typing for a moment, and reapplied whenever items are
+    // created in a filtered view.
+    m_nameIndex.build(design.getHierarchyIndex());
+    ui->filterSyntax->addItems({"Substring", "Glob", "Regex"});
+    m_filterTimer.setSingleShot(true);
+    m_filterTimer.setInterval(150);
+    connect(&m_filterTimer, &QTimer::timeout, this, &Netlist::applyFilter);
+    connect(ui->filter, &QLineEdit::textChanged, [=] { m_filterTimer.start(); });
+    connect(ui->filterSyntax, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &Netlist::applyFilter);
+    for (QAbstractItemModel* model : {static_cast<QAbstractItemModel*>(m_netlistModel),
+                                      static_cast<QAbstractItemModel*>(m_registerModel)}) {
+        connect(model, &QAbstractItemModel::rowsInserted, [=] {
+            if (m_filterActive && !m_applyingFilter) {
+                m_filterTimer.start();
+            }
+        });
+    }
+    connect(m_registerView->selectionModel(), &QItemSelectionModel::currentChanged, [=](const QModelIndex& index) {
+        if (m_filterActive && index.isValid()) {
+            if (auto* reg = static_cast<RegisterTreeItem*>(index.internalPointer())->m_register) {
+                emit locateComponent(reg);
+            }
+        }
+    });
+}
+
+namespace {
+
+/// Locating a match creates the items of all of its parents, so only this many matches are located up front. Further
+/// matches are shown once the user expands their parents.
+constexpr size_t MaxLocatedMatches = 100;
+
+/// @returns whether @p object is shown in the netlist; the design itself, constants and their ports are not.
+bool isShown(const SimBase* object) {
+    if (auto* port = dynamic_cast<const SimPort*>(object)) {
+        auto* component = port->getParent<SimComponent>();
+        return component && component->getGraphicsType() != GraphicsTypeFor(Constant);
+    }
+    auto* component = dynamic_cast<const SimComponent*>(object);
+    return component && component->getParent() && component->getGraphicsType() != GraphicsTypeFor(Constant);
+}
+
+/// @returns the component or port shown by @p item
+const SimBase* shownObject(const NetlistTreeItem* item) {
+    return item->m_port ? static_cast<const SimBase*>(item->m_port) : item->m_component;
+}
+const SimBase* shownObject(const RegisterTreeItem* item) {
+    return item->m_register ? item->m_register : item->m_scope;
+}
+
+/**
+ * Expands the parents of the @p located matches, and hides the created rows which are neither in @p matched, in
+ * @p parents (the parents of matches) nor children of a matching component.
+ */
+template <typename T>
+void filterView(NetlistView<T>* view, NetlistModelBase<T>* model, const std::set<const SimBase*>& matched,
+                const std::set<const SimBase*>& parents, const std::vector<QModelIndex>& located, bool active) {
+    std::set<const void*> expanded;
+    for (const auto& index : located) {
+        for (auto parent = index.parent(); parent.isValid() && expanded.insert(parent.internalPointer()).second;
+             parent = parent.parent()) {
+            view->expand(parent);
+        }
+    }
+
+    // Only visits created items; items created later on are filtered once created
+    std::function<void(const QModelIndex&, bool)> apply = [&](const QModelIndex& parent, bool showAll) {
+        const int rows = model->rowCount(parent);
+        for (int row = 0; row < rows; ++row) {
+            const QModelIndex index = model->index(row, 0, parent);
+            const SimBase* object = shownObject(static_cast<const T*>(index.internalPointer()));
+            const bool isMatch = matched.count(object) != 0;
+            const bool show = showAll || isMatch || parents.count(object) != 0;
+            view->setRowHidden(row, parent, !show);
+            if (model->rowCount(index) != 0) {
+                apply(index, showAll || isMatch);
+            }
+        }
+    };
+    apply(QModelIndex(), !active);
+}
+
+}  // namespace
+
+void Netlist::applyFilter() {
+    const std::string query = ui->filter->text().toStdString();
+    std::vector<SimBase*> matches;
+    if (!query.empty()) {
+        try {
+            const auto syntax = static_cast<NameIndex::Syntax>(ui->filterSyntax->currentIndex());
+            for (const auto id : m_nameIndex.find(query, syntax)) {
+                if (isShown(m_nameIndex.entry(id).object)) {
+                    matches.push_back(m_nameIndex.entry(id).object);
+                }
+            }
+            ui->filter->setStyleSheet(QString());
+        } catch (const std::regex_error&) {
+            // Keep the current filter until the expression is valid
+            ui->filter->setStyleSheet("color: red");
+            return;
+        }
+    } else {
+        ui->filter->setStyleSheet(QString());
+    }
+    m_filterActive = !query.empty();
+
+    // Matches and their parents are identified by the objects they show, such that items need not exist to be matched
+    std::set<const SimBase*> matched, parents;
+    for (const SimBase* object : matches) {
+        matched.insert(object);
+        auto* parent = object->getParent<SimComponent>();
+        while (parent && parents.insert(parent).second) {
+            parent = parent->getParent<SimComponent>();
+        }
+    }
+
+    // Locating matches creates the items of their parents
+    m_applyingFilter = true;
+    std::vector<QModelIndex> netlistLocated, registerLocated;
+    for (size_t i = 0; i < matches.size() && i < MaxLocatedMatches; ++i) {
+        SimBase* object = matches[i];
+        QModelIndex index;
+        if (auto* port = dynamic_cast<SimPort*>(object)) {
+            index = m_netlistModel->lookupIndexForPort(port);
+        } else if (auto* component = dynamic_cast<SimComponent*>(object)) {
+            index = m_netlistModel->lookupIndexForComponent(component);
+            if (component->isSynchronous()) {
+                const QModelIndex registerIndex = m_registerModel->lookupIndexForComponent(component);
+                if (registerIndex.isValid()) {
+                    registerLocated.push_back(registerIndex);
+                }
+            }
+        }
+        if (index.isValid()) {
+            netlistLocated.push_back(index);
+        }
+    }
+    filterView(m_netlistView, m_netlistModel, matched, parents, netlistLocated, m_filterActive);
+    filterView(m_registerView, m_registerModel, matched, parents, registerLocated, m_filterActive);
+    m_applyingFilter = false;
 }
 
 void Netlist::setCurrentViewExpandState(bool state) {
@@ -61,10 +210,16 @@ void Netlist::setCurrentViewExpandState(bool state) {
     switch (ui->netlistViews->currentIndex()) {
         case 0: {
             view = m_netlistView;
+            if (state) {
+                m_netlistModel->fetchAll();
+            }
             break;
         }
         case 1: {
             view = m_registerView;
+            if (state) {
+                m_registerModel->fetchAll();
+            }
             break;
         }
         default:
@@ -81,11 +236,13 @@ void Netlist::setCurrentViewExpandState(bool state) {
 }
 
 void Netlist::updateSelection(const std::vector<SimComponent*>& selected) {
+    m_updatingSelection = true;
     m_selectionModel->clearSelection();
     for (const auto& c : selected) {
         m_selectionModel->select(m_netlistModel->lookupIndexForComponent(c),
                                  QItemSelectionModel::SelectionFlag::Select | QItemSelectionModel::SelectionFlag::Rows);
     }
+    m_updatingSelection = false;
 }
 
 namespace {
@@ -107,12 +264,28 @@ void Netlist::handleViewSelectionChanged(const QItemSelection& selected, const Q
     getIndexComponentPtr(deselected, desel_components);
 
     emit selectionChanged(sel_components, desel_components);
+
+    // Selecting a filter result locates it in the scene; ports are located through their component. Selections imposed
+    // by the scene are not located, as they already are visible to the user.
+    if (m_filterActive && !m_updatingSelection && !selected.indexes().isEmpty()) {
+        auto* item = static_cast<NetlistTreeItem*>(selected.indexes().first().internalPointer());
+        SimComponent* component = item->m_component ? item->m_component
+                                  : item->m_port    ? item->m_port->getParent<SimComponent>()
+                                                    : nullptr;
+        if (component) {
+            emit locateComponent(component);
+        }
+    }
 }
 
 Netlist::~Netlist() {
     delete ui;
 }
 
+void Netlist::setEditable(bool editable) {
+    m_registerModel->setEditable(editable);
+}
+
 void Netlist::reloadNetlist() {
     m_netlistModel->invalidate();
     m_registerModel->invalidate();
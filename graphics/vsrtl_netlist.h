@@ -2,9 +2,11 @@
 #define VSRTL_NETLIST_H
 
 #include <QItemSelection>
+#include <QTimer>
 #include <QWidget>
 
 #include "../interface/vsrtl_interface.h"
+#include "vsrtl_nameindex.h"
 #include "vsrtl_netlistview.h"
 
 namespace vsrtl {
@@ -27,16 +29,26 @@ public:
 
 signals:
     void selectionChanged(const std::vector<SimComponent*>& selected, std::vector<SimComponent*>& deselected);
+    /// Emitted when a filter result has been selected, to center the scene on the component of the result.
+    void locateComponent(SimComponent* component);
 
 public slots:
     void reloadNetlist();
     void updateSelection(const std::vector<SimComponent*>&);
+    /// Enables editing the values of registers; disabled while the design is running on another thread.
+    void setEditable(bool editable);
 
 private slots:
     void handleViewSelectionChanged(const QItemSelection& selected, const QItemSelection& deselected);
 
 private:
     void setCurrentViewExpandState(bool state);
+    /**
+     * @brief applyFilter
+     * Hides all rows of the netlist and register views which neither match the current filter, are parents of a match
+     * nor are children of a matching component. The parents of the first matches are expanded.
+     */
+    void applyFilter();
 
     Ui::Netlist* ui;
     QItemSelectionModel* m_selectionModel;
@@ -45,6 +57,14 @@ private:
 
     NetlistView<RegisterTreeItem>* m_registerView;
     NetlistView<NetlistTreeItem>* m_netlistView;
+
+    /// Index of the hierarchical paths of all components and ports of the design, ie. "design->alu->op1"
+    NameIndex m_nameIndex;
+    QTimer m_filterTimer;
+    bool m_filterActive = false;
+    bool m_applyingFilter = false;
+    /// Set while the selection is imposed on the netlist through updateSelection(), rather than made by the user
+    bool m_updatingSelection = false;
 };
 }  // namespace vsrtl
 
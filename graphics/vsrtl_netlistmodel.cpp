@@ -12,10 +12,11 @@
 namespace vsrtl {
 
 NetlistModel::NetlistModel(SimDesign* arch, QObject* parent)
-    : NetlistModelBase({"Component", "I/O", "Value", "Width"}, arch, parent) {
+    : NetlistModelBase({"Component", "I/O", "Value", "Width", "Time"}, arch, parent) {
     rootItem = new NetlistTreeItem(nullptr);
 
-    loadDesign(rootItem, m_arch);
+    // Only the top-level components are created up front; the items of a component are created once it is expanded
+    populate(rootItem);
 }
 
 QVariant NetlistModel::data(const QModelIndex& index, int role) const {
@@ -54,18 +55,42 @@ bool NetlistModel::setData(const QModelIndex& index, const QVariant& value, int)
 }
 
 void NetlistModel::invalidate() {
-    // Data changed within Design, invalidate value column
-    emit dataChanged(index(0, ValueColumn), index(rowCount(), ValueColumn), {Qt::DisplayRole});
+    // Data changed within Design, invalidate value and profile columns of the items which changed
+    notifyChangedItems(ValueColumn, ProfileColumn);
 }
 
-QModelIndex NetlistModel::lookupIndexForComponent(SimComponent* c) const {
-    if (m_componentIndicies.find(c) != m_componentIndicies.end()) {
-        NetlistTreeItem* item = m_componentIndicies.at(c);
-        if (item->index.isValid()) {
-            return item->index;
+QModelIndex NetlistModel::lookupIndexForComponent(SimComponent* c) {
+    auto it = m_componentIndicies.find(c);
+    if (it == m_componentIndicies.end()) {
+        // Populate the items of the parent component of c
+        auto* parent = c->getParent<SimComponent>();
+        if (!parent || parent == componentOf(rootItem)) {
+            return QModelIndex();
+        }
+        const QModelIndex parentIndex = lookupIndexForComponent(parent);
+        if (!parentIndex.isValid()) {
+            return QModelIndex();
+        }
+        fetchMore(parentIndex);
+        it = m_componentIndicies.find(c);
+        if (it == m_componentIndicies.end()) {
+            return QModelIndex();
+        }
+    }
+    NetlistTreeItem* item = it->second;
+    return createIndex(item->childNumber(), 0, item);
+}
+
+QModelIndex NetlistModel::lookupIndexForPort(SimPort* port) {
+    auto* component = port->getParent<SimComponent>();
+    QModelIndex parentIndex;
+    if (component != componentOf(rootItem)) {
+        parentIndex = lookupIndexForComponent(component);
+        if (!parentIndex.isValid()) {
+            return QModelIndex();
         }
     }
-    return QModelIndex();
+    return findChild(parentIndex, [port](const NetlistTreeItem* item) { return item->m_port == port; });
 }
 
 void NetlistModel::addPortToComponent(SimPort* port, NetlistTreeItem* parent, PortDirection dir) {
@@ -92,7 +117,31 @@ bool NetlistModel::indexIsRegisterOutputPortValue(const QModelIndex& index) cons
     return false;
 }
 
-void NetlistModel::loadDesignRecursive(NetlistTreeItem* parent, SimComponent* component) {
+SimComponent* NetlistModel::componentOf(const NetlistTreeItem* item) const {
+    return item == rootItem ? m_arch : item->m_component;
+}
+
+int NetlistModel::pendingChildCount(const NetlistTreeItem* item) const {
+    const SimComponent* component = componentOf(item);
+    if (!component) {
+        return 0;
+    }
+    int count = static_cast<int>(component->getPorts<SimPort::PortType::in>().size() +
+                                 component->getPorts<SimPort::PortType::out>().size());
+    for (const auto& subcomponent : component->getSubComponents()) {
+        if (subcomponent->getGraphicsType() != GraphicsTypeFor(Constant)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void NetlistModel::populate(NetlistTreeItem* parent) {
+    SimComponent* component = componentOf(parent);
+    if (!component) {
+        return;
+    }
+
     // Subcomponents
     for (const auto& subcomponent : component->getSubComponents()) {
         if (subcomponent->getGraphicsType() == GraphicsTypeFor(Constant)) {
@@ -108,9 +157,7 @@ void NetlistModel::loadDesignRecursive(NetlistTreeItem* parent, SimComponent* co
 
         child->m_component = subcomponent;
         child->m_name = QString::fromStdString(subcomponent->getName());
-
-        // Recurse into the child
-        loadDesignRecursive(child, subcomponent);
+        child->m_populated = false;
     }
 
     // I/O ports of component
@@ -132,8 +179,4 @@ SimComponent* NetlistModel::getParentComponent(const QModelIndex& index) const {
     }
     return nullptr;
 }
-
-void NetlistModel::loadDesign(NetlistTreeItem* parent, SimDesign* design) {
-    loadDesignRecursive(parent, design);
-}
 }  // namespace vsrtl
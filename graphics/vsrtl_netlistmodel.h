@@ -16,22 +16,28 @@ class NetlistModel : public NetlistModelBase<NetlistTreeItem> {
     Q_OBJECT
 
 public:
-    enum columns { ComponentColumn, IOColumn, ValueColumn, WidthColumn, NUM_COLUMNS };
+    enum columns { ComponentColumn, IOColumn, ValueColumn, WidthColumn, ProfileColumn, NUM_COLUMNS };
     NetlistModel(SimDesign* arch, QObject* parent = nullptr);
 
     QVariant data(const QModelIndex& index, int role) const override;
     Qt::ItemFlags flags(const QModelIndex& index) const override;
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
 
-    QModelIndex lookupIndexForComponent(SimComponent* c) const;
+    /// @returns the index of @p c. Items of the parent components of @p c are created if not yet present.
+    QModelIndex lookupIndexForComponent(SimComponent* c);
+    /// @returns the index of @p port. Items of the parent components of @p port are created if not yet present.
+    QModelIndex lookupIndexForPort(SimPort* port);
 
 public slots:
     void invalidate() override;
 
+protected:
+    int pendingChildCount(const NetlistTreeItem* item) const override;
+    void populate(NetlistTreeItem* item) override;
+
 private:
     void addPortToComponent(SimPort* port, NetlistTreeItem* parent, PortDirection);
-    void loadDesign(NetlistTreeItem* parent, SimDesign* design);
-    void loadDesignRecursive(NetlistTreeItem* parent, SimComponent* component);
+    SimComponent* componentOf(const NetlistTreeItem* item) const;
     SimComponent* getParentComponent(const QModelIndex& index) const;
     std::map<SimComponent*, NetlistTreeItem*> m_componentIndicies;
     bool indexIsRegisterOutputPortValue(const QModelIndex& index) const;
@@ -67,6 +67,38 @@ public:
 
     int columnCount(const QModelIndex& = QModelIndex()) const override { return m_headers.size(); }
 
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override {
+        const T* item = getTreeItem(parent);
+        return item->childCount() != 0 || (!item->m_populated && pendingChildCount(item) != 0);
+    }
+
+    bool canFetchMore(const QModelIndex& parent) const override { return !getTreeItem(parent)->m_populated; }
+
+    void fetchMore(const QModelIndex& parent) override {
+        T* item = getTreeItem(parent);
+        if (item->m_populated) {
+            return;
+        }
+        const int count = pendingChildCount(item);
+        if (count != 0) {
+            beginInsertRows(parent, 0, count - 1);
+        }
+        populate(item);
+        item->m_populated = true;
+        if (count != 0) {
+            endInsertRows();
+        }
+    }
+
+    /// Creates all items of the subtree below @p parent.
+    void fetchAll(const QModelIndex& parent = QModelIndex()) {
+        fetchMore(parent);
+        const int rows = rowCount(parent);
+        for (int row = 0; row < rows; ++row) {
+            fetchAll(index(row, 0, parent));
+        }
+    }
+
     bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value,
                        int role = Qt::EditRole) override {
         if (role != Qt::EditRole || orientation != Qt::Horizontal || section > m_headers.size())
@@ -87,9 +119,70 @@ protected:
         return rootItem;
     }
 
+    /**
+     * @brief findChild
+     * @returns the index of the first child of @p parent for which @p predicate holds, creating the children of
+     * @p parent if not yet created.
+     */
+    template <typename P>
+    QModelIndex findChild(const QModelIndex& parent, P predicate) {
+        fetchMore(parent);
+        T* item = getTreeItem(parent);
+        for (int row = 0; row < item->childCount(); ++row) {
+            T* child = static_cast<T*>(item->child(row));
+            if (predicate(child)) {
+                return createIndex(row, 0, child);
+            }
+        }
+        return QModelIndex();
+    }
+
+    /// @returns the number of children which populate() will create for @p item.
+    virtual int pendingChildCount(const T* item) const = 0;
+    /// Creates the children of @p item.
+    virtual void populate(T* item) = 0;
+
+    /**
+     * @brief notifyChangedItems
+     * Emits dataChanged() for columns [@p firstColumn, @p lastColumn] of the items whose data changed (see
+     * NetlistTreeItem::updateValue()). Changed rows sharing a parent are coalesced into contiguous ranges. Only created
+     * items are visited; an item created later on reads the current value of its port.
+     */
+    void notifyChangedItems(int firstColumn, int lastColumn) {
+        notifyChangedItems(rootItem, QModelIndex(), firstColumn, lastColumn);
+    }
+
     T* rootItem = nullptr;
     QStringList m_headers;
     SimDesign* m_arch = nullptr;
+
+private:
+    void notifyChangedItems(T* parent, const QModelIndex& parentIndex, int firstColumn, int lastColumn) {
+        int first = -1;
+        auto flush = [&](int last) {
+            if (first != -1) {
+                emit this->dataChanged(index(first, firstColumn, parentIndex), index(last, lastColumn, parentIndex),
+                                       {Qt::DisplayRole});
+                first = -1;
+            }
+        };
+
+        const int rows = parent->childCount();
+        for (int row = 0; row < rows; ++row) {
+            T* item = static_cast<T*>(parent->child(row));
+            if (item->updateValue()) {
+                if (first == -1) {
+                    first = row;
+                }
+            } else {
+                flush(row - 1);
+            }
+            if (item->childCount() != 0) {
+                notifyChangedItems(item, createIndex(row, 0, item), firstColumn, lastColumn);
+            }
+        }
+        flush(rows - 1);
+    }
 };
 
 }  // namespace vsrtl
@@ -1,10 +1,12 @@
 #include "vsrtl_placeroute.h"
 #include "vsrtl_component.h"
+#include "vsrtl_componentgraphic.h"
 #include "vsrtl_graphics_defines.h"
 #include "vsrtl_gridcomponent.h"
 
 #include <deque>
 #include <map>
+#include <set>
 
 namespace vsrtl {
 
@@ -31,12 +33,12 @@ void topologicalSortUtil(SimComponent* c, std::map<SimComponent*, bool>& visited
     stack.push_front(c);
 }
 
-std::deque<SimComponent*> topologicalSort(const std::vector<GridComponent*>& components) {
+std::deque<SimComponent*> topologicalSort(const std::vector<PlacementNode>& nodes) {
     std::map<SimComponent*, bool> visited;
     std::deque<SimComponent*> stack;
 
-    for (const auto& cpt : components)
-        visited[cpt->getComponent()] = false;
+    for (const auto& node : nodes)
+        visited[node.component] = false;
 
     for (const auto& c : visited) {
         if (!c.second) {
@@ -46,8 +48,8 @@ std::deque<SimComponent*> topologicalSort(const std::vector<GridComponent*>& com
     return stack;
 }
 
-std::map<int, std::set<SimComponent*>> ASAPSchedule(const std::vector<GridComponent*>& components) {
-    std::deque<SimComponent*> sortedComponents = topologicalSort(components);
+std::map<int, std::set<SimComponent*>> ASAPSchedule(const std::vector<PlacementNode>& nodes) {
+    std::deque<SimComponent*> sortedComponents = topologicalSort(nodes);
     std::map<int, std::set<SimComponent*>> schedule;
     std::map<SimComponent*, int> componentToDepth;
 
@@ -71,16 +73,20 @@ std::map<int, std::set<SimComponent*>> ASAPSchedule(const std::vector<GridCompon
     return schedule;
 }
 
-std::map<GridComponent*, QPoint> ASAPPlacement(const std::vector<GridComponent*>& components) {
-    std::map<GridComponent*, QPoint> placements;
-    const auto asapSchedule = ASAPSchedule(components);
+std::map<SimComponent*, QPoint> ASAPPlacement(const std::vector<PlacementNode>& nodes) {
+    std::map<SimComponent*, QPoint> placements;
+    std::map<SimComponent*, QSize> sizes;
+    for (const auto& node : nodes) {
+        sizes[node.component] = node.size;
+    }
+    const auto asapSchedule = ASAPSchedule(nodes);
 
     // 1. create a width of each column
     std::map<int, int> columnWidths;
     for (const auto& iter : asapSchedule) {
         int maxWidth = 0;
         for (const auto& c : iter.second) {
-            int width = c->getGraphic<GridComponent>()->getCurrentComponentRect().width();
+            int width = sizes.at(c).width();
             maxWidth = maxWidth < width ? width : maxWidth;
         }
         columnWidths[iter.first] = maxWidth;
@@ -93,9 +99,8 @@ std::map<GridComponent*, QPoint> ASAPPlacement(const std::vector<GridComponent*>
     int y = start.y();
     for (const auto& iter : asapSchedule) {
         for (const auto& c : iter.second) {
-            auto* g = c->getGraphic<GridComponent>();
-            placements[g] = QPoint(x, y);
-            y += g->getCurrentComponentRect().height() + COMPONENT_COLUMN_MARGIN;
+            placements[c] = QPoint(x, y);
+            y += sizes.at(c).height() + COMPONENT_COLUMN_MARGIN;
         }
         x += columnWidths[iter.first] + 2 * COMPONENT_COLUMN_MARGIN;
         y = start.y();
@@ -104,31 +109,178 @@ std::map<GridComponent*, QPoint> ASAPPlacement(const std::vector<GridComponent*>
     return placements;
 }
 
-std::map<GridComponent*, QPoint> topologicalSortPlacement(const std::vector<GridComponent*>& components) {
-    std::map<GridComponent*, QPoint> placements;
-    std::deque<SimComponent*> sortedComponents = topologicalSort(components);
+std::map<SimComponent*, QPoint> topologicalSortPlacement(const std::vector<PlacementNode>& nodes) {
+    std::map<SimComponent*, QPoint> placements;
+    std::map<SimComponent*, QSize> sizes;
+    for (const auto& node : nodes) {
+        sizes[node.component] = node.size;
+    }
+    std::deque<SimComponent*> sortedComponents = topologicalSort(nodes);
 
     // Position components
     QPoint pos = QPoint(SUBCOMPONENT_INDENT, SUBCOMPONENT_INDENT);  // Start a bit offset from the parent borders
     for (const auto& c : sortedComponents) {
-        auto* g = c->getGraphic<GridComponent>();
-        placements[g] = pos;
-        pos.rx() += g->getCurrentComponentRect().width() + COMPONENT_COLUMN_MARGIN;
+        placements[c] = pos;
+        pos.rx() += sizes.at(c).width() + COMPONENT_COLUMN_MARGIN;
     }
 
     return placements;
 }
 
-std::map<GridComponent*, QPoint> PlaceRoute::placeAndRoute(const std::vector<GridComponent*>& components) const {
+std::vector<PlacementNode> PlaceRoute::placementNodes(const std::vector<GridComponent*>& components) {
+    std::vector<PlacementNode> nodes;
+    nodes.reserve(components.size());
+    for (auto* g : components) {
+        nodes.push_back({g->getComponent(), g->getCurrentComponentRect().size()});
+    }
+    return nodes;
+}
+
+std::vector<QPoint> PlaceRoute::place(const std::vector<PlacementNode>& nodes) const {
+    std::map<SimComponent*, QPoint> placements;
     switch (m_placementAlgorithm) {
+        case PlaceAlg::Layered: {
+            return layeredPlacement(nodes);
+        }
         case PlaceAlg::TopologicalSort: {
-            return topologicalSortPlacement(components);
+            placements = topologicalSortPlacement(nodes);
+            break;
         }
         case PlaceAlg::ASAP: {
-            return ASAPPlacement(components);
+            placements = ASAPPlacement(nodes);
+            break;
+        }
+    }
+
+    std::vector<QPoint> positions;
+    positions.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        positions.push_back(placements.at(node.component));
+    }
+    return positions;
+}
+
+std::map<GridComponent*, QPoint> PlaceRoute::placeAndRoute(const std::vector<GridComponent*>& components) const {
+    const auto positions = place(placementNodes(components));
+    std::map<GridComponent*, QPoint> placements;
+    for (size_t i = 0; i < components.size(); ++i) {
+        placements[components[i]] = positions[i];
+    }
+    return placements;
+}
+
+PlaceRouteJob::PlaceRouteJob(const std::vector<GridComponent*>& components, QObject* parent)
+    : QObject(parent), m_shared(std::make_shared<Shared>()) {
+    std::map<GridComponent*, int> indices;
+    for (auto* c : components) {
+        indices[c] = m_tasks.size();
+        m_tasks.push_back({c});
+    }
+    // Link each component to its closest ancestor within the job
+    for (auto& task : m_tasks) {
+        for (auto* p = dynamic_cast<GridComponent*>(task.component->parentItem()); p;
+             p = dynamic_cast<GridComponent*>(p->parentItem())) {
+            auto it = indices.find(p);
+            if (it != indices.end()) {
+                task.parent = it->second;
+                m_tasks[it->second].pendingChildren++;
+                break;
+            }
+        }
+    }
+}
+
+PlaceRouteJob::~PlaceRouteJob() {
+    // Workers refer to the netlist of the components; wait for any running placements to finish
+    m_shared->cancelled = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void PlaceRouteJob::start() {
+    m_running = true;
+    m_done = 0;
+    emit progress(0, m_tasks.size());
+    if (m_tasks.empty()) {
+        finish(false);
+        return;
+    }
+    for (size_t i = 0; i < m_tasks.size(); ++i) {
+        if (m_tasks[i].pendingChildren == 0) {
+            submit(i);
+        }
+    }
+}
+
+void PlaceRouteJob::cancel() {
+    if (m_running) {
+        m_shared->cancelled = true;
+        m_pool.clear();
+        finish(true);
+    }
+}
+
+void PlaceRouteJob::submit(int task) {
+    // The sizes of the subcomponents are read on the GUI thread, after which placement only reads the netlist
+    auto* component = m_tasks[task].component;
+    auto nodes = PlaceRoute::placementNodes(component->getGridSubcomponents());
+    m_pool.start([this, shared = m_shared, task, nodes = std::move(nodes)] {
+        if (shared->cancelled) {
+            return;
+        }
+        auto positions = PlaceRoute::get()->place(nodes);
+        bool first;
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            first = shared->results.empty();
+            shared->results.push_back({task, std::move(positions)});
+        }
+        // Results which arrive before the GUI thread has applied the pending results are applied in the same batch
+        if (first) {
+            QMetaObject::invokeMethod(this, "applyResults", Qt::QueuedConnection);
         }
+    });
+}
+
+void PlaceRouteJob::applyResults() {
+    std::vector<std::pair<int, std::vector<QPoint>>> results;
+    {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        std::swap(results, m_shared->results);
     }
-    Q_UNREACHABLE();
+    if (!m_running) {
+        return;
+    }
+
+    for (const auto& [task, positions] : results) {
+        auto* component = m_tasks[task].component;
+        const auto subcomponents = component->getGridSubcomponents();
+        std::map<GridComponent*, QPoint> placements;
+        // Subcomponents are unchanged while the job runs; positions are in the order of the submitted subcomponents
+        for (size_t i = 0; i < subcomponents.size() && i < positions.size(); ++i) {
+            placements[subcomponents[i]] = positions[i];
+        }
+        component->applyPlacements(placements);
+        if (auto* graphic = dynamic_cast<ComponentGraphic*>(component)) {
+            graphic->routeWires();
+        }
+        m_done++;
+
+        const int parent = m_tasks[task].parent;
+        if (parent != -1 && --m_tasks[parent].pendingChildren == 0) {
+            submit(parent);
+        }
+    }
+
+    emit progress(m_done, m_tasks.size());
+    if (m_done == static_cast<int>(m_tasks.size())) {
+        finish(false);
+    }
+}
+
+void PlaceRouteJob::finish(bool cancelled) {
+    m_running = false;
+    emit finished(cancelled);
 }
 
 }  // namespace vsrtl
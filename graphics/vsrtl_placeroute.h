@@ -1,16 +1,45 @@
 #ifndef VSRTL_PLACEROUTE_H
 #define VSRTL_PLACEROUTE_H
 
+#include <QObject>
 #include <QPointF>
+#include <QSize>
+#include <QThreadPool>
+
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace vsrtl {
 
 class GridComponent;
+class SimComponent;
+
+enum class PlaceAlg { TopologicalSort, ASAP, Layered };
+enum class RouteAlg { Direct, Grid };
+
+/**
+ * @brief The PlacementNode struct
+ * A component to be placed, decoupled from its graphics object such that placement may be computed off the GUI thread.
+ */
+struct PlacementNode {
+    SimComponent* component;
+    /// Size of the component, in grid units
+    QSize size;
+};
+
+/**
+ * @brief layeredPlacement
+ * Sugiyama-style layered placement. Cycles are broken by reversing edges into registers, components are assigned to
+ * columns by their longest path from the sources of the design, and the order of components within each column is
+ * chosen through barycenter sweeps which minimize the number of crossing wires. Operates on flat arrays in near-linear
+ * time, making it suitable for components with hundreds of subcomponents.
+ * @returns the position of each of @p nodes, in the order of @p nodes.
+ */
+std::vector<QPoint> layeredPlacement(const std::vector<PlacementNode>& nodes);
 
-enum class PlaceAlg { TopologicalSort, ASAP };
-enum class RouteAlg { Direct };
 /**
  * @brief The PlaceRoute class
  * Singleton class for containing the various place & route algorithms.
@@ -19,24 +48,92 @@ enum class RouteAlg { Direct };
  */
 class PlaceRoute {
 public:
-    static const PlaceRoute* get() {
+    static PlaceRoute* get() {
         static PlaceRoute* instance = new PlaceRoute();
         return instance;
     }
 
+    /// Selects the algorithm used by subsequent placements, including those of running PlaceRouteJob's.
     void setPlacementAlgorithm(PlaceAlg alg) { m_placementAlgorithm = alg; }
+    PlaceAlg placementAlgorithm() const { return m_placementAlgorithm; }
+    /// Selects the algorithm used for routing the wires of subsequently placed or moved components. Direct routing
+    /// keeps wires as straight port-to-port segments, to be laid out by the user.
     void setRoutingAlgorithm(RouteAlg alg) { m_routingAlgorithm = alg; }
+    RouteAlg routingAlgorithm() const { return m_routingAlgorithm; }
 
     /** @todo: Return a data structure which may be interpreted by the calling GridComponent to place its
      * subcomponents and draw the signal paths. For now, just return a structure suitable for placement*/
     std::map<GridComponent*, QPoint> placeAndRoute(const std::vector<GridComponent*>& components) const;
 
+    /**
+     * @brief place
+     * @returns the position of each of @p nodes within their parent component, in grid coordinates and in the order of
+     * @p nodes. Only reads the netlist of the design, and may thus be called from any thread.
+     */
+    std::vector<QPoint> place(const std::vector<PlacementNode>& nodes) const;
+
+    /// @returns the placement nodes of @p components. Must be called on the GUI thread.
+    static std::vector<PlacementNode> placementNodes(const std::vector<GridComponent*>& components);
+
 private:
     PlaceRoute() {}
 
-    PlaceAlg m_placementAlgorithm = PlaceAlg::ASAP;
-    RouteAlg m_routingAlgorithm = RouteAlg::Direct;
+    std::atomic<PlaceAlg> m_placementAlgorithm = PlaceAlg::ASAP;
+    std::atomic<RouteAlg> m_routingAlgorithm = RouteAlg::Direct;
 };
+
+/**
+ * @brief The PlaceRouteJob class
+ * Places and routes the subcomponents of a set of components on a pool of worker threads. The size of a component
+ * depends on the placement of its subcomponents, so components are placed bottom-up: a component is placed once all of
+ * its descendants within the set have been placed. Components in independent subtrees are placed concurrently.
+ * Placements are computed off the GUI thread and applied to the GridComponents on the GUI thread, in batches.
+ */
+class PlaceRouteJob : public QObject {
+    Q_OBJECT
+public:
+    PlaceRouteJob(const std::vector<GridComponent*>& components, QObject* parent = nullptr);
+    ~PlaceRouteJob() override;
+
+    /// Starts placing the components. The job emits finished() once done or cancelled.
+    void start();
+    /// Stops placing components. Placements which have already been applied are kept.
+    void cancel();
+    bool isRunning() const { return m_running; }
+
+signals:
+    void progress(int done, int total);
+    void finished(bool cancelled);
+
+private slots:
+    void applyResults();
+
+private:
+    struct Task {
+        GridComponent* component;
+        /// Index of the closest ancestor of the component within the job, or -1
+        int parent = -1;
+        /// Number of children of the component within the job which have yet to be placed
+        unsigned pendingChildren = 0;
+    };
+
+    /// State shared with the worker threads
+    struct Shared {
+        std::mutex mutex;
+        std::vector<std::pair<int, std::vector<QPoint>>> results;
+        std::atomic<bool> cancelled = false;
+    };
+
+    void submit(int task);
+    void finish(bool cancelled);
+
+    std::vector<Task> m_tasks;
+    std::shared_ptr<Shared> m_shared;
+    QThreadPool m_pool;
+    int m_done = 0;
+    bool m_running = false;
+};
+
 }  // namespace vsrtl
 
 #endif  // VSRTL_PLACEROUTE_H
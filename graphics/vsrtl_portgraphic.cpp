@@ -2,6 +2,7 @@
 #include "vsrtl_componentgraphic.h"
 #include "vsrtl_port.h"
 #include "vsrtl_scene.h"
+#include "vsrtl_wireanimator.h"
 #include "vsrtl_wiregraphic.h"
 
 #include "math.h"
@@ -34,14 +35,6 @@ PortGraphic::PortGraphic(SimPort* port, vsrtl::SimPort::PortType type, QGraphics
     // Connect changes from simulator through our signal translation mechanism
     wrapSimSignal(port->changed);
 
-    m_colorAnimation = std::make_unique<QPropertyAnimation>(this, "penColor");
-    m_colorAnimation->setDuration(100);
-    m_colorAnimation->setStartValue(m_port->getWidth() == 1 ? WIRE_BOOLHIGH_COLOR : WIRE_HIGH_COLOR);
-
-    m_colorAnimation->setEndValue(WIRE_DEFAULT_COLOR);
-    m_colorAnimation->setEasingCurve(QEasingCurve::Linear);
-    connect(m_colorAnimation.get(), &QPropertyAnimation::valueChanged, this, &PortGraphic::updatePenColor);
-
     setFlag(ItemIsSelectable);
 
     m_inputPortPoint = new PortPoint(this);
@@ -113,6 +106,7 @@ void PortGraphic::simUpdateSlot() {
     Q_ASSERT(m_valueLabel);
     updatePen();
     update();
+    static_cast<ComponentGraphic*>(parentItem())->portValueChanged(this);
 
     // Propagate any changes to current port value to this label, and all other connected ports which may have their
     // labels visible
@@ -180,7 +174,7 @@ void PortGraphic::postSceneConstructionInitialize2() {
             mapToItem(m_valueLabel->parentItem(), {-br.width() - boundingRect().width(), -br.height() / 2}));
 
         // Initial port color is implicitely set by triggering the wire animation
-        m_colorAnimation->start(QPropertyAnimation::KeepWhenStopped);
+        startColorTransition();
     }
 }
 
@@ -255,7 +249,12 @@ QPointF PortGraphic::getOutputPoint() const {
     Q_UNREACHABLE();
 }
 
-void PortGraphic::updatePenColor() {
+void PortGraphic::startColorTransition() {
+    WireAnimator::get()->start(this, m_port->getWidth() == 1 ? WIRE_BOOLHIGH_COLOR : WIRE_HIGH_COLOR,
+                               WIRE_DEFAULT_COLOR);
+}
+
+void PortGraphic::updatePenColor(bool redraw) {
     // This is a source port. Update pen based on current state
     // Selection check is based on whether item is currently selected or about to be selected (via itemChange())
     if (m_signalSelected) {
@@ -264,7 +263,7 @@ void PortGraphic::updatePenColor() {
     } else {
         m_pen.setWidth(WIRE_WIDTH);
         if (m_port->getWidth() == 1) {
-            if (static_cast<bool>(m_port->uValue())) {
+            if (static_cast<bool>(m_port->observedValue())) {
                 m_pen.setColor(WIRE_BOOLHIGH_COLOR);
             } else {
                 m_pen.setColor(WIRE_DEFAULT_COLOR);
@@ -273,7 +272,9 @@ void PortGraphic::updatePenColor() {
             m_pen.setColor(m_penColor);
         }
     }
-    propagateRedraw();
+    if (redraw) {
+        propagateRedraw();
+    }
 }
 
 void PortGraphic::updatePen(bool aboutToBeSelected, bool aboutToBeDeselected) {
@@ -293,9 +294,9 @@ void PortGraphic::updatePen(bool aboutToBeSelected, bool aboutToBeDeselected) {
             /* If the port is anything other than a boolean port, a change in the signal is represented by starting
              * the color change animation. If it is a boolean signal, just update the pen color */
             if (m_port->getWidth() != 1) {
-                portGraphic->m_colorAnimation->start(QPropertyAnimation::KeepWhenStopped);
+                portGraphic->startColorTransition();
             } else {
-                portGraphic->updatePenColor();
+                portGraphic->updatePenColor(false);
             }
 
             // Make output port cascade an update call to all ports and wires which originate from this source
@@ -388,6 +389,26 @@ void PortGraphic::hoverMoveEvent(QGraphicsSceneHoverEvent*) {
     setToolTip(getTooltipString());
 }
 
+size_t PortGraphic::memoryUsage() const {
+    size_t bytes = sizeof(PortGraphic) + m_shape.elementCount() * sizeof(QPainterPath::Element) +
+                   m_widthText.capacity() * sizeof(QChar) + footprint::treeBytes(m_virtualChildren) +
+                   footprint::treeBytes(m_virtualParents);
+    for (const auto* point : {m_inputPortPoint, m_outputPortPoint}) {
+        if (point) {
+            bytes += sizeof(PortPoint);
+        }
+    }
+    for (const auto* label : {m_label, m_portWidthLabel}) {
+        if (label) {
+            bytes += sizeof(Label);
+        }
+    }
+    if (m_valueLabel) {
+        bytes += sizeof(ValueLabel);
+    }
+    return bytes;
+}
+
 void PortGraphic::updateGeometry() {
     prepareGeometryChange();
 
@@ -447,11 +468,14 @@ const QPen& PortGraphic::getPen() {
     }
 }
 
-void PortGraphic::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
+void PortGraphic::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) {
     // Only draw the port if the source of the port is visible, or if the user is currently hovering over the port.
     if (!((m_sourceVisible && !m_userHidden) || m_hoverActive))
         return;
 
+    if (!m_hoverActive && option->levelOfDetailFromTransform(painter->worldTransform()) < LOD_DETAILS)
+        return;
+
     painter->save();
     painter->setPen(getPen());
     const QLineF portLine = QLineF(getInputPoint(), getOutputPoint());
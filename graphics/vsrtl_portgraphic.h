@@ -15,9 +15,6 @@
 
 #include <QFont>
 #include <QPen>
-#include <QPropertyAnimation>
-
-QT_FORWARD_DECLARE_CLASS(QPropertyAnimation)
 
 namespace vsrtl {
 
@@ -26,9 +23,9 @@ class PortPoint;
 
 class PortGraphic : public SimQObject, public GraphicsBaseItem<QGraphicsItem> {
     Q_OBJECT
-    Q_PROPERTY(QColor penColor MEMBER m_penColor)
     friend class ValueLabel;
     friend class VSRTLScene;
+    friend class WireAnimator;
 
 public:
     PortGraphic(SimPort* port, vsrtl::SimPort::PortType type, QGraphicsItem* parent = nullptr);
@@ -61,6 +58,8 @@ public:
     void setPortVisible(bool visible);
 
     void updateGeometry();
+    /// Estimated number of bytes allocated for this port graphic and its labels.
+    size_t memoryUsage() const;
     SimPort* getPort() const { return m_port; }
     void setInputWire(WireGraphic* wire);
     WireGraphic* getOutputWire() { return m_outputWire; }
@@ -91,10 +90,12 @@ public:
 protected:
     void simUpdateSlot() override;
 
-private slots:
-    void updatePenColor();
-
 private:
+    /// Updates the pen of this (source) port. Unless @p redraw is false, all ports and wires driven by this port are
+    /// redrawn.
+    void updatePenColor(bool redraw = true);
+    /// Transitions the wire driven by this port from its high color to its default color (see WireAnimator).
+    void startColorTransition();
     void redraw();
     void propagateRedraw();
     void updatePen(bool aboutToBeSelected = false, bool aboutToBeDeselected = false);
@@ -140,15 +141,13 @@ private:
      */
     std::shared_ptr<Radix> m_radix;
 
-    std::unique_ptr<QPropertyAnimation> m_colorAnimation;
-
     Side m_side = Side::Right;
     Label* m_label = nullptr;
     Label* m_portWidthLabel = nullptr;
     QString m_widthText;
     QFont m_font;
     QPen m_pen;
-    QColor m_penColor;
+    QColor m_penColor = WIRE_DEFAULT_COLOR;  // Current color of the wire color transition
     QPen m_oldPen;  // Pen which was previously used for paint(). If a change between m_oldPen and m_pen is seen, this
                     // triggers redrawing of the connected wires
 
@@ -1,7 +1,5 @@
 #include "vsrtl_radix.h"
 
-#include "../interface/vsrtl_binutils.h"
-
 #include "../interface/vsrtl_binutils.h"
 #include "../interface/vsrtl_interface.h"
 
@@ -11,8 +9,30 @@
 #include <QObject>
 #include <QString>
 
+#include <typeindex>
+#include <unordered_map>
+
 namespace vsrtl {
 
+namespace {
+
+/**
+ * Enum strings are looked up in a table per enum port type, which is filled as values are encoded. Tables are keyed by
+ * the dynamic type of the port rather than by the port itself, since each enum port type corresponds to a single enum,
+ * and a port type outlives any design (and thus any port) using it.
+ */
+const QString& enumString(const SimPort* port, VSRTL_VT_U value) {
+    static std::unordered_map<std::type_index, std::unordered_map<VSRTL_VT_U, QString>> tables;
+    auto& table = tables[std::type_index(typeid(*port))];
+    auto it = table.find(value);
+    if (it == table.end()) {
+        it = table.emplace(value, QString::fromStdString(port->valueToEnumString(value))).first;
+    }
+    return it->second;
+}
+
+}  // namespace
+
 VSRTL_VT_U decodePortRadixValue(const SimPort& port, const Radix type, const QString& valueString) {
     bool ok = false;
     VSRTL_VT_U value = 0;
@@ -53,7 +73,10 @@ VSRTL_VT_U decodePortRadixValue(const SimPort& port, const Radix type, const QSt
 }
 
 QString encodePortRadixValue(const SimPort* port, const Radix type) {
-    VSRTL_VT_U value = port->uValue();
+    return encodePortRadixValue(port, type, port->observedValue());
+}
+
+QString encodePortRadixValue(const SimPort* port, const Radix type, VSRTL_VT_U value) {
     switch (type) {
         case Radix::Hex: {
             const unsigned maxChars = (port->getWidth() / 4) + (port->getWidth() % 4 != 0 ? 1 : 0);
@@ -73,12 +96,27 @@ QString encodePortRadixValue(const SimPort* port, const Radix type) {
                 throw std::runtime_error("Port is not an Enum port");
             }
 
-            return QString::fromStdString(port->valueToEnumString());
+            return enumString(port, value);
         }
     }
     Q_UNREACHABLE();
 }
 
+bool PortValueText::update(const SimPort* port, Radix radix) {
+    return update(port, radix, port->observedValue());
+}
+
+bool PortValueText::update(const SimPort* port, Radix radix, VSRTL_VT_U value) {
+    if (port == m_port && radix == m_radix && value == m_value) {
+        return false;
+    }
+    m_port = port;
+    m_radix = radix;
+    m_value = value;
+    m_text = encodePortRadixValue(port, radix, value);
+    return true;
+}
+
 QMenu* createPortRadixMenu(const SimPort* port, Radix& type) {
     QMenu* menu = new QMenu("Radix");
     QActionGroup* RadixActionGroup = new QActionGroup(menu);
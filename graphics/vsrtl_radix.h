@@ -2,9 +2,9 @@
 #define VSRTL_Radix_H
 
 #include <QRegularExpression>
+#include <QString>
 #include "../interface/vsrtl_defines.h"
 
-QT_FORWARD_DECLARE_CLASS(QString)
 QT_FORWARD_DECLARE_CLASS(QMenu)
 
 namespace vsrtl {
@@ -18,8 +18,44 @@ static const auto signedRegex = QRegularExpression("[-]*[0-9]+");
 
 VSRTL_VT_U decodePortRadixValue(const SimPort& port, const Radix type, const QString& valueString);
 QString encodePortRadixValue(const SimPort* port, const Radix type);
+/**
+ * @brief encodePortRadixValue
+ * Encodes an arbitrary @p value as if it was the current value of @p port. Used by views which display historical
+ * port values (ie. the waveform viewer).
+ */
+QString encodePortRadixValue(const SimPort* port, const Radix type, VSRTL_VT_U value);
 QMenu* createPortRadixMenu(const SimPort* port, Radix& type);
 
+/**
+ * @brief The PortValueText class
+ * Caches the encoding of a port value. The value is only re-encoded once the port, value or radix differs from those of
+ * the cached encoding, such that views which are synchronized or repainted without the port changing value reuse the
+ * same (implicitly shared) string.
+ */
+class PortValueText {
+public:
+    /**
+     * @brief update
+     * Encodes the current value of @p port in @p radix, unless it is already cached.
+     * @returns whether the text changed.
+     */
+    bool update(const SimPort* port, Radix radix);
+    bool update(const SimPort* port, Radix radix, VSRTL_VT_U value);
+    const QString& text() const { return m_text; }
+
+    /// Convenience function for updating and returning the text.
+    const QString& get(const SimPort* port, Radix radix) {
+        update(port, radix);
+        return m_text;
+    }
+
+private:
+    const SimPort* m_port = nullptr;
+    Radix m_radix = Radix::Hex;
+    VSRTL_VT_U m_value = 0;
+    QString m_text;
+};
+
 }  // namespace vsrtl
 
 #endif  // VSRTL_Radix_H
@@ -31,7 +31,7 @@ QVariant RegisterTreeItem::data(int column, int role) const {
                 return QBrush(Qt::blue);
             }
             case Qt::DisplayRole: {
-                return encodePortRadixValue(m_port, m_radix);
+                return valueText();
             }
         }
     }
@@ -63,8 +63,8 @@ bool RegisterTreeItem::setData(int, const QVariant& value, int) {
 }
 
 void RegisterModel::invalidate() {
-    // Data changed within Design, invalidate value column
-    emit dataChanged(index(0, ValueColumn), index(rowCount(), ValueColumn), {Qt::DisplayRole});
+    // Data changed within Design, invalidate value column of the registers which changed
+    notifyChangedItems(ValueColumn, ValueColumn);
 }
 
 RegisterModel::RegisterModel(SimDesign* arch, QObject* parent)
@@ -87,7 +87,7 @@ Qt::ItemFlags RegisterModel::flags(const QModelIndex& index) const {
     Qt::ItemFlags flags = QAbstractItemModel::flags(index);
 
     // Register values are editable
-    if (index.column() == 1 && getTreeItem(index)->m_register != nullptr) {
+    if (m_editable && index.column() == 1 && getTreeItem(index)->m_register != nullptr) {
         flags |= Qt::ItemIsEditable;
     }
 
@@ -96,7 +96,7 @@ Qt::ItemFlags RegisterModel::flags(const QModelIndex& index) const {
 
 bool RegisterModel::setData(const QModelIndex& index, const QVariant& var, int role) {
     auto* item = getTreeItem(index);
-    if (item) {
+    if (item && m_editable) {
         VSRTL_VT_U value = decodePortRadixValue(*item->m_port, item->m_radix, var.toString());
         return item->setData(index.column(), QVariant::fromValue(value), role);
     }
@@ -108,48 +108,71 @@ void RegisterModel::loadDesign(RegisterTreeItem* parent, SimDesign* design) {
     m_design = design;
     const auto& registers = design->getRegisters();
 
-    std::map<const SimComponent*, RegisterTreeItem*> parentMap;
-
     const auto* rootComponent = dynamic_cast<const SimComponent*>(design);
-    parentMap[rootComponent] = parent;
+    parent->m_scope = rootComponent;
+    m_children[rootComponent];
 
-    // Build a tree representing the hierarchy of components and subcomponents containing registers
+    // Build the hierarchy of components and subcomponents containing registers
     for (const auto& reg : registers) {
         const auto* regParent = reg->getParent<SimComponent>();
-        RegisterTreeItem* regParentNetlistItem = nullptr;
-
-        if (parentMap.count(regParent) == 0) {
-            // Create new parents in the tree until either the root component is detected, or a parent of a parent
-            // is already in the tree
-            std::vector<const SimComponent*> newParentsInTree;
-            while (regParent != rootComponent && parentMap.count(regParent) == 0) {
-                newParentsInTree.insert(newParentsInTree.begin(), regParent);
-                regParent = regParent->getParent<SimComponent>();
-            }
-            // At this point, the first value in newParentsInTree has its parent present in the tree. Extend the
-            // tree from this index
-            regParentNetlistItem = parentMap[regParent];
-            for (const auto& p : newParentsInTree) {
-                auto* newParent = new RegisterTreeItem(regParentNetlistItem, m_design);
-                regParentNetlistItem->insertChild(regParentNetlistItem->childCount(), newParent);
-                regParentNetlistItem = newParent;
-                regParentNetlistItem->m_name = QString::fromStdString(p->getName());
-                Q_ASSERT(parentMap.count(p) == 0);
-                parentMap[p] = regParentNetlistItem;
-            }
-            // After the newParentsInTree stack has been iterated through, 'regParentNetlistItem' will point to the
-            // parent tree item of the current 'reg' in the outer foor loop
-        } else {
-            regParentNetlistItem = parentMap[regParent];
+
+        // Add parents to the hierarchy until either the root component is detected, or a parent of a parent is
+        // already in the hierarchy
+        std::vector<SimComponent*> newParentsInTree;
+        for (auto* p = reg->getParent<SimComponent>(); p != rootComponent && m_children.count(p) == 0;
+             p = p->getParent<SimComponent>()) {
+            newParentsInTree.insert(newParentsInTree.begin(), p);
+        }
+        for (auto* p : newParentsInTree) {
+            m_children[p->getParent<SimComponent>()].push_back({p, false});
+            m_children[p];
         }
 
-        // Add register to its parent tree item
+        // Add register to its parent
+        m_children[regParent].push_back({reg, true});
+    }
 
-        auto* child = new RegisterTreeItem(regParentNetlistItem, m_design);
-        child->setRegister(reg);
-        regParentNetlistItem->insertChild(regParentNetlistItem->childCount(), child);
+    // Only the top-level items are created up front; the items of a component are created once it is expanded
+    populate(parent);
+}
 
-        // Set component data (component name and signal value)
+QModelIndex RegisterModel::lookupIndexForComponent(const SimComponent* c) {
+    const auto* parent = c->getParent<SimComponent>();
+    if (!parent) {
+        return QModelIndex();
+    }
+    QModelIndex parentIndex;
+    if (parent != rootItem->m_scope) {
+        parentIndex = lookupIndexForComponent(parent);
+        if (!parentIndex.isValid()) {
+            return QModelIndex();
+        }
+    }
+    return findChild(parentIndex,
+                     [c](const RegisterTreeItem* item) { return item->m_register == c || item->m_scope == c; });
+}
+
+int RegisterModel::pendingChildCount(const RegisterTreeItem* item) const {
+    auto it = m_children.find(item->m_scope);
+    return it == m_children.end() ? 0 : static_cast<int>(it->second.size());
+}
+
+void RegisterModel::populate(RegisterTreeItem* parent) {
+    auto it = m_children.find(parent->m_scope);
+    if (it == m_children.end()) {
+        return;
+    }
+
+    for (const auto& node : it->second) {
+        auto* child = new RegisterTreeItem(parent, m_design);
+        if (node.isRegister) {
+            child->setRegister(node.component);
+        } else {
+            child->m_name = QString::fromStdString(node.component->getName());
+            child->m_scope = node.component;
+            child->m_populated = false;
+        }
+        parent->insertChild(parent->childCount(), child);
     }
 }
 
@@ -9,6 +9,9 @@
 #include "vsrtl_register.h"
 #include "vsrtl_treeitem.h"
 
+#include <map>
+#include <vector>
+
 namespace vsrtl {
 
 class RegisterTreeItem : public NetlistTreeItem {
@@ -23,6 +26,8 @@ public:
 
     SimComponent* m_register = nullptr;
     SimDesign* m_design = nullptr;
+    /// For items of components containing registers; the component whose registers are listed below this item.
+    const SimComponent* m_scope = nullptr;
 };
 
 class RegisterModel : public NetlistModelBase<RegisterTreeItem> {
@@ -36,13 +41,35 @@ public:
     Qt::ItemFlags flags(const QModelIndex& index) const override;
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
 
+    /**
+     * @brief lookupIndexForComponent
+     * @returns the index of register @p c, or of component @p c containing registers. Items of the parent components
+     * of @p c are created if not yet present.
+     */
+    QModelIndex lookupIndexForComponent(const SimComponent* c);
+
+    void setEditable(bool editable) { m_editable = editable; }
+
 public slots:
     void invalidate() override;
 
+protected:
+    int pendingChildCount(const RegisterTreeItem* item) const override;
+    void populate(RegisterTreeItem* item) override;
+
 private:
     void loadDesign(RegisterTreeItem* parent, SimDesign* component);
 
+    /// A child of a component in the register tree; either a register, or a component containing registers
+    struct RegisterNode {
+        SimComponent* component;
+        bool isRegister;
+    };
+
     SimDesign* m_design = nullptr;
+    bool m_editable = true;
+    /// The register hierarchy of the design, from which tree items are created once their parent is expanded
+    std::map<const SimComponent*, std::vector<RegisterNode>> m_children;
 };
 
 }  // namespace vsrtl
@@ -0,0 +1,465 @@
+#include "vsrtl_router.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace vsrtl {
+
+namespace {
+
+constexpr int Horizontal = 0;
+constexpr int Vertical = 1;
+/// Axis of a step between two grid points which are not adjacent (a direct connection of an unroutable sink)
+constexpr int Direct = 2;
+/// Number of negotiation iterations without a reduction of contested channels after which negotiation stops
+constexpr unsigned MaxIterationsWithoutImprovement = 3;
+
+int axisOf(GridRouter::Axis axis) {
+    return axis == GridRouter::Axis::Horizontal ? Horizontal : Vertical;
+}
+
+int manhattan(const QPoint& a, const QPoint& b) {
+    return std::abs(a.x() - b.x()) + std::abs(a.y() - b.y());
+}
+
+}  // namespace
+
+/// Per-thread state of the A* searches
+struct GridRouter::Scratch {
+    explicit Scratch(size_t cells)
+        : cost(cells * 2), from(cells * 2), visited(cells * 2, 0), treeNode(cells), inTree(cells, 0) {}
+
+    /// Cost of reaching each state (cell * 2 + axis of the last step)
+    std::vector<float> cost;
+    /// The state from which each state was reached, or -1 for states on the tree
+    std::vector<int> from;
+    /// Search generation in which each state was last reached
+    std::vector<uint32_t> visited;
+    uint32_t generation = 0;
+    /// Node within the tree of the net being routed of each cell, valid if inTree matches the tree generation
+    std::vector<int> treeNode;
+    std::vector<uint32_t> inTree;
+    uint32_t treeGeneration = 0;
+    std::vector<std::pair<float, int>> heap;
+};
+
+GridRouter::GridRouter(const QRect& bounds) : m_bounds(bounds), m_width(bounds.width()), m_height(bounds.height()) {
+    const size_t cells = std::max(0, m_width) * std::max(0, m_height);
+    m_obstacles.assign(cells, false);
+    m_terminals.assign(cells, -1);
+}
+
+bool GridRouter::contains(const QPoint& p) const {
+    return p.x() >= m_bounds.left() && p.x() < m_bounds.left() + m_width && p.y() >= m_bounds.top() &&
+           p.y() < m_bounds.top() + m_height;
+}
+
+void GridRouter::addObstacle(const QRect& rect) {
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        for (int x = rect.left(); x <= rect.right(); ++x) {
+            if (contains({x, y})) {
+                m_obstacles[cellOf({x, y})] = true;
+            }
+        }
+    }
+}
+
+std::vector<RouteTree> GridRouter::route(const std::vector<Net>& nets) {
+    const size_t cells = m_obstacles.size();
+    m_occupancy.assign(cells * 2, 0);
+    m_history.assign(cells * 2, 0);
+    m_statistics = Statistics();
+    m_reused.assign(nets.size(), false);
+    std::fill(m_terminals.begin(), m_terminals.end(), -1);
+    for (size_t i = 0; i < nets.size(); ++i) {
+        if (contains(nets[i].source.pos)) {
+            m_terminals[cellOf(nets[i].source.pos)] = i;
+        }
+        for (const auto& t : nets[i].sinks) {
+            if (contains(t.pos)) {
+                m_terminals[cellOf(t.pos)] = i;
+            }
+        }
+    }
+
+    // 1. Keep the previous routes which are still valid
+    std::vector<CellTree> trees(nets.size());
+    std::vector<int> pending;
+    for (size_t i = 0; i < nets.size(); ++i) {
+        if (reusePrevious(nets[i], i, trees[i])) {
+            m_reused[i] = true;
+            m_statistics.reused++;
+            commit(trees[i], 1);
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    // 2. Route the remaining nets concurrently. Each net is routed against the occupancy of the kept routes only, such
+    // that the result does not depend on the order in which nets are routed.
+    float presentCost = 0.5;
+    unsigned threads = m_parameters.threads != 0 ? m_parameters.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, (pending.size() + 7) / 8));
+    std::atomic<size_t> next = 0;
+    auto worker = [&] {
+        Scratch scratch(cells);
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            const int net = pending[i];
+            routeNet(nets[net], presentCost, scratch, trees[net]);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+    for (const int net : pending) {
+        commit(trees[net], 1);
+    }
+
+    // 3. Negotiate congestion. Contested channels become increasingly expensive, and the nets using them are rerouted
+    // until no channel is used by more than a single net.
+    // Negotiation stops early if the number of contested channels stagnates, ie. when the nets cannot be separated.
+    Scratch scratch(cells);
+    size_t leastContested = std::numeric_limits<size_t>::max();
+    unsigned withoutImprovement = 0;
+    for (unsigned iteration = 0; iteration < m_parameters.maxIterations; ++iteration) {
+        size_t contested = 0;
+        for (size_t ch = 0; ch < m_occupancy.size(); ++ch) {
+            if (m_occupancy[ch] > 1) {
+                m_history[ch] += m_parameters.historyCost * (m_occupancy[ch] - 1);
+                contested++;
+            }
+        }
+        if (contested == 0) {
+            break;
+        }
+        if (contested < leastContested) {
+            leastContested = contested;
+            withoutImprovement = 0;
+        } else if (++withoutImprovement == MaxIterationsWithoutImprovement) {
+            break;
+        }
+        m_statistics.iterations++;
+        presentCost *= 2;
+        for (size_t i = 0; i < nets.size(); ++i) {
+            if (isContested(trees[i])) {
+                commit(trees[i], -1);
+                m_reused[i] = false;
+                routeNet(nets[i], presentCost, scratch, trees[i]);
+                commit(trees[i], 1);
+            }
+        }
+    }
+    m_statistics.reused = std::count(m_reused.begin(), m_reused.end(), true);
+    m_statistics.contested = std::count_if(m_occupancy.begin(), m_occupancy.end(), [](auto o) { return o > 1; });
+    for (const auto& tree : trees) {
+        m_statistics.unroutable += tree.unroutable;
+    }
+
+    std::vector<RouteTree> routes;
+    routes.reserve(nets.size());
+    for (const auto& tree : trees) {
+        routes.push_back(compress(tree));
+    }
+    return routes;
+}
+
+bool GridRouter::reusePrevious(const Net& net, int netIdx, CellTree& tree) const {
+    const RouteTree* previous = net.previous;
+    if (!previous || previous->empty() || previous->points[0] != net.source.pos ||
+        previous->sinks.size() != net.sinks.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < net.sinks.size(); ++i) {
+        const int sink = previous->sinks[i];
+        if (sink < 0 || sink >= static_cast<int>(previous->points.size()) ||
+            previous->points[sink] != net.sinks[i].pos) {
+            return false;
+        }
+    }
+
+    // Expand the route to grid points; every segment must be rectilinear and free of obstacles and foreign terminals
+    std::vector<int> nodeOf(previous->points.size(), -1);
+    tree = CellTree();
+    for (size_t i = 0; i < previous->points.size(); ++i) {
+        const QPoint& p = previous->points[i];
+        if (!contains(p)) {
+            return false;
+        }
+        const int parent = previous->parents[i];
+        if (i == 0) {
+            nodeOf[i] = tree.cells.size();
+            tree.cells.push_back(cellOf(p));
+            tree.parents.push_back(-1);
+            continue;
+        }
+        if (parent < 0 || parent >= static_cast<int>(i) || nodeOf[parent] == -1) {
+            // Points must be ordered such that parents precede their children
+            return false;
+        }
+        const QPoint& from = previous->points[parent];
+        if (from.x() != p.x() && from.y() != p.y()) {
+            return false;
+        }
+        const QPoint step((p.x() > from.x()) - (p.x() < from.x()), (p.y() > from.y()) - (p.y() < from.y()));
+        int node = nodeOf[parent];
+        for (QPoint c = from; c != p;) {
+            c = QPoint(c.x() + step.x(), c.y() + step.y());
+            const int cell = cellOf(c);
+            const int owner = m_terminals[cell];
+            if (m_obstacles[cell] || (owner != -1 && owner != netIdx)) {
+                return false;
+            }
+            tree.cells.push_back(cell);
+            tree.parents.push_back(node);
+            node = tree.cells.size() - 1;
+        }
+        nodeOf[i] = node;
+    }
+    for (const int sink : previous->sinks) {
+        tree.sinks.push_back(nodeOf[sink]);
+    }
+    computeChannels(tree);
+    return true;
+}
+
+void GridRouter::routeNet(const Net& net, float presentCost, Scratch& scratch, CellTree& tree) {
+    tree = CellTree();
+    tree.sinks.assign(net.sinks.size(), -1);
+    if (!contains(net.source.pos)) {
+        return;
+    }
+    tree.cells.push_back(cellOf(net.source.pos));
+    tree.parents.push_back(-1);
+
+    // Sinks are connected in order of their distance to the source
+    std::vector<int> order(net.sinks.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return manhattan(net.sinks[a].pos, net.source.pos) < manhattan(net.sinks[b].pos, net.source.pos);
+    });
+
+    for (const int sink : order) {
+        if (!routeSink(net, sink, presentCost, scratch, tree) && contains(net.sinks[sink].pos)) {
+            // Connect the sink directly to the source
+            tree.unroutable++;
+            tree.sinks[sink] = tree.cells.size();
+            tree.cells.push_back(cellOf(net.sinks[sink].pos));
+            tree.parents.push_back(0);
+        }
+    }
+    computeChannels(tree);
+}
+
+bool GridRouter::routeSink(const Net& net, int sink, float presentCost, Scratch& s, CellTree& tree) const {
+    const QPoint target = net.sinks[sink].pos;
+    if (!contains(target)) {
+        return false;
+    }
+    const int targetCell = cellOf(target);
+    const int targetAxis = axisOf(net.sinks[sink].axis);
+    const float bend = m_parameters.bendCost;
+
+    // Mark the cells of the tree; new branches may start at any point of the tree but may not cross it
+    if (++s.treeGeneration == 0) {
+        std::fill(s.inTree.begin(), s.inTree.end(), 0);
+        s.treeGeneration = 1;
+    }
+    for (size_t i = 0; i < tree.cells.size(); ++i) {
+        s.inTree[tree.cells[i]] = s.treeGeneration;
+        s.treeNode[tree.cells[i]] = i;
+    }
+    std::vector<bool> isSink(tree.cells.size(), false);
+    for (const int node : tree.sinks) {
+        if (node != -1) {
+            isSink[node] = true;
+        }
+    }
+
+    if (++s.generation == 0) {
+        std::fill(s.visited.begin(), s.visited.end(), 0);
+        s.generation = 1;
+    }
+    auto heuristic = [&](int cell) { return static_cast<float>(manhattan(pointOf(cell), target)); };
+    auto greater = std::greater<std::pair<float, int>>();
+    auto relax = [&](int state, float cost, int from) {
+        if (s.visited[state] == s.generation && s.cost[state] <= cost) {
+            return;
+        }
+        s.visited[state] = s.generation;
+        s.cost[state] = cost;
+        s.from[state] = from;
+        s.heap.push_back({cost + heuristic(state >> 1), state});
+        std::push_heap(s.heap.begin(), s.heap.end(), greater);
+    };
+
+    s.heap.clear();
+    const int sourceAxis = axisOf(net.source.axis);
+    for (size_t i = 0; i < tree.cells.size(); ++i) {
+        if (isSink[i] || tree.cells[i] == targetCell) {
+            continue;
+        }
+        for (int axis : {Horizontal, Vertical}) {
+            relax(tree.cells[i] * 2 + axis, i == 0 && axis != sourceAxis ? bend : 0, -1);
+        }
+    }
+
+    // Congestion-aware cost of a step into @p cell along @p axis
+    auto stepCost = [&](int cell, int axis) {
+        const int ch = cell * 2 + axis;
+        float cost = (1 + m_history[ch]) * (1 + presentCost * m_occupancy[ch]);
+        if (m_occupancy[cell * 2 + (1 - axis)] != 0) {
+            cost += m_parameters.crossingCost;
+        }
+        return cost;
+    };
+
+    int goal = -1;
+    static constexpr int dx[] = {1, -1, 0, 0};
+    static constexpr int dy[] = {0, 0, 1, -1};
+    while (!s.heap.empty()) {
+        std::pop_heap(s.heap.begin(), s.heap.end(), greater);
+        const auto [f, state] = s.heap.back();
+        s.heap.pop_back();
+        const int cell = state >> 1;
+        if (f > s.cost[state] + heuristic(cell) + 1e-3f) {
+            continue;  // Stale entry
+        }
+        if (cell == targetCell) {
+            goal = state;
+            break;
+        }
+        const int axis = state & 1;
+        const QPoint p = pointOf(cell);
+        for (int dir = 0; dir < 4; ++dir) {
+            const QPoint np(p.x() + dx[dir], p.y() + dy[dir]);
+            if (!contains(np)) {
+                continue;
+            }
+            const int ncell = cellOf(np);
+            if (ncell != targetCell) {
+                // Terminals are only entered as the target of the search; this also keeps sinks as leaves of the tree
+                if (m_obstacles[ncell] || m_terminals[ncell] != -1 || s.inTree[ncell] == s.treeGeneration) {
+                    continue;
+                }
+            }
+            const int naxis = dx[dir] != 0 ? Horizontal : Vertical;
+            float cost = s.cost[state] + stepCost(ncell, naxis);
+            if (naxis != axis) {
+                cost += bend;
+            }
+            if (ncell == targetCell && naxis != targetAxis) {
+                cost += bend;
+            }
+            relax(ncell * 2 + naxis, cost, state);
+        }
+    }
+    if (goal == -1) {
+        return false;
+    }
+
+    // Attach the path to the tree, starting from the tree point at which it branches off
+    std::vector<int> path;
+    int state = goal;
+    for (; s.from[state] != -1; state = s.from[state]) {
+        path.push_back(state >> 1);
+    }
+    int parent = s.treeNode[state >> 1];
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        tree.cells.push_back(*it);
+        tree.parents.push_back(parent);
+        parent = tree.cells.size() - 1;
+    }
+    tree.sinks[sink] = parent;
+    return true;
+}
+
+void GridRouter::computeChannels(CellTree& tree) const {
+    tree.channels.clear();
+    for (size_t i = 0; i < tree.cells.size(); ++i) {
+        const int parent = tree.parents[i];
+        if (parent == -1) {
+            continue;
+        }
+        const QPoint a = pointOf(tree.cells[parent]);
+        const QPoint b = pointOf(tree.cells[i]);
+        if (manhattan(a, b) != 1) {
+            continue;
+        }
+        const int axis = a.y() == b.y() ? Horizontal : Vertical;
+        tree.channels.push_back(tree.cells[parent] * 2 + axis);
+        tree.channels.push_back(tree.cells[i] * 2 + axis);
+    }
+    std::sort(tree.channels.begin(), tree.channels.end());
+    tree.channels.erase(std::unique(tree.channels.begin(), tree.channels.end()), tree.channels.end());
+}
+
+void GridRouter::commit(const CellTree& tree, int delta) {
+    for (const int ch : tree.channels) {
+        m_occupancy[ch] += delta;
+    }
+}
+
+bool GridRouter::isContested(const CellTree& tree) const {
+    return std::any_of(tree.channels.begin(), tree.channels.end(), [&](int ch) { return m_occupancy[ch] > 1; });
+}
+
+RouteTree GridRouter::compress(const CellTree& tree) const {
+    RouteTree route;
+    const int n = tree.cells.size();
+    if (n == 0) {
+        return route;
+    }
+    std::vector<int> children(n, 0), onlyChild(n, -1);
+    std::vector<bool> isSink(n, false);
+    for (int i = 1; i < n; ++i) {
+        children[tree.parents[i]]++;
+        onlyChild[tree.parents[i]] = i;
+    }
+    for (const int sink : tree.sinks) {
+        if (sink != -1) {
+            isSink[sink] = true;
+        }
+    }
+    auto axis = [&](int from, int to) {
+        const QPoint a = pointOf(tree.cells[from]);
+        const QPoint b = pointOf(tree.cells[to]);
+        if (manhattan(a, b) != 1) {
+            return Direct;
+        }
+        return a.y() == b.y() ? Horizontal : Vertical;
+    };
+
+    // Points are kept at the source, sinks, branches and corners. Parents precede their children in the tree.
+    std::vector<int> index(n, -1), keptAncestor(n, -1);
+    for (int i = 0; i < n; ++i) {
+        const int parent = tree.parents[i];
+        const bool keep = parent == -1 || isSink[i] || children[i] != 1 || axis(parent, i) == Direct ||
+                          axis(parent, i) != axis(i, onlyChild[i]);
+        const int ancestor = parent == -1 ? -1 : (index[parent] != -1 ? index[parent] : keptAncestor[parent]);
+        if (keep) {
+            index[i] = route.points.size();
+            route.points.push_back(pointOf(tree.cells[i]));
+            route.parents.push_back(ancestor);
+        } else {
+            keptAncestor[i] = ancestor;
+        }
+    }
+    for (const int sink : tree.sinks) {
+        route.sinks.push_back(sink == -1 ? -1 : index[sink]);
+    }
+    return route;
+}
+
+}  // namespace vsrtl
@@ -0,0 +1,144 @@
+#ifndef VSRTL_ROUTER_H
+#define VSRTL_ROUTER_H
+
+#include <QPoint>
+#include <QRect>
+
+#include <cstdint>
+#include <vector>
+
+namespace vsrtl {
+
+/**
+ * @brief The RouteTree struct
+ * The route of a net; a tree of rectilinear segments rooted at the source of the net. Only the corners, branches and
+ * terminals of the route are stored, in grid coordinates.
+ */
+struct RouteTree {
+    /// Points of the route. The first point is the source of the net.
+    std::vector<QPoint> points;
+    /// Index of the point from which each point is connected, or -1 for the source
+    std::vector<int> parents;
+    /// Index within @p points of each sink of the net, or -1 if the sink could not be connected
+    std::vector<int> sinks;
+
+    bool empty() const { return points.empty(); }
+};
+
+/**
+ * @brief The GridRouter class
+ * Orthogonal maze router on the component grid. Each net is routed as a tree by A* searches from the partially routed
+ * tree to each of its sinks, penalizing bends and crossings with other nets. Nets initially are routed concurrently
+ * and independently of each other, after which overlapping nets negotiate for the contested grid points, PathFinder
+ * style: nets which share a grid point along the same axis are ripped up and rerouted, with the cost of contested grid
+ * points increasing each iteration until no grid points are shared.
+ *
+ * Nets may provide their previous route, which is kept as-is if it is still valid (its terminals have not moved and it
+ * does not intersect any obstacles), such that moving a single component only reroutes the nets connected to it or
+ * crossing it.
+ *
+ * The router does not depend on any graphics objects, and a router may be run on any thread.
+ */
+class GridRouter {
+public:
+    enum class Axis { Horizontal, Vertical };
+
+    struct Terminal {
+        QPoint pos;
+        /// Axis along which the route should leave (sources) or enter (sinks) the terminal
+        Axis axis = Axis::Horizontal;
+    };
+
+    struct Net {
+        Terminal source;
+        std::vector<Terminal> sinks;
+        /// Route of the net as of the previous routing, if any. Kept if still valid.
+        const RouteTree* previous = nullptr;
+    };
+
+    struct Parameters {
+        /// Cost of changing direction, in units of the cost of an uncongested grid step
+        float bendCost = 4;
+        /// Cost of crossing another net
+        float crossingCost = 2;
+        /// Cost increase of a contested grid point for each iteration in which it is contested
+        float historyCost = 1;
+        /// Maximum number of negotiation iterations
+        unsigned maxIterations = 16;
+        /// Number of threads used for the initial routing of nets; 0 for the number of hardware threads
+        unsigned threads = 0;
+    };
+
+    struct Statistics {
+        unsigned iterations = 0;
+        /// Number of nets for which the previous route was kept
+        unsigned reused = 0;
+        /// Number of grid points which remain contested after routing
+        unsigned contested = 0;
+        /// Number of sinks for which no route was found; these are connected directly to their source. Sinks outside
+        /// of the routing bounds are not connected, and have no point within their route.
+        unsigned unroutable = 0;
+    };
+
+    /// Routes within @p bounds, in grid coordinates. Grid points on the edges of @p bounds may be routed through.
+    explicit GridRouter(const QRect& bounds);
+
+    /// Prohibits routing through the grid points of @p rect, including its edges.
+    void addObstacle(const QRect& rect);
+
+    Parameters& parameters() { return m_parameters; }
+    const Statistics& statistics() const { return m_statistics; }
+
+    /**
+     * @brief route
+     * @returns the route of each of @p nets, in the order of @p nets.
+     */
+    std::vector<RouteTree> route(const std::vector<Net>& nets);
+
+    /// @returns whether the route of net @p net was kept from its previous route, during the last call to route().
+    bool wasReused(size_t net) const { return m_reused.at(net); }
+
+private:
+    struct Scratch;
+    /// Grid-level route of a net. Each grid point of the route is a node of the tree.
+    struct CellTree {
+        std::vector<int> cells;
+        std::vector<int> parents;
+        std::vector<int> sinks;
+        /// Channels (cell * 2 + axis) used by the route
+        std::vector<int> channels;
+        /// Number of sinks which are connected directly to the source
+        unsigned unroutable = 0;
+    };
+
+    int cellOf(const QPoint& p) const { return (p.y() - m_bounds.top()) * m_width + (p.x() - m_bounds.left()); }
+    QPoint pointOf(int cell) const { return {m_bounds.left() + cell % m_width, m_bounds.top() + cell / m_width}; }
+    bool contains(const QPoint& p) const;
+
+    bool reusePrevious(const Net& net, int netIdx, CellTree& tree) const;
+    void routeNet(const Net& net, float presentCost, Scratch& scratch, CellTree& tree);
+    bool routeSink(const Net& net, int sink, float presentCost, Scratch& scratch, CellTree& tree) const;
+    void computeChannels(CellTree& tree) const;
+    void commit(const CellTree& tree, int delta);
+    bool isContested(const CellTree& tree) const;
+    RouteTree compress(const CellTree& tree) const;
+
+    QRect m_bounds;
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<bool> m_obstacles;
+    /// Index of the net owning each terminal grid point, or -1
+    std::vector<int> m_terminals;
+    /// Number of nets using each channel (cell * 2 + axis)
+    std::vector<uint16_t> m_occupancy;
+    /// Negotiated cost of each channel
+    std::vector<float> m_history;
+
+    Parameters m_parameters;
+    Statistics m_statistics;
+    std::vector<bool> m_reused;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_ROUTER_H
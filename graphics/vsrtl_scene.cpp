@@ -35,7 +35,7 @@ VSRTLScene::VSRTLScene(QObject* parent) : QGraphicsScene(parent) {
         // Background
         this->setBackgroundBrush(m_darkmode ? QBrush(QColorConstants::DarkGray.darker(300)) : Qt::NoBrush);
 
-        this->update();
+        invalidateItemCaches();
     });
 }
 
@@ -118,6 +118,17 @@ void VSRTLScene::setLocked(bool lock) {
         if (auto* gb = dynamic_cast<GraphicsBase*>(i))
             gb->setLocked(lock);
     }
+    invalidateItemCaches();
+}
+
+void VSRTLScene::invalidateItemCaches() {
+    const auto sceneItems = items();
+    for (auto* item : qAsConst(sceneItems)) {
+        if (item->cacheMode() != QGraphicsItem::NoCache) {
+            item->update();
+        }
+    }
+    update();
 }
 
 void VSRTLScene::setPortValuesVisibleForType(vsrtl::SimPort::PortType t, bool visible) {
@@ -197,10 +208,7 @@ void VSRTLScene::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
         auto* showGridAction = drawMenu->addAction("Show grid");
         showGridAction->setCheckable(true);
         showGridAction->setChecked(m_showGrid);
-        connect(showGridAction, &QAction::toggled, [=](bool checked) {
-            m_showGrid = checked;
-            this->update();
-        });
+        connect(showGridAction, &QAction::toggled, this, &VSRTLScene::setGridVisible);
 
         drawMenu->addAction(m_darkmodeAction);
     }
@@ -212,6 +220,11 @@ void VSRTLScene::setDarkmode(bool enabled) {
     m_darkmodeAction->setChecked(enabled);
 }
 
+void VSRTLScene::setGridVisible(bool visible) {
+    m_showGrid = visible;
+    update();
+}
+
 void VSRTLScene::setPortWidthsVisible(bool visible) {
     execOnItems<PortGraphic>(&PortGraphic::setPortWidthVisible, visible);
 }
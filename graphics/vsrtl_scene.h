@@ -36,6 +36,15 @@ public:
     bool isLocked() const { return m_isLocked; }
     bool darkmode() const { return m_darkmode; }
     void setDarkmode(bool enabled);
+    bool gridVisible() const { return m_showGrid; }
+    void setGridVisible(bool visible);
+
+    /**
+     * @brief invalidateItemCaches
+     * Redraws all items of the scene, including items which are drawn from a cache (see QGraphicsItem::cacheMode()).
+     * Required whenever the appearance of items changes without them scheduling a redraw of themselves.
+     */
+    void invalidateItemCaches();
 
 private:
     void handleSelectionChanged();
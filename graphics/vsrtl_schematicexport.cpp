@@ -0,0 +1,264 @@
+#include "vsrtl_schematicexport.h"
+#include "vsrtl_scene.h"
+
+#include <QDir>
+#include <QGraphicsItem>
+#include <QImage>
+#include <QPainter>
+#include <QPicture>
+#include <QSvgGenerator>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace vsrtl {
+
+namespace {
+
+int ceilDiv(int a, int b) {
+    return (a + b - 1) / b;
+}
+
+/**
+ * @brief The ExportState class
+ * Prepares a scene for being exported for the lifetime of the object. The grid is hidden, and cached items are drawn
+ * uncached, such that vector output contains the drawing commands of items rather than pixmaps of them.
+ */
+class ExportState {
+public:
+    explicit ExportState(VSRTLScene* scene) : m_scene(scene), m_gridVisible(scene->gridVisible()) {
+        m_scene->setGridVisible(false);
+        const auto sceneItems = m_scene->items();
+        for (auto* item : sceneItems) {
+            if (item->cacheMode() != QGraphicsItem::NoCache) {
+                m_cacheModes[item] = item->cacheMode();
+                item->setCacheMode(QGraphicsItem::NoCache);
+            }
+        }
+    }
+    ~ExportState() {
+        for (const auto& [item, mode] : m_cacheModes) {
+            item->setCacheMode(mode);
+        }
+        m_scene->setGridVisible(m_gridVisible);
+    }
+
+    QColor background() const {
+        const QBrush brush = m_scene->backgroundBrush();
+        return brush.style() == Qt::NoBrush ? QColor(Qt::white) : brush.color();
+    }
+
+private:
+    VSRTLScene* m_scene;
+    bool m_gridVisible;
+    std::map<QGraphicsItem*, QGraphicsItem::CacheMode> m_cacheModes;
+};
+
+constexpr QPainter::RenderHints ExportRenderHints = QPainter::Antialiasing | QPainter::TextAntialiasing;
+
+/// Collects the first failure of a set of worker threads.
+class Failure {
+public:
+    void set(const QString& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_path.isEmpty()) {
+            m_path = path;
+        }
+    }
+    void throwIfSet() const {
+        if (!m_path.isEmpty()) {
+            throw std::runtime_error("Could not write '" + m_path.toStdString() + "'");
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    QString m_path;
+};
+
+}  // namespace
+
+TileGrid::TileGrid(const QSize& size, int tileSize) : m_size(size), m_tileSize(tileSize) {
+    if (tileSize <= 0) {
+        throw std::runtime_error("Tile size must be positive");
+    }
+    const int tiles = std::max(ceilDiv(m_size.width(), tileSize), ceilDiv(m_size.height(), tileSize));
+    m_levels = 1;
+    while ((1 << (m_levels - 1)) < tiles) {
+        m_levels++;
+    }
+}
+
+QSize TileGrid::tiles(int level) const {
+    const int divisor = m_tileSize << (m_levels - 1 - level);
+    return QSize(std::max(ceilDiv(m_size.width(), divisor), 1), std::max(ceilDiv(m_size.height(), divisor), 1));
+}
+
+SchematicExporter::SchematicExporter(VSRTLScene* scene, const QRectF& source) : m_scene(scene), m_source(source) {}
+
+void SchematicExporter::exportSvg(const QString& path, const QString& title) const {
+    ExportState state(m_scene);
+    const QRectF target(QPointF(), m_source.size());
+
+    QSvgGenerator generator;
+    generator.setFileName(path);
+    generator.setSize(m_source.size().toSize());
+    generator.setViewBox(target);
+    generator.setTitle(title);
+
+    QPainter painter;
+    if (!painter.begin(&generator)) {
+        throw std::runtime_error("Could not write '" + path.toStdString() + "'");
+    }
+    painter.setRenderHints(ExportRenderHints);
+    painter.fillRect(target, state.background());
+    m_scene->render(&painter, target, m_source);
+    painter.end();
+}
+
+void SchematicExporter::exportPng(const QString& path, qreal scale) const {
+    const QSize size(std::ceil(m_source.width() * scale), std::ceil(m_source.height() * scale));
+    if (size.width() > MaxImageDimension || size.height() > MaxImageDimension) {
+        throw std::runtime_error("Image of " + std::to_string(size.width()) + "x" + std::to_string(size.height()) +
+                                 " pixels is too large; export as tiles instead");
+    }
+
+    ExportState state(m_scene);
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(state.background());
+    QPainter painter(&image);
+    painter.setRenderHints(ExportRenderHints);
+    m_scene->render(&painter, QRectF(QPointF(), m_source.size() * scale), m_source);
+    painter.end();
+
+    if (!image.save(path, "PNG")) {
+        throw std::runtime_error("Could not write '" + path.toStdString() + "'");
+    }
+}
+
+SchematicExporter::TileResult SchematicExporter::exportTiles(const QString& directory,
+                                                             const TileOptions& options) const {
+    ExportState state(m_scene);
+    const QColor background = state.background();
+    const int T = options.tileSize;
+
+    TileResult result;
+    result.size = QSize(std::ceil(m_source.width() * options.scale), std::ceil(m_source.height() * options.scale));
+    const TileGrid grid(result.size, T);
+    result.levels = grid.levels();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(options.threads > 0 ? options.threads : QThread::idealThreadCount());
+    Failure failure;
+    std::atomic<size_t> written = 0;
+
+    auto tilePath = [&](int level, int column, int row) {
+        return QString("%1/%2/%3/%4.png").arg(directory).arg(level).arg(column).arg(row);
+    };
+    auto makeLevelDirectories = [&](int level) {
+        for (int column = 0; column < grid.tiles(level).width(); ++column) {
+            QDir().mkpath(QString("%1/%2/%3").arg(directory).arg(level).arg(column));
+        }
+    };
+    auto save = [&](const QImage& image, const QString& path) {
+        if (image.save(path, "PNG")) {
+            written++;
+        } else {
+            failure.set(path);
+        }
+    };
+
+    // Full resolution level. Recording a tile only visits the items intersecting it, whereas rasterizing it is the
+    // expensive part, which is done on the thread pool. The next batch of tiles is recorded while the current batch is
+    // being rasterized.
+    struct Tile {
+        int column, row;
+        QPicture picture;
+    };
+    const int fullLevel = grid.levels() - 1;
+    const QSize tiles = grid.tiles(fullLevel);
+    const QRectF clip(QPointF(), m_source.size() * options.scale);
+    makeLevelDirectories(fullLevel);
+
+    auto record = [&](int index) {
+        Tile tile{index % tiles.width(), index / tiles.width(), QPicture()};
+        const QPointF offset(tile.column * T, tile.row * T);
+        const QRectF source(m_source.topLeft() + offset / options.scale, QSizeF(T, T) / options.scale);
+        QPainter painter(&tile.picture);
+        painter.setRenderHints(ExportRenderHints);
+        // Items beyond the exported region must not be drawn in the padding of edge tiles
+        painter.setClipRect(clip.translated(-offset));
+        m_scene->render(&painter, QRectF(0, 0, T, T), source, Qt::IgnoreAspectRatio);
+        painter.end();
+        return tile;
+    };
+    auto rasterize = [&](const Tile& tile) {
+        QImage image(T, T, QImage::Format_ARGB32_Premultiplied);
+        image.fill(background);
+        QPainter painter(&image);
+        painter.setRenderHints(ExportRenderHints);
+        painter.drawPicture(0, 0, tile.picture);
+        painter.end();
+        save(image, tilePath(fullLevel, tile.column, tile.row));
+    };
+
+    const int count = tiles.width() * tiles.height();
+    const int batchSize = 4 * pool.maxThreadCount();
+    std::vector<Tile> batches[2];
+    QFuture<void> pending;
+    for (int first = 0, b = 0; first < count; first += batchSize, b ^= 1) {
+        // The batch recorded into was last rasterized two batches ago, which has finished by now
+        auto& batch = batches[b];
+        batch.clear();
+        for (int i = first; i < std::min(first + batchSize, count); ++i) {
+            batch.push_back(record(i));
+        }
+        pending.waitForFinished();
+        pending = QtConcurrent::map(&pool, batch, rasterize);
+    }
+    pending.waitForFinished();
+    failure.throwIfSet();
+
+    // Pyramid levels, each downscaled from the 2x2 tiles below it
+    for (int level = fullLevel - 1; options.pyramid && level >= 0; --level) {
+        const QSize levelTiles = grid.tiles(level);
+        const QSize childTiles = grid.tiles(level + 1);
+        makeLevelDirectories(level);
+
+        std::vector<QPoint> positions;
+        for (int column = 0; column < levelTiles.width(); ++column) {
+            for (int row = 0; row < levelTiles.height(); ++row) {
+                positions.push_back(QPoint(column, row));
+            }
+        }
+        QtConcurrent::blockingMap(&pool, positions, [&](const QPoint& position) {
+            QImage image(T, T, QImage::Format_ARGB32_Premultiplied);
+            image.fill(background);
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::SmoothPixmapTransform);
+            for (int dx = 0; dx < 2; ++dx) {
+                for (int dy = 0; dy < 2; ++dy) {
+                    const int column = 2 * position.x() + dx;
+                    const int row = 2 * position.y() + dy;
+                    if (column < childTiles.width() && row < childTiles.height()) {
+                        painter.drawImage(QRectF(dx * T / 2.0, dy * T / 2.0, T / 2.0, T / 2.0),
+                                          QImage(tilePath(level + 1, column, row)));
+                    }
+                }
+            }
+            painter.end();
+            save(image, tilePath(level, position.x(), position.y()));
+        });
+        failure.throwIfSet();
+    }
+
+    result.tiles = written;
+    return result;
+}
+
+}  // namespace vsrtl
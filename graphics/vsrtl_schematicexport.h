@@ -0,0 +1,93 @@
+#ifndef VSRTL_SCHEMATICEXPORT_H
+#define VSRTL_SCHEMATICEXPORT_H
+
+#include <QRectF>
+#include <QSize>
+#include <QString>
+
+namespace vsrtl {
+
+class VSRTLScene;
+
+/**
+ * @brief The TileGrid struct
+ * Tiling of an image of a given size into square tiles, alongside a pyramid of levels wherein each level halves the
+ * resolution of the level below it. Levels are numbered as by XYZ-tiled web viewers; level 0 is a single tile, and the
+ * full resolution image is at level levels() - 1.
+ */
+struct TileGrid {
+    TileGrid(const QSize& size, int tileSize);
+
+    int levels() const { return m_levels; }
+    int tileSize() const { return m_tileSize; }
+    /// Number of columns and rows of tiles at @p level.
+    QSize tiles(int level) const;
+
+private:
+    QSize m_size;
+    int m_tileSize;
+    int m_levels;
+};
+
+/**
+ * @brief The SchematicExporter class
+ * Renders a region of a scene to SVG or PNG images, without requiring the scene to be shown in a view. Items are drawn
+ * uncached and at full level of detail, and the grid of the scene is not drawn.
+ *
+ * Large schematics are exported as tiles. The drawing commands of each tile are recorded from the scene on the calling
+ * thread, which must be the thread of the scene, and tiles are then rasterized and written by worker threads.
+ */
+class SchematicExporter {
+public:
+    struct TileOptions {
+        int tileSize = 256;
+        /// Pixels per scene unit at full resolution
+        qreal scale = 1.0;
+        /// Whether to write all levels of the tile pyramid (see TileGrid), or only the full resolution level
+        bool pyramid = false;
+        /// Number of worker threads; 0 for QThread::idealThreadCount()
+        int threads = 0;
+    };
+
+    struct TileResult {
+        /// Size of the full resolution image, in pixels
+        QSize size;
+        int levels = 0;
+        size_t tiles = 0;
+    };
+
+    SchematicExporter(VSRTLScene* scene, const QRectF& source);
+
+    /**
+     * @brief exportSvg
+     * Writes the region as an SVG document of one pixel per scene unit to @p path.
+     * @throws std::runtime_error if @p path could not be written.
+     */
+    void exportSvg(const QString& path, const QString& title) const;
+
+    /**
+     * @brief exportPng
+     * Writes the region as a single PNG image to @p path, scaled by @p scale pixels per scene unit.
+     * @throws std::runtime_error if the image would exceed MaxImageDimension pixels in width or height, or if @p path
+     * could not be written.
+     */
+    void exportPng(const QString& path, qreal scale) const;
+
+    /**
+     * @brief exportTiles
+     * Writes the region as PNG tiles to @p directory, as @p directory/<level>/<column>/<row>.png. Tiles at the edges of
+     * the region are padded with the background of the scene.
+     * @throws std::runtime_error if a tile could not be written.
+     */
+    TileResult exportTiles(const QString& directory, const TileOptions& options) const;
+
+    static constexpr int MaxImageDimension = 16384;
+
+private:
+    VSRTLScene* m_scene;
+    QRectF m_source;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_SCHEMATICEXPORT_H
@@ -56,6 +56,7 @@ NetlistTreeItem::NetlistTreeItem(TreeItem* parent) : TreeItem(parent) {}
 void NetlistTreeItem::setPort(SimPort* port) {
     Q_ASSERT(port);
     m_port = port;
+    m_value = m_port->observedValue();
     m_name = QString::fromStdString(m_port->getName());
     m_radixMenu = createPortRadixMenu(m_port, m_radix);
 
@@ -77,6 +78,8 @@ QVariant NetlistTreeItem::data(int column, int role) const {
     if (column == NetlistModel::IOColumn && role == Qt::DecorationRole && m_port != nullptr) {
         return m_direction == PortDirection::Input ? QIcon(":/vsrtl_icons/input.svg")
                                                    : QIcon(":/vsrtl_icons/output.svg");
+    } else if (column == NetlistModel::ProfileColumn && m_component != nullptr) {
+        return profileData(role);
     } else if (role == Qt::DisplayRole || role == Qt::EditRole) {
         switch (column) {
             case NetlistModel::ComponentColumn: {
@@ -84,7 +87,7 @@ QVariant NetlistTreeItem::data(int column, int role) const {
             }
             case NetlistModel::ValueColumn: {
                 if (m_port) {
-                    return encodePortRadixValue(m_port, m_radix);
+                    return valueText();
                 }
                 break;
             }
@@ -98,6 +101,43 @@ QVariant NetlistTreeItem::data(int column, int role) const {
     }
     return QVariant();
 }
+QVariant NetlistTreeItem::profileData(int role) const {
+    const auto* profiler = m_component->getDesign()->observedProfiler();
+    const auto* profile = profiler ? profiler->component(m_component) : nullptr;
+    if (!profile) {
+        return QVariant();
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return QString::number(100.0 * profiler->share(m_component), 'f', 2) + " %";
+        case Qt::ToolTipRole: {
+            const double usPerTick = 1e6 / profiler->ticksPerSecond();
+            return QString("Total: %1 us\nSelf: %2 us\nClocked: %3 us\nPort evaluations: %4")
+                .arg(profile->total * usPerTick, 0, 'f', 1)
+                .arg(profile->self() * usPerTick, 0, 'f', 1)
+                .arg((profile->save + profile->reverse) * usPerTick, 0, 'f', 1)
+                .arg(profile->evaluations);
+        }
+        case Qt::TextAlignmentRole:
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    return QVariant();
+}
+
+bool NetlistTreeItem::updateValue() {
+    if (m_port) {
+        const VSRTL_VT_U value = m_port->observedValue();
+        if (value == m_value) {
+            return false;
+        }
+        m_value = value;
+        return true;
+    }
+    // Profiling data of components may change regardless of port values
+    return m_component && m_component->getDesign()->observedProfiler();
+}
+
 bool NetlistTreeItem::setData(int, const QVariant&, int) {
     return false;
 }
@@ -38,6 +38,9 @@ public:
     QString m_name;
     QList<TreeItem*> childItems;
     TreeItem* parentItem;
+    /// Whether the children of this item have been created. Models create the children of an item once it is first
+    /// expanded in a view (see NetlistModelBase::fetchMore()).
+    bool m_populated = true;
 
 private:
 };
@@ -51,12 +54,27 @@ public:
     bool setData(int column, const QVariant& value, int role = Qt::EditRole) override;
     virtual QList<QMenu*> getActions() const;
     void setPort(SimPort* port);
+    QVariant profileData(int role) const;
+    /**
+     * @brief updateValue
+     * Registers the current value of the port of this item.
+     * @returns whether the data of the item changed since the previous call, ie. whether the port changed value.
+     */
+    bool updateValue();
 
     SimComponent* m_component = nullptr;
     SimPort* m_port = nullptr;
     PortDirection m_direction = PortDirection::Input;
     QMenu* m_radixMenu = nullptr;
     Radix m_radix = Radix::Hex;
+    VSRTL_VT_U m_value = 0;
+
+protected:
+    /// Text of the value column, re-encoded once the port value or radix changes
+    const QString& valueText() const { return m_valueText.get(m_port, m_radix); }
+
+private:
+    mutable PortValueText m_valueText;
 };
 
 }  // namespace vsrtl
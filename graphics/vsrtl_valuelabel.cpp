@@ -36,6 +36,7 @@ void ValueLabel::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
     }
     painter->restore();
 
+    // Below LOD_TEXT, only the label box is drawn
     Label::paint(painter, option, w);
 }
 
@@ -115,8 +116,11 @@ void ValueLabel::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
 }
 
 void ValueLabel::updateText() {
-    setPlainText(encodePortRadixValue(m_port->getPort(), *m_radix));
-    applyFormatChanges();
+    // Relayouting the text document is expensive, and is skipped if the text is unchanged
+    if (m_valueText.update(m_port->getPort(), *m_radix)) {
+        setPlainText(m_valueText.text());
+        applyFormatChanges();
+    }
 }
 
 }  // namespace vsrtl
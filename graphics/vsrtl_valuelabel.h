@@ -32,6 +32,7 @@ private:
     void updateLine();
 
     std::shared_ptr<Radix> m_radix;
+    PortValueText m_valueText;
     const PortGraphic* m_port = nullptr;
     QGraphicsLineItem* m_lineToPort = nullptr;
     std::unique_ptr<QAction> m_showLineToPortAction;
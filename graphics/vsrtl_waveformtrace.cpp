@@ -0,0 +1,211 @@
+#include "vsrtl_waveformtrace.h"
+
+#include <algorithm>
+
+namespace vsrtl {
+
+WaveformTrace::WaveformTrace(SimPort* port) : m_port(port) {}
+
+void WaveformTrace::clear() {
+    m_changes.clear();
+    m_levels.clear();
+    m_firstCycle = 0;
+    m_lastCycle = 0;
+}
+
+void WaveformTrace::append(uint64_t cycle, VSRTL_VT_U value) {
+    if (m_changes.empty()) {
+        m_firstCycle = cycle;
+        m_lastCycle = cycle;
+        m_changes.push_back({cycle, value});
+        updatePyramid(cycle, value, false);
+        return;
+    }
+
+    if (cycle <= m_lastCycle) {
+        return;
+    }
+
+    const bool changed = m_changes.back().value != value;
+    // Pyramid must be updated before the change is recorded; gaps in the sampled cycles are filled with the previous
+    // value.
+    updatePyramid(cycle, value, changed);
+    if (changed) {
+        m_changes.push_back({cycle, value});
+    }
+    m_lastCycle = cycle;
+}
+
+void WaveformTrace::updatePyramid(uint64_t cycle, VSRTL_VT_U value, bool changed) {
+    const uint64_t rel = cycle - m_firstCycle;
+    const VSRTL_VT_U prev = m_changes.back().value;
+
+    for (unsigned level = 0;; ++level) {
+        if (level == m_levels.size()) {
+            if (level != 0) {
+                // A new level is only created once the level below spans more than a single bucket. The new level is
+                // built in its entirety from the level below, which already includes the current sample.
+                const auto& below = m_levels[level - 1];
+                if (below.size() <= 1) {
+                    break;
+                }
+                std::vector<Bucket> buckets;
+                buckets.reserve(below.size() / 2 + 1);
+                for (size_t i = 0; i < below.size(); i += 2) {
+                    Bucket b = below[i];
+                    if (i + 1 < below.size()) {
+                        b.merge(below[i + 1]);
+                    }
+                    buckets.push_back(b);
+                }
+                m_levels.push_back(std::move(buckets));
+                if (m_levels.back().size() <= 1) {
+                    break;
+                }
+                continue;
+            }
+            m_levels.emplace_back();
+        }
+
+        auto& buckets = m_levels[level];
+        const uint64_t index = rel >> (level + BaseBucketShift);
+        while (buckets.size() < index) {
+            buckets.push_back({prev, prev, 0});
+        }
+        const Bucket sample = {value, value, changed ? 1u : 0u};
+        if (buckets.size() == index) {
+            buckets.push_back(sample);
+            if ((rel & (bucketSpan(level) - 1)) != 0) {
+                // Sampling skipped the start of this bucket, wherein the previous value was held
+                buckets.back().merge({prev, prev, 0});
+            }
+        } else {
+            buckets.back().merge(sample);
+        }
+
+        if (buckets.size() <= 1) {
+            break;
+        }
+    }
+}
+
+void WaveformTrace::truncate(uint64_t cycle) {
+    if (m_changes.empty() || cycle >= m_lastCycle) {
+        return;
+    }
+    if (cycle < m_firstCycle) {
+        clear();
+        return;
+    }
+
+    auto it = std::upper_bound(m_changes.begin(), m_changes.end(), cycle,
+                               [](uint64_t c, const Change& change) { return c < change.cycle; });
+    m_changes.erase(it, m_changes.end());
+    m_lastCycle = cycle;
+
+    const uint64_t rel = cycle - m_firstCycle;
+    for (unsigned level = 0; level < m_levels.size(); ++level) {
+        const uint64_t index = rel >> (level + BaseBucketShift);
+        auto& buckets = m_levels[level];
+        buckets.resize(std::min<uint64_t>(buckets.size(), index + 1));
+        buckets.back() = rebuildBucket(level, index);
+        if (buckets.size() <= 1) {
+            // Higher levels would only contain a single copy of this bucket
+            m_levels.resize(level + 1);
+            break;
+        }
+    }
+}
+
+WaveformTrace::Bucket WaveformTrace::rebuildBucket(unsigned level, uint64_t index) const {
+    if (level == 0) {
+        const uint64_t from = m_firstCycle + index * bucketSpan(0);
+        return summarizeExact(from, std::min(from + bucketSpan(0), m_lastCycle + 1));
+    }
+
+    const auto& below = m_levels[level - 1];
+    Bucket b = below[index * 2];
+    if (index * 2 + 1 < below.size()) {
+        b.merge(below[index * 2 + 1]);
+    }
+    return b;
+}
+
+size_t WaveformTrace::changeIndexAt(uint64_t cycle) const {
+    auto it = std::upper_bound(m_changes.begin(), m_changes.end(), cycle,
+                               [](uint64_t c, const Change& change) { return c < change.cycle; });
+    if (it == m_changes.begin()) {
+        return 0;
+    }
+    return std::distance(m_changes.begin(), it) - 1;
+}
+
+VSRTL_VT_U WaveformTrace::valueAt(uint64_t cycle) const {
+    if (m_changes.empty()) {
+        return 0;
+    }
+    return m_changes[changeIndexAt(cycle)].value;
+}
+
+WaveformTrace::Bucket WaveformTrace::summarizeExact(uint64_t from, uint64_t to) const {
+    size_t i = changeIndexAt(from);
+    const VSRTL_VT_U v = m_changes[i].value;
+    // The first recorded change is the initial value of the trace, and does not count as a value change.
+    Bucket b = {v, v, (m_changes[i].cycle == from && i != 0) ? 1u : 0u};
+    for (++i; i < m_changes.size() && m_changes[i].cycle < to; ++i) {
+        b.merge({m_changes[i].value, m_changes[i].value, 1});
+    }
+    return b;
+}
+
+WaveformTrace::Bucket WaveformTrace::summarize(uint64_t from, uint64_t to) const {
+    if (m_changes.empty()) {
+        return {0, 0, 0};
+    }
+
+    from = std::max(from, m_firstCycle);
+    to = std::min(to, m_lastCycle + 1);
+    if (from >= to) {
+        const VSRTL_VT_U v = valueAt(from);
+        return {v, v, 0};
+    }
+
+    Bucket result = {0, 0, 0};
+    bool hasResult = false;
+    auto mergeResult = [&](const Bucket& b) {
+        if (hasResult) {
+            result.merge(b);
+        } else {
+            result = b;
+            hasResult = true;
+        }
+    };
+
+    uint64_t cur = from;
+    while (cur < to) {
+        const uint64_t rel = cur - m_firstCycle;
+        bool consumed = false;
+        // Use the largest bucket which is aligned with the current position and fits within the remaining range
+        for (int level = static_cast<int>(m_levels.size()) - 1; level >= 0; --level) {
+            const uint64_t span = bucketSpan(level);
+            const uint64_t index = rel >> (level + BaseBucketShift);
+            if (rel % span == 0 && cur + span <= to && index < m_levels[level].size()) {
+                mergeResult(m_levels[level][index]);
+                cur += span;
+                consumed = true;
+                break;
+            }
+        }
+
+        if (!consumed) {
+            // Unaligned edge of the range; walk the change list up until the next level 0 bucket boundary.
+            const uint64_t boundary = m_firstCycle + ((rel >> BaseBucketShift) + 1) * bucketSpan(0);
+            const uint64_t end = std::min(to, boundary);
+            mergeResult(summarizeExact(cur, end));
+            cur = end;
+        }
+    }
+    return result;
+}
+
+}  // namespace vsrtl
@@ -0,0 +1,102 @@
+#ifndef VSRTL_WAVEFORMTRACE_H
+#define VSRTL_WAVEFORMTRACE_H
+
+#include "../interface/vsrtl_defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vsrtl {
+
+class SimPort;
+
+/**
+ * @brief The WaveformTrace class
+ * Records the value history of a single port. Only value changes are stored, alongside a pyramid of summary buckets.
+ * Bucket level 0 spans 2^BaseBucketShift cycles, and each subsequent level spans twice the cycles of the level below.
+ * Each bucket records the minimum and maximum value seen within its span as well as the number of value changes.
+ * A view can thereby select the level whose bucket span is closest to the number of cycles per pixel, making the cost
+ * of rendering a trace proportional to the number of pixels rather than the number of recorded cycles.
+ */
+class WaveformTrace {
+public:
+    static constexpr unsigned BaseBucketShift = 4;
+
+    struct Change {
+        uint64_t cycle;
+        VSRTL_VT_U value;
+    };
+
+    struct Bucket {
+        VSRTL_VT_U min;
+        VSRTL_VT_U max;
+        uint64_t changes;
+
+        void merge(const Bucket& other) {
+            min = other.min < min ? other.min : min;
+            max = other.max > max ? other.max : max;
+            changes += other.changes;
+        }
+    };
+
+    explicit WaveformTrace(SimPort* port);
+
+    /**
+     * @brief append
+     * Records @p value as the value of the port at @p cycle. Cycles must be appended in monotonically increasing
+     * order; a cycle which has already been recorded is ignored.
+     */
+    void append(uint64_t cycle, VSRTL_VT_U value);
+
+    /**
+     * @brief truncate
+     * Discards all samples recorded after @p cycle. Used when the design is reversed.
+     */
+    void truncate(uint64_t cycle);
+    void clear();
+
+    /**
+     * @brief summarize
+     * Returns a bucket summarizing the samples within [@p from, @p to). Selects the coarsest pyramid level at which
+     * the range may be covered by at most a few buckets, and only visits the change list for the (finer-grained)
+     * edges of the range.
+     */
+    Bucket summarize(uint64_t from, uint64_t to) const;
+
+    /**
+     * @brief valueAt
+     * @returns the recorded value at @p cycle. If @p cycle lies outside of the recorded range, the closest recorded
+     * value is returned.
+     */
+    VSRTL_VT_U valueAt(uint64_t cycle) const;
+
+    /**
+     * @brief changeIndexAt
+     * @returns the index of the last change which occurred at or before @p cycle.
+     */
+    size_t changeIndexAt(uint64_t cycle) const;
+
+    bool empty() const { return m_changes.empty(); }
+    uint64_t firstCycle() const { return m_firstCycle; }
+    /// Last cycle that has been recorded (inclusive)
+    uint64_t lastCycle() const { return m_lastCycle; }
+    const std::vector<Change>& changes() const { return m_changes; }
+    SimPort* getPort() const { return m_port; }
+
+private:
+    static uint64_t bucketSpan(unsigned level) { return uint64_t(1) << (level + BaseBucketShift); }
+    void updatePyramid(uint64_t cycle, VSRTL_VT_U value, bool changed);
+    Bucket rebuildBucket(unsigned level, uint64_t index) const;
+    Bucket summarizeExact(uint64_t from, uint64_t to) const;
+
+    SimPort* m_port = nullptr;
+    uint64_t m_firstCycle = 0;
+    uint64_t m_lastCycle = 0;
+    std::vector<Change> m_changes;
+    std::vector<std::vector<Bucket>> m_levels;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_WAVEFORMTRACE_H
@@ -0,0 +1,571 @@
+#include "vsrtl_waveformwidget.h"
+#include "vsrtl_graphics_defines.h"
+
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTimer>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace vsrtl {
+
+static constexpr int NameColumnWidth = 180;
+static constexpr int RulerHeight = 20;
+static constexpr int RowHeight = 28;
+static constexpr int TraceMargin = 6;
+static constexpr int TargetTickSpacing = 100;  // pixels
+static constexpr int RepaintInterval = 33;     // ms; ~30 Hz while sampling
+static constexpr qreal MinCyclesPerPixel = 1.0 / 64;
+
+WaveformWidget::WaveformWidget(QWidget* parent) : QWidget(parent) {
+    setMouseTracking(false);
+    setFocusPolicy(Qt::WheelFocus);
+
+    m_scrollBar = new QScrollBar(Qt::Horizontal, this);
+    connect(m_scrollBar, &QScrollBar::valueChanged, this, &WaveformWidget::handleScrollBarMoved);
+
+    m_repaintTimer = new QTimer(this);
+    m_repaintTimer->setInterval(RepaintInterval);
+    connect(m_repaintTimer, &QTimer::timeout, this, &WaveformWidget::handleRepaintTimeout);
+    m_repaintTimer->start();
+}
+
+WaveformWidget::~WaveformWidget() {
+    disconnectDesign();
+}
+
+QSize WaveformWidget::sizeHint() const {
+    return QSize(800, RulerHeight + RowHeight * 6 + m_scrollBar->sizeHint().height());
+}
+
+void WaveformWidget::disconnectDesign() {
+    if (m_design) {
+        m_design->designWasClocked.Disconnect(this, &WaveformWidget::sample);
+        m_design->designWasReversed.Disconnect(this, &WaveformWidget::handleDesignReversed);
+        m_design->designWasReset.Disconnect(this, &WaveformWidget::handleDesignReset);
+    }
+}
+
+void WaveformWidget::setDesign(SimDesign* design) {
+    disconnectDesign();
+    clearPorts();
+    m_design = design;
+    if (m_design) {
+        // Connected directly (not through a GallantSignalWrapper); samples must be taken in the context of the thread
+        // which clocks the design, before the design state moves on.
+        m_design->designWasClocked.Connect(this, &WaveformWidget::sample);
+        m_design->designWasReversed.Connect(this, &WaveformWidget::handleDesignReversed);
+        m_design->designWasReset.Connect(this, &WaveformWidget::handleDesignReset);
+    }
+}
+
+void WaveformWidget::addPort(SimPort* port) {
+    QMutexLocker lock(&m_traceMutex);
+    for (const auto& entry : m_traces) {
+        if (entry->trace.getPort() == port) {
+            return;
+        }
+    }
+    auto entry = std::make_unique<TraceEntry>(port);
+    if (port->isEnumPort()) {
+        entry->radix = Radix::Enum;
+    } else if (port->getWidth() == 1) {
+        entry->radix = Radix::Unsigned;
+    }
+    if (m_design) {
+        entry->trace.append(m_design->getCycleCount(), port->uValue());
+    }
+    m_traces.push_back(std::move(entry));
+    m_traceCount = m_traces.size();
+    m_dirty = true;
+}
+
+void WaveformWidget::removePort(SimPort* port) {
+    QMutexLocker lock(&m_traceMutex);
+    m_traces.erase(std::remove_if(m_traces.begin(), m_traces.end(),
+                                  [port](const auto& entry) { return entry->trace.getPort() == port; }),
+                   m_traces.end());
+    m_traceCount = m_traces.size();
+    m_dirty = true;
+}
+
+void WaveformWidget::clearPorts() {
+    QMutexLocker lock(&m_traceMutex);
+    m_traces.clear();
+    m_traceCount = 0;
+    m_dirty = true;
+}
+
+std::vector<SimPort*> WaveformWidget::ports() const {
+    QMutexLocker lock(&m_traceMutex);
+    std::vector<SimPort*> ports;
+    for (const auto& entry : m_traces) {
+        ports.push_back(entry->trace.getPort());
+    }
+    return ports;
+}
+
+void WaveformWidget::sample() {
+    if (m_traceCount == 0) {
+        return;
+    }
+    const uint64_t cycle = m_design->getCycleCount();
+    QMutexLocker lock(&m_traceMutex);
+    for (const auto& entry : m_traces) {
+        entry->trace.append(cycle, entry->trace.getPort()->uValue());
+    }
+    m_dirty = true;
+}
+
+void WaveformWidget::handleDesignReversed() {
+    const uint64_t cycle = m_design->getCycleCount();
+    QMutexLocker lock(&m_traceMutex);
+    for (const auto& entry : m_traces) {
+        entry->trace.truncate(cycle);
+    }
+    m_dirty = true;
+}
+
+void WaveformWidget::handleDesignReset() {
+    {
+        QMutexLocker lock(&m_traceMutex);
+        for (const auto& entry : m_traces) {
+            entry->trace.clear();
+        }
+    }
+    m_cursorCycle = -1;
+    sample();
+}
+
+void WaveformWidget::clearHistory() {
+    handleDesignReset();
+}
+
+void WaveformWidget::handleRepaintTimeout() {
+    if (m_dirty.exchange(false)) {
+        updateScrollBar();
+        update();
+    }
+}
+
+uint64_t WaveformWidget::firstCycle() const {
+    uint64_t first = ULLONG_MAX;
+    for (const auto& entry : m_traces) {
+        if (!entry->trace.empty()) {
+            first = std::min(first, entry->trace.firstCycle());
+        }
+    }
+    return first == ULLONG_MAX ? 0 : first;
+}
+
+uint64_t WaveformWidget::lastCycle() const {
+    uint64_t last = 0;
+    for (const auto& entry : m_traces) {
+        if (!entry->trace.empty()) {
+            last = std::max(last, entry->trace.lastCycle());
+        }
+    }
+    return last;
+}
+
+QRect WaveformWidget::plotRect() const {
+    return QRect(NameColumnWidth, RulerHeight, std::max(1, width() - NameColumnWidth),
+                 std::max(1, height() - RulerHeight - m_scrollBar->height()));
+}
+
+qreal WaveformWidget::cycleToX(qreal cycle) const {
+    return plotRect().left() + (cycle - m_startCycle) / m_cyclesPerPixel;
+}
+
+qreal WaveformWidget::xToCycle(qreal x) const {
+    return m_startCycle + (x - plotRect().left()) * m_cyclesPerPixel;
+}
+
+int WaveformWidget::traceIndexAt(const QPoint& pos) const {
+    if (pos.y() < RulerHeight) {
+        return -1;
+    }
+    const int index = (pos.y() - RulerHeight) / RowHeight;
+    return index < static_cast<int>(m_traces.size()) ? index : -1;
+}
+
+void WaveformWidget::setFollow(bool follow) {
+    m_follow = follow;
+    update();
+}
+
+void WaveformWidget::zoom(qreal factor, qreal anchorX) {
+    const qreal anchorCycle = xToCycle(anchorX);
+    uint64_t span;
+    {
+        QMutexLocker lock(&m_traceMutex);
+        span = lastCycle() - firstCycle() + 1;
+    }
+    const qreal maxCyclesPerPixel = std::max<qreal>(1.0, 2.0 * span / plotRect().width());
+    m_cyclesPerPixel = qBound(MinCyclesPerPixel, m_cyclesPerPixel * factor, maxCyclesPerPixel);
+    m_startCycle = std::max<qreal>(0, anchorCycle - (anchorX - plotRect().left()) * m_cyclesPerPixel);
+    updateScrollBar();
+    update();
+}
+
+void WaveformWidget::zoomIn() {
+    zoom(0.5, plotRect().center().x());
+}
+
+void WaveformWidget::zoomOut() {
+    zoom(2.0, plotRect().center().x());
+}
+
+void WaveformWidget::zoomToFit() {
+    {
+        QMutexLocker lock(&m_traceMutex);
+        const uint64_t first = firstCycle();
+        const uint64_t span = lastCycle() - first + 1;
+        m_cyclesPerPixel = std::max(MinCyclesPerPixel, static_cast<qreal>(span) / plotRect().width());
+        m_startCycle = first;
+    }
+    m_follow = false;
+    updateScrollBar();
+    update();
+}
+
+void WaveformWidget::updateScrollBar() {
+    uint64_t first, last;
+    {
+        QMutexLocker lock(&m_traceMutex);
+        first = firstCycle();
+        last = lastCycle();
+    }
+    const qreal visibleCycles = plotRect().width() * m_cyclesPerPixel;
+    const qreal maxStart = std::max<qreal>(first, last + 1 - visibleCycles);
+    if (m_follow) {
+        m_startCycle = maxStart;
+    }
+
+    m_scrollBar->blockSignals(true);
+    m_scrollBar->setRange(static_cast<int>(std::min<qreal>(first, INT_MAX)),
+                          static_cast<int>(std::min<qreal>(std::ceil(maxStart), INT_MAX)));
+    m_scrollBar->setPageStep(static_cast<int>(std::min<qreal>(std::max<qreal>(1, visibleCycles), INT_MAX)));
+    m_scrollBar->setValue(static_cast<int>(std::min<qreal>(m_startCycle, INT_MAX)));
+    m_scrollBar->blockSignals(false);
+}
+
+void WaveformWidget::handleScrollBarMoved(int value) {
+    m_startCycle = value;
+    m_follow = value >= m_scrollBar->maximum();
+    update();
+}
+
+void WaveformWidget::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    const int h = m_scrollBar->sizeHint().height();
+    m_scrollBar->setGeometry(NameColumnWidth, height() - h, std::max(1, width() - NameColumnWidth), h);
+    updateScrollBar();
+}
+
+void WaveformWidget::wheelEvent(QWheelEvent* event) {
+    const qreal steps = event->angleDelta().y() / 120.0;
+    if (event->modifiers() & Qt::ControlModifier) {
+        zoom(std::pow(0.8, steps), event->position().x());
+    } else {
+        m_startCycle = std::max<qreal>(0, m_startCycle - steps * plotRect().width() * m_cyclesPerPixel / 10);
+        m_follow = false;
+        updateScrollBar();
+        update();
+    }
+    event->accept();
+}
+
+void WaveformWidget::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && event->pos().x() >= NameColumnWidth) {
+        m_cursorCycle = std::max<long long>(0, std::llround(xToCycle(event->pos().x())));
+        update();
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void WaveformWidget::contextMenuEvent(QContextMenuEvent* event) {
+    QMenu menu;
+    std::unique_ptr<QMenu> radixMenu;
+    SimPort* port = nullptr;
+
+    const int index = traceIndexAt(event->pos());
+    if (index >= 0) {
+        auto& entry = *m_traces.at(index);
+        port = entry.trace.getPort();
+        radixMenu = std::unique_ptr<QMenu>(createPortRadixMenu(port, entry.radix));
+        menu.addMenu(radixMenu.get());
+        menu.addAction("Remove", [this, port] { removePort(port); });
+        menu.addSeparator();
+    }
+
+    menu.addAction("Zoom in", this, &WaveformWidget::zoomIn);
+    menu.addAction("Zoom out", this, &WaveformWidget::zoomOut);
+    menu.addAction("Zoom to fit", this, &WaveformWidget::zoomToFit);
+    QAction* followAction = menu.addAction("Follow");
+    followAction->setCheckable(true);
+    followAction->setChecked(m_follow);
+    connect(followAction, &QAction::toggled, this, &WaveformWidget::setFollow);
+    menu.addSeparator();
+    menu.addAction("Clear history", this, &WaveformWidget::clearHistory);
+    menu.addAction("Remove all", this, &WaveformWidget::clearPorts);
+
+    menu.exec(event->globalPos());
+
+    // Register any change in radix
+    update();
+}
+
+void WaveformWidget::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    const QRect plot = plotRect();
+
+    painter.fillRect(rect(), palette().window());
+    painter.fillRect(plot, BACKGROUND_COLOR);
+
+    // Only the visible part of each trace is copied while holding the lock, such that sampling on the simulation
+    // thread is not stalled while painting.
+    std::vector<VisibleTrace> visible;
+    uint64_t cursorCycle;
+    {
+        QMutexLocker lock(&m_traceMutex);
+        if (m_follow) {
+            m_startCycle = std::max<qreal>(firstCycle(), lastCycle() + 1 - plot.width() * m_cyclesPerPixel);
+        }
+        cursorCycle = m_cursorCycle < 0 ? lastCycle() : static_cast<uint64_t>(m_cursorCycle);
+        for (unsigned i = 0; i < m_traces.size(); ++i) {
+            const QRect rowRect(plot.left(), plot.top() + i * RowHeight, plot.width(), RowHeight);
+            if (rowRect.top() > plot.bottom()) {
+                break;
+            }
+            visible.push_back(captureTrace(*m_traces[i], rowRect, cursorCycle));
+        }
+    }
+
+    paintRuler(painter, QRect(plot.left(), 0, plot.width(), RulerHeight));
+
+    const QFontMetrics fm(font());
+    for (unsigned i = 0; i < visible.size(); ++i) {
+        const auto& trace = visible[i];
+        const QRect rowRect(plot.left(), plot.top() + i * RowHeight, plot.width(), RowHeight);
+
+        // Name column; port name and value at the cursor
+        const QRect nameRect(0, rowRect.top(), NameColumnWidth - 4, RowHeight);
+        const QString value =
+            trace.empty ? QString() : encodePortRadixValue(trace.port, trace.radix, trace.cursorValue);
+        const QString valueText = " = " + value;
+        const QString name = fm.elidedText(QString::fromStdString(trace.port->getHierName()), Qt::ElideLeft,
+                                           nameRect.width() - fm.horizontalAdvance(valueText));
+        painter.setPen(palette().text().color());
+        painter.drawText(nameRect, Qt::AlignVCenter | Qt::AlignRight, name + valueText);
+
+        painter.setPen(QPen(WIRE_DEFAULT_COLOR, 1));
+        painter.drawLine(rowRect.bottomLeft(), rowRect.bottomRight());
+
+        if (!trace.empty) {
+            painter.save();
+            painter.setClipRect(rowRect);
+            paintTrace(painter, trace, rowRect);
+            painter.restore();
+        }
+    }
+
+    // Cursor
+    const qreal cursorX = cycleToX(cursorCycle + 0.5);
+    if (m_cursorCycle >= 0 && cursorX >= plot.left() && cursorX <= plot.right()) {
+        painter.setPen(QPen(WIRE_SELECTED_COLOR, 1, Qt::DashLine));
+        painter.drawLine(QPointF(cursorX, plot.top()), QPointF(cursorX, plot.bottom()));
+    }
+}
+
+WaveformWidget::VisibleTrace WaveformWidget::captureTrace(const TraceEntry& entry, const QRect& rowRect,
+                                                          uint64_t cursorCycle) const {
+    const auto& trace = entry.trace;
+    VisibleTrace visible;
+    visible.port = trace.getPort();
+    visible.radix = entry.radix;
+    visible.empty = trace.empty();
+    if (visible.empty) {
+        return visible;
+    }
+    visible.cursorValue = trace.valueAt(cursorCycle);
+    visible.end = trace.lastCycle() + 1;
+
+    if (m_cyclesPerPixel <= 1.0) {
+        // The changes covering the visible cycles, including a change at the first cycle past the view
+        visible.from = std::max(trace.firstCycle(), static_cast<uint64_t>(std::max<qreal>(0, m_startCycle)));
+        visible.to = std::min(visible.end,
+                              static_cast<uint64_t>(std::max<qreal>(0, std::ceil(xToCycle(rowRect.right())))) + 1);
+        if (visible.from < visible.to) {
+            const auto& changes = trace.changes();
+            visible.changes.assign(changes.begin() + trace.changeIndexAt(visible.from),
+                                   changes.begin() + trace.changeIndexAt(visible.to) + 1);
+        }
+        return visible;
+    }
+
+    // One summary per pixel column covering recorded cycles
+    for (int px = 0; px < rowRect.width(); ++px) {
+        const qreal c0 = m_startCycle + px * m_cyclesPerPixel;
+        const qreal c1 = c0 + m_cyclesPerPixel;
+        if (c1 <= trace.firstCycle()) {
+            visible.firstColumn = px + 1;
+            continue;
+        }
+        if (c0 > trace.lastCycle()) {
+            break;
+        }
+        const uint64_t from = static_cast<uint64_t>(std::max<qreal>(0, std::floor(c0)));
+        const uint64_t to = std::max(from + 1, static_cast<uint64_t>(std::floor(c1)));
+        visible.columns.push_back(trace.summarize(from, to));
+    }
+    return visible;
+}
+
+void WaveformWidget::paintRuler(QPainter& painter, const QRect& rulerRect) const {
+    // Select a tick spacing of {1, 2, 5} * 10^n cycles, closest to TargetTickSpacing pixels.
+    const qreal target = TargetTickSpacing * m_cyclesPerPixel;
+    qreal magnitude = std::pow(10, std::floor(std::log10(std::max<qreal>(1, target))));
+    uint64_t tick = static_cast<uint64_t>(magnitude);
+    for (const int m : {1, 2, 5, 10}) {
+        tick = static_cast<uint64_t>(magnitude * m);
+        if (tick >= target) {
+            break;
+        }
+    }
+    tick = std::max<uint64_t>(1, tick);
+
+    painter.setPen(palette().text().color());
+    const uint64_t firstTick = static_cast<uint64_t>(std::ceil(std::max<qreal>(0, m_startCycle) / tick)) * tick;
+    const qreal endCycle = xToCycle(rulerRect.right());
+    for (uint64_t c = firstTick; c <= endCycle; c += tick) {
+        const qreal x = cycleToX(c);
+        painter.drawLine(QPointF(x, rulerRect.bottom() - 4), QPointF(x, rulerRect.bottom()));
+        painter.drawText(QPointF(x + 2, rulerRect.bottom() - 5), QString::number(c));
+    }
+}
+
+void WaveformWidget::paintTrace(QPainter& painter, const VisibleTrace& trace, const QRect& rowRect) const {
+    // When zoomed in beyond one cycle per pixel, the changes within the visible range are few enough to be drawn
+    // directly. Otherwise, the trace is drawn from pyramid summaries, one per pixel column.
+    if (m_cyclesPerPixel <= 1.0) {
+        paintExact(painter, trace, rowRect);
+    } else {
+        paintSummarized(painter, trace, rowRect);
+    }
+}
+
+void WaveformWidget::paintBusLabel(QPainter& painter, const VisibleTrace& trace, VSRTL_VT_U value, const QRect& rowRect,
+                                   qreal x0, qreal x1) const {
+    const qreal left = std::max<qreal>(x0, rowRect.left());
+    const qreal right = std::min<qreal>(x1, rowRect.right());
+    const QString text = encodePortRadixValue(trace.port, trace.radix, value);
+    const QRectF textRect(left + 2, rowRect.top(), right - left - 4, rowRect.height());
+    if (painter.fontMetrics().horizontalAdvance(text) <= textRect.width()) {
+        painter.setPen(Qt::white);
+        painter.drawText(textRect, Qt::AlignCenter, text);
+    }
+}
+
+void WaveformWidget::paintExact(QPainter& painter, const VisibleTrace& trace, const QRect& rowRect) const {
+    const auto& changes = trace.changes;
+    const bool isBus = trace.port->getWidth() > 1;
+    const qreal high = rowRect.top() + TraceMargin;
+    const qreal low = rowRect.bottom() - TraceMargin;
+
+    const uint64_t end = trace.end;
+    uint64_t segStart = trace.from;
+    const uint64_t visibleEnd = trace.to;
+
+    QVector<QLineF> lines;
+    struct Label {
+        VSRTL_VT_U value;
+        qreal x0;
+        qreal x1;
+    };
+    std::vector<Label> labels;
+    for (size_t i = 0; segStart < visibleEnd; ++i) {
+        const VSRTL_VT_U value = changes[i].value;
+        const uint64_t next = i + 1 < changes.size() ? changes[i + 1].cycle : end;
+        const uint64_t segEnd = std::min(next, visibleEnd);
+        const qreal x0 = cycleToX(segStart);
+        const qreal x1 = cycleToX(segEnd);
+
+        if (isBus) {
+            lines << QLineF(x0, high, x1, high) << QLineF(x0, low, x1, low);
+            labels.push_back({value, x0, x1});
+        } else {
+            const qreal y = (value & 0b1) ? high : low;
+            lines << QLineF(x0, y, x1, y);
+        }
+        if (next < end && segEnd == next) {
+            // Transition
+            lines << QLineF(x1, high, x1, low);
+        }
+        segStart = segEnd;
+    }
+
+    painter.setPen(QPen(WIRE_BOOLHIGH_COLOR, 1));
+    painter.drawLines(lines);
+    for (const auto& label : labels) {
+        paintBusLabel(painter, trace, label.value, rowRect, label.x0, label.x1);
+    }
+}
+
+void WaveformWidget::paintSummarized(QPainter& painter, const VisibleTrace& trace, const QRect& rowRect) const {
+    const bool isBus = trace.port->getWidth() > 1;
+    const qreal high = rowRect.top() + TraceMargin;
+    const qreal low = rowRect.bottom() - TraceMargin;
+
+    // Adjacent pixel columns are merged into runs of either stable values or columns containing value changes.
+    struct Run {
+        qreal x0;
+        qreal x1;
+        bool busy;
+        VSRTL_VT_U value;
+    };
+    std::vector<Run> runs;
+
+    for (size_t column = 0; column < trace.columns.size(); ++column) {
+        const auto& summary = trace.columns[column];
+        const bool busy = summary.changes > 0 || summary.min != summary.max;
+        const qreal x = rowRect.left() + trace.firstColumn + column;
+
+        if (!runs.empty() && runs.back().busy == busy && (busy || runs.back().value == summary.min)) {
+            runs.back().x1 = x + 1;
+        } else {
+            runs.push_back({x, x + 1, busy, summary.min});
+        }
+    }
+
+    QVector<QLineF> lines;
+    const QColor busyColor = WIRE_BOOLHIGH_COLOR.darker(150);
+    for (const auto& run : runs) {
+        if (run.busy) {
+            painter.fillRect(QRectF(QPointF(run.x0, high), QPointF(run.x1, low)), busyColor);
+        } else if (isBus) {
+            lines << QLineF(run.x0, high, run.x1, high) << QLineF(run.x0, low, run.x1, low);
+        } else {
+            const qreal y = (run.value & 0b1) ? high : low;
+            lines << QLineF(run.x0, y, run.x1, y);
+        }
+    }
+    painter.setPen(QPen(WIRE_BOOLHIGH_COLOR, 1));
+    painter.drawLines(lines);
+
+    if (isBus) {
+        for (const auto& run : runs) {
+            if (!run.busy) {
+                paintBusLabel(painter, trace, run.value, rowRect, run.x0, run.x1);
+            }
+        }
+    }
+}
+
+}  // namespace vsrtl
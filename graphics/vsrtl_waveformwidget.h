@@ -0,0 +1,139 @@
+#ifndef VSRTL_WAVEFORMWIDGET_H
+#define VSRTL_WAVEFORMWIDGET_H
+
+#include <QMutex>
+#include <QWidget>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "../interface/vsrtl_interface.h"
+#include "vsrtl_radix.h"
+#include "vsrtl_waveformtrace.h"
+
+QT_FORWARD_DECLARE_CLASS(QScrollBar)
+QT_FORWARD_DECLARE_CLASS(QTimer)
+
+namespace vsrtl {
+
+/**
+ * @brief The WaveformWidget class
+ * Plots the value history of a set of ports. Ports are sampled whenever the design is clocked, which, given that the
+ * clocked signals of a design are emitted from the thread which clocks the design, may happen on a background thread
+ * (ie. during VSRTLWidget::run). Sampling and painting are therefore serialized through m_traceMutex, and repaints are
+ * throttled through m_repaintTimer rather than being issued for each sample. Painting only holds the lock while copying
+ * the visible part of each trace.
+ */
+class WaveformWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit WaveformWidget(QWidget* parent = nullptr);
+    ~WaveformWidget();
+
+    void setDesign(SimDesign* design);
+    void addPort(SimPort* port);
+    void removePort(SimPort* port);
+    void clearPorts();
+    std::vector<SimPort*> ports() const;
+
+    QSize sizeHint() const override;
+
+public slots:
+    void zoomIn();
+    void zoomOut();
+    void zoomToFit();
+
+    /**
+     * @brief setFollow
+     * When following, the view is kept scrolled to the most recently sampled cycle.
+     */
+    void setFollow(bool follow);
+
+    /**
+     * @brief clearHistory
+     * Discards all recorded samples and resamples the current state of the design.
+     */
+    void clearHistory();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void contextMenuEvent(QContextMenuEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private slots:
+    void handleRepaintTimeout();
+    void handleScrollBarMoved(int value);
+
+private:
+    struct TraceEntry {
+        TraceEntry(SimPort* port) : trace(port) {}
+        WaveformTrace trace;
+        Radix radix = Radix::Hex;
+    };
+
+    /// Copy of the visible part of a trace, such that it may be painted without holding m_traceMutex.
+    struct VisibleTrace {
+        SimPort* port = nullptr;
+        Radix radix = Radix::Hex;
+        bool empty = true;
+        VSRTL_VT_U cursorValue = 0;
+        /// End of the recorded cycles (exclusive)
+        uint64_t end = 0;
+        // Exact traces; the visible cycles [from, to) and the changes covering them
+        uint64_t from = 0;
+        uint64_t to = 0;
+        std::vector<WaveformTrace::Change> changes;
+        // Summarized traces; one summary per pixel column, starting at firstColumn
+        int firstColumn = 0;
+        std::vector<WaveformTrace::Bucket> columns;
+    };
+
+    // Design signal handlers. These may be executed on a non-GUI thread.
+    void sample();
+    void handleDesignReversed();
+    void handleDesignReset();
+    void disconnectDesign();
+
+    VisibleTrace captureTrace(const TraceEntry& entry, const QRect& rowRect, uint64_t cursorCycle) const;
+    void paintTrace(QPainter& painter, const VisibleTrace& trace, const QRect& rowRect) const;
+    void paintExact(QPainter& painter, const VisibleTrace& trace, const QRect& rowRect) const;
+    void paintSummarized(QPainter& painter, const VisibleTrace& trace, const QRect& rowRect) const;
+    void paintBusLabel(QPainter& painter, const VisibleTrace& trace, VSRTL_VT_U value, const QRect& rowRect, qreal x0,
+                       qreal x1) const;
+    void paintRuler(QPainter& painter, const QRect& rulerRect) const;
+
+    QRect plotRect() const;
+    int traceIndexAt(const QPoint& pos) const;
+    qreal cycleToX(qreal cycle) const;
+    qreal xToCycle(qreal x) const;
+    void zoom(qreal factor, qreal anchorX);
+    void updateScrollBar();
+    uint64_t lastCycle() const;
+    uint64_t firstCycle() const;
+
+    SimDesign* m_design = nullptr;
+
+    mutable QMutex m_traceMutex;
+    std::vector<std::unique_ptr<TraceEntry>> m_traces;
+    /// Number of entries in m_traces; allows sample() to skip the lock when no ports are traced.
+    std::atomic<size_t> m_traceCount = 0;
+
+    /// Set whenever new samples have been recorded; polled by m_repaintTimer.
+    std::atomic<bool> m_dirty = false;
+    QTimer* m_repaintTimer = nullptr;
+    QScrollBar* m_scrollBar = nullptr;
+
+    // View state, in cycles
+    qreal m_startCycle = 0;
+    qreal m_cyclesPerPixel = 0.1;
+    bool m_follow = true;
+    long long m_cursorCycle = -1;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_WAVEFORMWIDGET_H
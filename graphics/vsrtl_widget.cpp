@@ -6,10 +6,13 @@
 #include "vsrtl_shape.h"
 #include "vsrtl_view.h"
 
+#include <chrono>
 #include <memory>
 
+#include <QElapsedTimer>
 #include <QFontDatabase>
 #include <QGraphicsScene>
+#include <QTimer>
 #include <QtConcurrent/QtConcurrent>
 
 void initVsrtlResources() {
@@ -44,22 +47,21 @@ VSRTLWidget::VSRTLWidget(QWidget* parent) : QWidget(parent), ui(new Ui::VSRTLWid
     ui->viewLayout->addWidget(m_view);
     connect(m_scene, &QGraphicsScene::selectionChanged, this, (&VSRTLWidget::handleSceneSelectionChanged));
 
-    /**
-     * runFinished will always be emitted asynchronously within the run call.
-     * When a run is finished, we need to ensure that the graphical view is fully up to date with the underlying
-     * circuit. This is performed through sync, but ensured to be performed on the main gui thread, and not
-     * on whatever thread the running was performed on.
-     */
-    connect(this, &VSRTLWidget::runFinished, this, &VSRTLWidget::sync, Qt::QueuedConnection);
+    // Snapshots are published by the simulation thread, but must be acquired on the GUI thread; the snapshot has a
+    // single reader.
+    connect(this, &VSRTLWidget::snapshotPublished, this, &VSRTLWidget::syncSnapshot, Qt::QueuedConnection);
 }
 
 void VSRTLWidget::clearDesign() {
+    cancelExpandAll();
     if (m_topLevelComponent) {
         // Clear previous design
         delete m_topLevelComponent;
         m_topLevelComponent = nullptr;
     }
     m_design = nullptr;
+    m_nets.clear();
+    m_netOfPort.clear();
 }
 
 void VSRTLWidget::setDesign(SimDesign* design, bool doPlaceAndRoute) {
@@ -111,17 +113,41 @@ void VSRTLWidget::handleSceneSelectionChanged() {
     emit portSelectionChanged(selectedPorts);
 }  // namespace vsrtl
 
+void VSRTLWidget::locateComponent(SimComponent* c) {
+    // Expand top-down, since the graphics of a component are created once its parent is expanded
+    std::vector<SimComponent*> parents;
+    for (auto* parent = c->getParent<SimComponent>(); parent; parent = parent->getParent<SimComponent>()) {
+        parents.insert(parents.begin(), parent);
+    }
+    for (auto* parent : parents) {
+        auto* parentGraphic = parent->getGraphic<ComponentGraphic>();
+        if (!parentGraphic || parentGraphic->userHidden()) {
+            return;
+        }
+        if (!parentGraphic->isExpanded()) {
+            parentGraphic->setExpanded(true);
+        }
+    }
+
+    if (auto* graphic = c->getGraphic<ComponentGraphic>()) {
+        m_view->centerOn(graphic);
+    }
+}
+
 void VSRTLWidget::handleSelectionChanged(const std::vector<SimComponent*>& selected,
                                          const std::vector<SimComponent*>& deselected) {
     // Block signals from scene to disable selectionChange emission.
     m_scene->blockSignals(true);
+    // Components within collapsed components may not have had their graphics created yet
     for (const auto& c : selected) {
-        auto* c_g = c->getGraphic<ComponentGraphic>();
-        c_g->setSelected(true);
+        if (auto* c_g = c->getGraphic<ComponentGraphic>()) {
+            c_g->setSelected(true);
+        }
     }
     for (const auto& c : deselected) {
-        auto* c_g = c->getGraphic<ComponentGraphic>();
-        c_g->setSelected(false);
+        if (auto* c_g = c->getGraphic<ComponentGraphic>()) {
+            c_g->setSelected(false);
+        }
     }
     m_scene->blockSignals(false);
 }
@@ -147,19 +173,114 @@ void VSRTLWidget::initializeDesign(bool doPlaceAndRoute) {
     // Add top level component to scene at the end. Do _not_ move this before initialization - initialization will be
     // massively slowed down if items are modified while already in the scene.
     addComponent(m_topLevelComponent);
+
+    buildNetRegistry();
+    connect(m_topLevelComponent, &ComponentGraphic::subcomponentGraphicsCreated, this,
+            &VSRTLWidget::handleSubcomponentGraphicsCreated);
+}
+
+void VSRTLWidget::buildNetRegistry() {
+    const auto& ports = m_design->getPorts();
+    m_nets.clear();
+    m_netOfPort.assign(ports.size(), 0);
+    // Ports without an input port drive their net
+    for (auto* port : ports) {
+        if (!port->getInputPort()) {
+            m_netOfPort[port->ordinal()] = m_nets.size();
+            m_nets.push_back({port, port->uValue(), {}});
+        }
+    }
+    for (auto* port : ports) {
+        SimPort* root = port;
+        while (root->getInputPort()) {
+            root = root->getInputPort();
+        }
+        m_netOfPort[port->ordinal()] = m_netOfPort[root->ordinal()];
+        if (auto* graphic = port->getGraphic<PortGraphic>()) {
+            m_nets[m_netOfPort[port->ordinal()]].subscribers.push_back(graphic);
+        }
+    }
+}
+
+void VSRTLWidget::handleSubcomponentGraphicsCreated(ComponentGraphic* component) {
+    for (auto* sub : component->getGraphicSubcomponents()) {
+        for (auto* port : sub->getComponent()->getAllPorts()) {
+            if (auto* graphic = port->getGraphic<PortGraphic>()) {
+                subscribe(port, graphic);
+            }
+        }
+    }
+}
+
+void VSRTLWidget::subscribe(SimPort* port, SimQObject* object) {
+    m_nets.at(m_netOfPort.at(port->ordinal())).subscribers.push_back(object);
 }
 
 void VSRTLWidget::expandAllComponents(ComponentGraphic* fromThis) {
     if (fromThis == nullptr)
         fromThis = m_topLevelComponent;
+    if (fromThis == nullptr)
+        return;
+
+    cancelExpandAll();
+    m_expandAll.active = true;
+    m_expandAll.order = {fromThis};
+    QTimer::singleShot(0, this, &VSRTLWidget::expandAllStep);
+}
 
-    fromThis->setExpanded(true);
+void VSRTLWidget::cancelExpandAll() {
+    if (auto* job = m_expandAll.placeRoute.release()) {
+        // Cancelling may happen from within the signals of the job, so it is not destroyed immediately
+        job->disconnect(this);
+        job->cancel();
+        job->deleteLater();
+    }
+    m_expandAll = ExpandAllState();
+}
+
+void VSRTLWidget::expandAllStep() {
+    if (!m_expandAll.active) {
+        // Cancelled
+        return;
+    }
 
-    // Components are expanded and routed from leaf nodes and up
-    for (const auto& sub : fromThis->getGraphicSubcomponents())
-        expandAllComponents(sub);
+    // Process components for a single frame before yielding to the event loop
+    QElapsedTimer timer;
+    timer.start();
+    auto& order = m_expandAll.order;
+    while (timer.elapsed() < 16) {
+        if (m_expandAll.expanded < order.size()) {
+            // Components are expanded top-down, which creates the graphics of their subcomponents without placing
+            // them...
+            auto* c = order[m_expandAll.expanded++];
+            c->setExpanded(true, false);
+            for (auto* sub : c->getGraphicSubcomponents()) {
+                if (sub->hasSubcomponents()) {
+                    order.push_back(sub);
+                }
+            }
+        } else {
+            // ... which are placed from leaf nodes and up, off the GUI thread. Each component is placed and routed
+            // once, as the job applies its placement on the GUI thread.
+            auto* job = new PlaceRouteJob(std::vector<GridComponent*>(order.begin(), order.end()));
+            m_expandAll.placeRoute.reset(job);
+            const int expanded = m_expandAll.expanded;
+            connect(job, &PlaceRouteJob::progress, this,
+                    [=](int done, int total) { emit expandAllProgress(expanded + done, expanded + total); });
+            connect(job, &PlaceRouteJob::finished, this, [=](bool cancelled) {
+                if (!cancelled) {
+                    m_expandAll.placeRoute.release()->deleteLater();
+                    m_expandAll = ExpandAllState();
+                    emit expandAllFinished();
+                }
+            });
+            job->start();
+            return;
+        }
+    }
 
-    fromThis->placeAndRouteSubcomponents();
+    emit expandAllProgress(m_expandAll.expanded, 2 * order.size());
+    QTimer::singleShot(0, this, &VSRTLWidget::expandAllStep);
 }
 
 bool VSRTLWidget::isReversible() {
@@ -182,39 +303,128 @@ void VSRTLWidget::clock() {
 }
 
 void VSRTLWidget::sync() {
+    syncNets(false);
+}
+
+void VSRTLWidget::syncAll() {
+    syncNets(true);
+}
+
+void VSRTLWidget::syncNets(bool all) {
+    if (!m_design) {
+        return;
+    }
+
     // Since the design does not emit signals during running, we need to manually tell all labels to reset their text
     // value, given that labels manually must have their text updated (ie. text is not updated in the redraw call).
-    const auto sceneItems = m_scene->items();
-    for (auto* item : qAsConst(sceneItems)) {
-        if (auto* simobject = dynamic_cast<SimQObject*>(item)) {
-            simobject->simUpdateSlot();
+    // Subscribers schedule redraws of their own bounding rects.
+    for (auto& net : m_nets) {
+        const VSRTL_VT_U value = net.root->observedValue();
+        if (all || value != net.value) {
+            net.value = value;
+            for (auto* subscriber : net.subscribers) {
+                subscriber->simUpdateSlot();
+            }
         }
     }
 
-    m_scene->update();
+    // Profiling heat maps of components may change regardless of the values of nets
+    if (all || m_design->observedProfiler()) {
+        m_scene->invalidateItemCaches();
+    }
+}
+
+void VSRTLWidget::syncSnapshot() {
+    m_snapshotPending = false;
+    // The run may have finished since the snapshot was published, in which case runFinished synchronizes the scene
+    if (m_design && m_design->liveSnapshots() && m_design->getSnapshot().acquire()) {
+        sync();
+    }
+}
+
+void VSRTLWidget::accountMemory(MemoryFootprint& footprint) const {
+    const auto& nodes = footprint.nodes();
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (const auto* graphic = nodes[i].component->getGraphic<ComponentGraphic>()) {
+            graphic->accountMemory(footprint.usage(i));
+        }
+    }
+    if (!nodes.empty()) {
+        // The net registry is attributed to the design itself
+        size_t netBytes = footprint::bytes(m_nets) + footprint::bytes(m_netOfPort);
+        for (const auto& net : m_nets) {
+            netBytes += footprint::bytes(net.subscribers);
+        }
+        footprint.usage(0)[MemoryFootprint::PortGraphics] += netBytes;
+    }
 }
 
 QFuture<void> VSRTLWidget::run(const std::function<void()>& cycleFunctor) {
-    auto future = QtConcurrent::run([=] {
-        if (m_design) {
-            m_design->setEnableSignals(false);
-            if (cycleFunctor) {
-                while (!m_stop) {
-                    m_design->clock();
-                    cycleFunctor();
-                }
-            } else {
-                while (!m_stop) {
-                    m_design->clock();
+    if (!m_design) {
+        return QFuture<void>();
+    }
+
+    m_stop = false;
+    m_design->setEnableSignals(false);
+    m_design->getBreakpoints().clearHits();
+
+    // Until now, graphic objects were kept up to date through the signals of the design. The nets are synced relative
+    // to the state of the design at the start of the run. The net registry is only accessed from the GUI thread; while
+    // running, changed nets are determined from the acquired snapshots (see syncNets()).
+    for (auto& net : m_nets) {
+        net.value = net.root->uValue();
+    }
+
+    // While running, observers of the design read values from the snapshots published by the simulation thread (see
+    // SimPort::observedValue()) rather than from the ports being modified. The initial snapshot is published and
+    // acquired here, before the simulation thread is started.
+    m_snapshotPending = false;
+    m_design->setLiveSnapshots(true);
+    m_running = true;
+    emit runStarted();
+
+    return QtConcurrent::run([=] {
+        auto& breakpoints = m_design->getBreakpoints();
+        using Clock = std::chrono::steady_clock;
+        const bool live = m_liveUpdateRate != 0;
+        const auto updateInterval =
+            live ? std::chrono::nanoseconds(1000000000 / m_liveUpdateRate) : std::chrono::nanoseconds(0);
+        auto nextUpdate = Clock::now() + updateInterval;
+
+        auto runLoop = [&](const auto& cycle) {
+            unsigned cycles = 0;
+            while (!m_stop && !breakpoints.triggered()) {
+                cycle();
+                // The clock is only sampled every 64 cycles, keeping its cost out of the simulation loop
+                if (live && (++cycles % 64) == 0 && !m_snapshotPending && Clock::now() >= nextUpdate) {
+                    m_design->publishSnapshot();
+                    m_snapshotPending = true;
+                    emit snapshotPublished();
+                    nextUpdate = Clock::now() + updateInterval;
                 }
             }
-            m_stop = false;
-            m_design->setEnableSignals(true);
-
-            emit runFinished();
+        };
+        if (cycleFunctor) {
+            runLoop([&] {
+                m_design->clock();
+                cycleFunctor();
+            });
+        } else {
+            runLoop([&] { m_design->clock(); });
         }
+
+        // The run is finished on the GUI thread, which owns the reader side of the snapshot
+        QMetaObject::invokeMethod(this, &VSRTLWidget::finishRun, Qt::QueuedConnection);
     });
-    return future;
+}
+
+void VSRTLWidget::finishRun() {
+    m_running = false;
+    m_design->setLiveSnapshots(false);
+    m_design->setEnableSignals(true);
+    // Ensure that the scene is fully up to date with the state of the design
+    sync();
+    emit runFinished();
 }
 
 void VSRTLWidget::reverse() {
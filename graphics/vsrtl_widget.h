@@ -3,6 +3,7 @@
 
 #include <QMainWindow>
 #include "vsrtl_componentgraphic.h"
+#include "vsrtl_placeroute.h"
 #include "vsrtl_portgraphic.h"
 
 #include <QtConcurrent/QtConcurrent>
@@ -26,10 +27,22 @@ public:
     ~VSRTLWidget();
 
     void addComponent(ComponentGraphic* g);
+    /**
+     * @brief expandAllComponents
+     * Expands @p fromThis (the top-level component if nullptr) and all components nested within it. Components are
+     * expanded top-down and then placed and routed bottom-up. Expansion is performed incrementally on the event loop,
+     * creating subcomponent graphics as components are expanded, after which placement is computed on worker threads
+     * (see PlaceRouteJob), such that the scene stays responsive while expanding large designs. Expansion may be
+     * cancelled through cancelExpandAll().
+     */
     void expandAllComponents(ComponentGraphic* fromThis = nullptr);
+    void cancelExpandAll();
+    bool isExpandingAll() const { return m_expandAll.active; }
     ComponentGraphic* getTopLevelComponent() { return m_topLevelComponent; }
+    VSRTLScene* getScene() const { return m_scene; }
 
     void setDesign(SimDesign* design, bool doPlaceAndRoute = false);
+    SimDesign* getDesign() const { return m_design; }
     void clearDesign();
     bool isReversible();
 
@@ -39,15 +52,48 @@ public:
     void zoomToFit();
 
     /// Called whenever the state of the simulator and the visualization is out of sync, i.e., after running the
-    /// processor. Updates the scene and all text items within it to reflect the current state of the processor.
+    /// processor. Updates the graphic objects subscribed to nets which changed value since the last sync, to reflect
+    /// the current state of the processor.
     void sync();
+    /// Updates all subscribed graphic objects and redraws the entire scene, ie. after changing how values are drawn.
+    void syncAll();
+
+    /**
+     * @brief subscribe
+     * Subscribes @p object to the net of @p port, such that sync() calls SimQObject::simUpdateSlot() of @p object
+     * whenever the value of the net has changed since the previous sync. Port graphics of the design are subscribed
+     * to their nets upon setting the design.
+     */
+    void subscribe(SimPort* port, SimQObject* object);
+
+    /**
+     * @brief accountMemory
+     * Adds the estimated memory of the graphical objects of the design to @p footprint, which must be a footprint of
+     * the current design (see SimDesign::getMemoryFootprint()).
+     */
+    void accountMemory(MemoryFootprint& footprint) const;
+
+    /**
+     * @brief setLiveUpdateRate
+     * Sets the rate, in Hz, at which the scene is updated while the design is running (see run()). While running, the
+     * simulation thread publishes snapshots of the design at this rate, which the scene is then synchronized to. A rate
+     * of 0 disables live updates, such that the scene is only updated once running finishes. Takes effect upon the
+     * next run.
+     */
+    void setLiveUpdateRate(unsigned hz) { m_liveUpdateRate = hz; }
+    unsigned liveUpdateRate() const { return m_liveUpdateRate; }
+
+    /// @returns whether the design is being run; see run().
+    bool isRunning() const { return m_running; }
 
 public slots:
 
     /**
      * @brief run
-     * Asynchronously run the design until m_stop is asserted. @returns a future which may be watched to monitor run
-     * finishing.
+     * Asynchronously run the design until m_stop is asserted or a breakpoint of the design is triggered (see
+     * SimDesign::getBreakpoints()). Must be called from the GUI thread; the design is simulated on a worker thread,
+     * while the scene is drawn from snapshots of the design (see SimDesign::setLiveSnapshots()). runFinished is emitted
+     * on the GUI thread once the run has finished. @returns a future which may be watched to monitor run finishing.
      * Additionally, a functor @param cycleFunctor can be passed to the function. This functor will be
      * executed after each clock cycle. Example uses of such functor could be; ie. if simulating a processor, whether
      * the prcoessor has hit a breakpoint and running needs to be terminated.
@@ -59,11 +105,22 @@ public slots:
     void reverse();
 
     // Selections which are imposed on the scene from external objects (ie. selecting items in the netlist)
+    /**
+     * @brief locateComponent
+     * Expands the parent components of @p c, such that @p c is visible within the scene, and centers the view on @p c.
+     */
+    void locateComponent(SimComponent* c);
     void handleSelectionChanged(const std::vector<SimComponent*>& selected,
                                 const std::vector<SimComponent*>& deselected);
 
 signals:
+    void runStarted();
     void runFinished();
+    /// Progress of expandAllComponents(); @p total grows as nested components are discovered.
+    void expandAllProgress(int done, int total);
+    void expandAllFinished();
+    /// Emitted from the simulation thread when a snapshot of the running design has been published.
+    void snapshotPublished();
 
 private slots:
 
@@ -74,14 +131,27 @@ signals:
 
 private slots:
     void handleSceneSelectionChanged();
+    void syncSnapshot();
+    void finishRun();
+    void handleSubcomponentGraphicsCreated(vsrtl::ComponentGraphic* component);
+    void expandAllStep();
 
 private:
     // State variable for reducing the number of emitted canReverse signals
     bool m_designCanreverse = false;
 
     std::atomic<bool> m_stop = false;
+    /// Set from the start of run() until the run has been finished on the GUI thread
+    bool m_running = false;
+
+    unsigned m_liveUpdateRate = 30;
+    // Set while a published snapshot has yet to be synchronized to, such that a slow GUI thread does not accumulate
+    // pending snapshot events.
+    std::atomic<bool> m_snapshotPending = false;
 
     void initializeDesign(bool doPlaceAndRoute);
+    void buildNetRegistry();
+    void syncNets(bool all);
     Ui::VSRTLWidget* ui;
 
     ComponentGraphic* m_topLevelComponent = nullptr;
@@ -90,6 +160,29 @@ private:
     VSRTLScene* m_scene;
 
     SimDesign* m_design = nullptr;
+
+    struct Net {
+        /// Driving port of the net
+        SimPort* root;
+        /// Observed value of the net as of the previous sync (see SimPort::observedValue()). The net registry is only
+        /// accessed from the GUI thread.
+        VSRTL_VT_U value;
+        std::vector<SimQObject*> subscribers;
+    };
+    std::vector<Net> m_nets;
+
+    struct ExpandAllState {
+        bool active = false;
+        /// Components in the order of which they are expanded
+        std::vector<ComponentGraphic*> order;
+        /// Number of components in @p order which have been expanded
+        size_t expanded = 0;
+        /// Places and routes the expanded components, once all components have been expanded
+        std::unique_ptr<PlaceRouteJob> placeRoute;
+    };
+    ExpandAllState m_expandAll;
+    /// Index into m_nets of the net of each port of the design, indexed by port ordinal (see SimPort::ordinal())
+    std::vector<uint32_t> m_netOfPort;
 };
 
 }  // namespace vsrtl
@@ -0,0 +1,103 @@
+#include "vsrtl_wireanimator.h"
+#include "vsrtl_portgraphic.h"
+
+#include <algorithm>
+
+namespace vsrtl {
+
+namespace {
+
+int interpolate(int from, int to, double t) {
+    return from + static_cast<int>((to - from) * t + (to >= from ? 0.5 : -0.5));
+}
+
+QColor interpolate(const QColor& from, const QColor& to, double t) {
+    return QColor(interpolate(from.red(), to.red(), t), interpolate(from.green(), to.green(), t),
+                  interpolate(from.blue(), to.blue(), t), interpolate(from.alpha(), to.alpha(), t));
+}
+
+}  // namespace
+
+WireAnimator::WireAnimator() {
+    m_timer.setInterval(TickInterval);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &WireAnimator::tick);
+    m_clock.start();
+}
+
+void WireAnimator::start(PortGraphic* port, const QColor& from, const QColor& to) {
+    const qint64 now = m_clock.elapsed();
+    auto it = m_index.find(port);
+    if (it != m_index.end() && m_transitions[it->second].port == port) {
+        auto& transition = m_transitions[it->second];
+        transition.start = now;
+        transition.from = from;
+        transition.to = to;
+        transition.dirty = true;
+    } else {
+        if (it != m_index.end()) {
+            // A previous port at the same address was destroyed while transitioning
+            remove(it->second);
+        }
+        m_index[port] = m_transitions.size();
+        m_transitions.push_back({port, port, now, from, to, true});
+    }
+
+    port->m_penColor = from;
+    port->updatePenColor(false);
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void WireAnimator::remove(size_t index) {
+    m_index.erase(m_transitions[index].key);
+    if (index != m_transitions.size() - 1) {
+        m_transitions[index] = m_transitions.back();
+        m_index[m_transitions[index].key] = index;
+    }
+    m_transitions.pop_back();
+}
+
+void WireAnimator::tick() {
+    const qint64 now = m_clock.elapsed();
+
+    // Update the pens of all transitioning ports before scheduling any redraws
+    m_redraw.clear();
+    for (size_t i = 0; i < m_transitions.size();) {
+        auto& transition = m_transitions[i];
+        PortGraphic* port = transition.port;
+        if (!port) {
+            remove(i);
+            continue;
+        }
+
+        const double t = std::min(1.0, static_cast<double>(now - transition.start) / Duration);
+        const QColor color = interpolate(transition.from, transition.to, t);
+        if (color != port->m_penColor) {
+            port->m_penColor = color;
+            port->updatePenColor(false);
+            transition.dirty = true;
+        }
+        if (transition.dirty) {
+            transition.dirty = false;
+            m_redraw.push_back(port);
+        }
+
+        if (t >= 1.0) {
+            remove(i);
+        } else {
+            ++i;
+        }
+    }
+
+    for (auto* port : m_redraw) {
+        port->propagateRedraw();
+    }
+
+    if (m_transitions.empty()) {
+        m_timer.stop();
+    }
+}
+
+}  // namespace vsrtl
@@ -0,0 +1,75 @@
+#ifndef VSRTL_WIREANIMATOR_H
+#define VSRTL_WIREANIMATOR_H
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <unordered_map>
+#include <vector>
+
+namespace vsrtl {
+
+class PortGraphic;
+
+/**
+ * @brief The WireAnimator class
+ * Singleton driving the color transitions of wires whose value changed. All active transitions are advanced by a single
+ * timer, at most once per frame, instead of through an animation object per port. The pens of all transitioning ports
+ * are updated before any redraw is scheduled, such that the scene repaints the affected wires once per tick.
+ * The animator is shared by all scenes, since a wire may be visible while its source port is not part of any scene (ie.
+ * the source port resides within a collapsed component).
+ */
+class WireAnimator : public QObject {
+    Q_OBJECT
+
+public:
+    static WireAnimator* get() {
+        static WireAnimator* instance = new WireAnimator();
+        return instance;
+    }
+
+    /// Duration of a color transition, in milliseconds
+    static constexpr int Duration = 100;
+    /// Interval between ticks, in milliseconds
+    static constexpr int TickInterval = 16;
+
+    /**
+     * @brief start
+     * Starts a linear color transition of the wire driven by @p port, from @p from to @p to. A transition already in
+     * progress for @p port is restarted. The pen of @p port is set to @p from, and is redrawn on the next tick.
+     */
+    void start(PortGraphic* port, const QColor& from, const QColor& to);
+    size_t activeTransitions() const { return m_transitions.size(); }
+
+private slots:
+    void tick();
+
+private:
+    WireAnimator();
+
+    struct Transition {
+        PortGraphic* key;
+        QPointer<PortGraphic> port;
+        qint64 start;
+        QColor from;
+        QColor to;
+        /// Whether the pen has been set without the port being redrawn
+        bool dirty;
+    };
+
+    void remove(size_t index);
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    std::vector<Transition> m_transitions;
+    /// Index of the transition of each port within m_transitions
+    std::unordered_map<PortGraphic*, size_t> m_index;
+    std::vector<PortGraphic*> m_redraw;
+};
+
+}  // namespace vsrtl
+
+#endif  // VSRTL_WIREANIMATOR_H
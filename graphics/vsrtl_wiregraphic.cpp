@@ -74,7 +74,7 @@ QPainterPath PortPoint::shape() const {
 
 void PortPoint::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) {
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
-    if (lod < 0.35)
+    if (lod < LOD_DETAILS)
         return;
 
     // Do not draw point when only a single output wire exists, and we are not currently interacting with the point
@@ -305,12 +305,22 @@ bool WireSegment::isDrawn() const {
     return isValid() && m_start->isVisible() && m_end->isVisible();
 }
 
-void WireSegment::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
+void WireSegment::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) {
     if (!isDrawn())
         return;
 
+    QPen pen = m_parent->getPen();
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (lod < LOD_DETAILS) {
+        // Segments shorter than a pixel are covered by the segments they join. Remaining segments are drawn as single
+        // pixel lines, such that bundles of parallel wires do not blend into a solid area.
+        if (m_cachedLine.length() * lod < 1)
+            return;
+        pen.setWidth(0);
+    }
+
     painter->save();
-    painter->setPen(m_parent->getPen());
+    painter->setPen(pen);
     painter->drawLine(m_cachedLine);
     painter->restore();
 #ifdef VSRTL_DEBUG_DRAW
@@ -414,6 +424,12 @@ WireGraphic::WireGraphic(ComponentGraphic* parent, PortGraphic* from, const std:
     setFlag(QGraphicsItem::ItemHasNoContents, true);
 }
 
+size_t WireGraphic::memoryUsage() const {
+    return sizeof(WireGraphic) + footprint::bytes(m_toPorts) + footprint::bytes(m_toGraphicPorts) +
+           footprint::treeBytes(m_wires) + footprint::treeBytes(m_points) + m_wires.size() * sizeof(WireSegment) +
+           m_points.size() * sizeof(WirePoint);
+}
+
 bool WireGraphic::managesPoint(WirePoint* point) const {
     return std::find(m_points.begin(), m_points.end(), point) != m_points.end();
 }
@@ -562,6 +578,102 @@ void WireGraphic::setWiresVisibleToPort(const PortPoint* p, bool visible) {
     }
 }
 
+QPoint WireGraphic::gridPos(PortPoint* point) const {
+    // Wires are positioned at the origin of their parent component
+    return sceneToGrid(mapFromItem(point, QPointF()));
+}
+
+GridRouter::Net WireGraphic::routingNet() const {
+    auto axisOf = [](const PortGraphic* port) {
+        return port->getSide() == Side::Left || port->getSide() == Side::Right ? GridRouter::Axis::Horizontal
+                                                                                : GridRouter::Axis::Vertical;
+    };
+    GridRouter::Net net;
+    net.source = {gridPos(m_fromPort->getPortPoint(vsrtl::SimPort::PortType::out)), axisOf(m_fromPort)};
+    for (const auto& p : m_toGraphicPorts) {
+        net.sinks.push_back({gridPos(p->getPortPoint(vsrtl::SimPort::PortType::in)), axisOf(p)});
+    }
+    return net;
+}
+
+RouteTree WireGraphic::currentRoute() const {
+    RouteTree route;
+    std::map<PortPoint*, int> index;
+    std::vector<PortPoint*> points = {m_fromPort->getPortPoint(vsrtl::SimPort::PortType::out)};
+    index[points[0]] = 0;
+    route.points.push_back(gridPos(points[0]));
+    route.parents.push_back(-1);
+
+    // Points are visited breadth-first, such that parents precede their children
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (const auto& wire : points[i]->getOutputWires()) {
+            PortPoint* end = wire->getEnd();
+            if (m_wires.count(wire) == 0 || end == nullptr) {
+                continue;
+            }
+            if (index.count(end)) {
+                return {};  // Not a tree
+            }
+            index[end] = points.size();
+            points.push_back(end);
+            route.points.push_back(gridPos(end));
+            route.parents.push_back(i);
+        }
+    }
+
+    for (const auto& p : m_toGraphicPorts) {
+        auto it = index.find(p->getPortPoint(vsrtl::SimPort::PortType::in));
+        if (it == index.end()) {
+            return {};
+        }
+        route.sinks.push_back(it->second);
+    }
+    return route;
+}
+
+void WireGraphic::applyRoute(const RouteTree& route) {
+    if (route.empty()) {
+        return;
+    }
+    prepareGeometryChange();
+    setSerializing(true);
+    clearWirePoints();
+    clearWires();
+
+    std::vector<PortPoint*> points(route.points.size(), nullptr);
+    PortPoint* source = m_fromPort->getPortPoint(vsrtl::SimPort::PortType::out);
+    points[0] = source;
+    for (size_t i = 0; i < m_toGraphicPorts.size() && i < route.sinks.size(); ++i) {
+        if (route.sinks[i] > 0) {
+            points[route.sinks[i]] = m_toGraphicPorts[i]->getPortPoint(vsrtl::SimPort::PortType::in);
+        }
+    }
+
+    // Parents precede their children within the route
+    std::vector<std::pair<WirePoint*, QPoint>> wirePoints;
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (points[i] == nullptr) {
+            auto* point = createWirePoint();
+            wirePoints.push_back({point, route.points[i]});
+            points[i] = point;
+        }
+        createSegment(points[route.parents[i]], points[i]);
+    }
+    for (size_t i = 0; i < m_toGraphicPorts.size(); ++i) {
+        if (i >= route.sinks.size() || route.sinks[i] <= 0) {
+            createSegment(source, m_toGraphicPorts[i]->getPortPoint(vsrtl::SimPort::PortType::in));
+        }
+    }
+
+    // Move wire points (must be done >after< the point has been associated with wires)
+    for (const auto& [point, pos] : wirePoints) {
+        point->setPos(gridToScene(pos));
+    }
+
+    setSerializing(false);
+    postSerializeInit();
+}
+
 SimComponent* WireGraphic::getParentComponent() const {
     return m_parent->getComponent();
 }
@@ -569,12 +681,16 @@ SimComponent* WireGraphic::getParentComponent() const {
 /**
  * @brief WireGraphic::postSceneConstructionInitialize1
  * With all ports and components created during circuit construction, wires may now register themselves with their
- * attached input- and output ports
+ * attached input- and output ports. Graphics of subcomponents are created upon first expanding a component, after
+ * which this is called again to connect the wire to any newly created sink ports.
  */
 void WireGraphic::postSceneConstructionInitialize1() {
+    std::vector<PortGraphic*> newSinks;
     std::function<void(SimPort*)> addGraphicToPort = [&](SimPort* portPtr) {
-        if (auto* portGraphic = portPtr->getGraphic<PortGraphic>()) {
-            m_toGraphicPorts.push_back(portGraphic);
+        auto* portGraphic = portPtr->getGraphic<PortGraphic>();
+        if (portGraphic &&
+            std::find(m_toGraphicPorts.begin(), m_toGraphicPorts.end(), portGraphic) == m_toGraphicPorts.end()) {
+            newSinks.push_back(portGraphic);
         }
         if (portPtr->type() == vsrtl::SimPort::PortType::signal) {
             for (auto toPort : portPtr->getOutputPorts()) {
@@ -590,7 +706,8 @@ void WireGraphic::postSceneConstructionInitialize1() {
 
     // Make the wire destination ports aware of this WireGraphic, and create wire segments between all source and sink
     // ports.
-    for (const auto& sink : m_toGraphicPorts) {
+    for (const auto& sink : newSinks) {
+        m_toGraphicPorts.push_back(sink);
         sink->setInputWire(this);
         // Create a rectilinear segment between the the closest point managed by this wire and the sink destination
         std::pair<qreal, PortPoint*> fromPoint;
@@ -4,6 +4,7 @@
 #include "vsrtl_graphics_util.h"
 #include "vsrtl_graphicsbaseitem.h"
 #include "vsrtl_portgraphic.h"
+#include "vsrtl_router.h"
 
 #include "cereal/cereal.hpp"
 #include "cereal/types/map.hpp"
@@ -145,6 +146,8 @@ public:
 
     void setWiresVisibleToPort(const PortPoint* p, bool visible);
     PortGraphic* getFromPort() const { return m_fromPort; }
+    /// Estimated number of bytes allocated for this wire, its points and its segments.
+    size_t memoryUsage() const;
     const std::vector<PortGraphic*>& getToPorts() const { return m_toGraphicPorts; }
     std::pair<WirePoint*, WireSegment*> createWirePointOnSeg(const QPointF scenePos, WireSegment* onSegment);
     void removeWirePoint(WirePoint* point);
@@ -157,6 +160,27 @@ public:
     void clearWirePoints();
     void clearWires();
 
+    /**
+     * @brief routingNet
+     * @returns the source and sinks of this wire as a net of the GridRouter, in the grid coordinates of the component
+     * which the wire lies within.
+     */
+    GridRouter::Net routingNet() const;
+
+    /**
+     * @brief currentRoute
+     * @returns the route formed by the current points and segments of this wire, in the order of getToPorts(). An empty
+     * route is returned if the segments do not form a tree connecting the source to all sinks.
+     */
+    RouteTree currentRoute() const;
+
+    /**
+     * @brief applyRoute
+     * Replaces the points and segments of this wire by @p route, as routed for the net returned by routingNet(). Sinks
+     * which were not connected by the route are connected directly to the source port.
+     */
+    void applyRoute(const RouteTree& route);
+
     bool managesPoint(WirePoint* point) const;
     void mergePoints(WirePoint* base, WirePoint* toMerge);
     MergeType canMergePoints(WirePoint* base, WirePoint* toMerge) const;
@@ -330,6 +354,8 @@ private:
     void moveWirePoint(PortPoint* point, const QPointF scenePos);
     WireSegment* createSegment(PortPoint* start, PortPoint* end);
     void createRectilinearSegments(PortPoint* start, PortPoint* end);
+    /// @returns the position of @p point in the grid coordinates of the component which this wire lies within.
+    QPoint gridPos(PortPoint* point) const;
 
     ComponentGraphic* m_parent = nullptr;
     PortGraphic* m_fromPort = nullptr;
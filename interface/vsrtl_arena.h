@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace vsrtl {
+
+/**
+ * @brief The ObjectArena class
+ * A monotonic allocator. Allocations are served by bumping an offset within the current chunk; once a chunk is
+ * exhausted, a new and larger chunk is allocated. Individual allocations are never released - all memory is released
+ * at once when the arena is destroyed. Objects placed in the arena must therefore be destroyed (but not deallocated)
+ * before the arena itself.
+ */
+class ObjectArena {
+public:
+    static constexpr size_t InitialChunkSize = 64 * 1024;
+    static constexpr size_t MaxChunkSize = 4 * 1024 * 1024;
+
+    ObjectArena() = default;
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        assert(alignment <= alignof(std::max_align_t) && "Over-aligned allocations are not supported");
+        size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+        if (m_chunks.empty() || offset + size > m_chunkSize) {
+            newChunk(size);
+            offset = 0;
+        }
+        void* ptr = m_chunks.back().get() + offset;
+        m_offset = offset + size;
+        m_bytesAllocated += size;
+        return ptr;
+    }
+
+    /// Number of bytes handed out by the arena
+    size_t bytesAllocated() const { return m_bytesAllocated; }
+    /// Number of bytes reserved from the system by the arena
+    size_t bytesReserved() const { return m_bytesReserved; }
+
+private:
+    void newChunk(size_t minSize) {
+        const size_t size = std::max(minSize, m_nextChunkSize);
+        // Memory returned by new[] is suitably aligned for any fundamental type
+        m_chunks.emplace_back(new char[size]);
+        m_chunkSize = size;
+        m_offset = 0;
+        m_bytesReserved += size;
+        m_nextChunkSize = std::min(m_nextChunkSize * 2, MaxChunkSize);
+    }
+
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+    size_t m_chunkSize = 0;
+    size_t m_offset = 0;
+    size_t m_nextChunkSize = InitialChunkSize;
+    size_t m_bytesAllocated = 0;
+    size_t m_bytesReserved = 0;
+};
+
+}  // namespace vsrtl
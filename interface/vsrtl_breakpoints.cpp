@@ -0,0 +1,206 @@
+#include "vsrtl_breakpoints.h"
+#include "vsrtl_footprint.h"
+#include "vsrtl_interface.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace vsrtl {
+
+uint32_t BreakpointEngine::addPortBreakpoint(SimPort& port, Condition condition, VSRTL_VT_U value) {
+    Breakpoint bp;
+    bp.kind = Kind::Port;
+    bp.port = &port;
+    bp.condition = condition;
+    bp.value = value;
+    const uint32_t id = add(bp);
+    m_portBreakpoints[&port].push_back(id);
+    port.m_watched = true;
+    return id;
+}
+
+uint32_t BreakpointEngine::addCycleBreakpoint(long long cycle) {
+    Breakpoint bp;
+    bp.kind = Kind::Cycle;
+    bp.cycle = cycle;
+    m_nextCycle = std::min(m_nextCycle, cycle);
+    return add(bp);
+}
+
+uint32_t BreakpointEngine::addWatchpoint(WatchableMemory& memory, VSRTL_VT_U address, unsigned size, Access access) {
+    if (size == 0) {
+        throw std::runtime_error("Watchpoints must cover at least a single byte");
+    }
+    Breakpoint bp;
+    bp.kind = Kind::Memory;
+    bp.memory = &memory;
+    bp.address = address;
+    bp.size = size;
+    bp.access = access;
+    const uint32_t id = add(bp);
+    m_memoryBreakpoints[&memory].push_back(id);
+    memory.m_watcher = this;
+    return id;
+}
+
+uint32_t BreakpointEngine::add(const Breakpoint& bp) {
+    const uint32_t id = m_nextId++;
+    m_breakpoints[id] = bp;
+    return id;
+}
+
+void BreakpointEngine::remove(uint32_t id) {
+    auto it = m_breakpoints.find(id);
+    if (it == m_breakpoints.end()) {
+        return;
+    }
+    const Breakpoint bp = it->second;
+    m_breakpoints.erase(it);
+
+    auto unindex = [id](auto& index, auto* key) {
+        auto& ids = index.at(key);
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        if (ids.empty()) {
+            index.erase(key);
+            return true;
+        }
+        return false;
+    };
+    switch (bp.kind) {
+        case Kind::Port:
+            if (unindex(m_portBreakpoints, bp.port)) {
+                bp.port->m_watched = false;
+            }
+            break;
+        case Kind::Memory:
+            if (unindex(m_memoryBreakpoints, bp.memory)) {
+                bp.memory->m_watcher = nullptr;
+            }
+            break;
+        case Kind::Cycle:
+            break;
+    }
+}
+
+void BreakpointEngine::clear() {
+    for (const auto& it : m_portBreakpoints) {
+        const_cast<SimPort*>(it.first)->m_watched = false;
+    }
+    for (const auto& it : m_memoryBreakpoints) {
+        const_cast<WatchableMemory*>(it.first)->m_watcher = nullptr;
+    }
+    m_breakpoints.clear();
+    m_portBreakpoints.clear();
+    m_memoryBreakpoints.clear();
+    m_nextCycle = LLONG_MAX;
+    m_hits.clear();
+}
+
+void BreakpointEngine::setEnabled(uint32_t id, bool enabled) {
+    auto& bp = m_breakpoints.at(id);
+    bp.enabled = enabled;
+    if (bp.kind == Kind::Cycle) {
+        rewind();
+    }
+}
+
+std::string BreakpointEngine::describe(uint32_t id) const {
+    const auto& bp = m_breakpoints.at(id);
+    std::stringstream ss;
+    switch (bp.kind) {
+        case Kind::Port:
+            ss << bp.port->getHierName();
+            if (bp.condition == Condition::Changes) {
+                ss << " changes";
+            } else {
+                ss << (bp.condition == Condition::Equals ? " == " : " != ") << bp.value;
+            }
+            break;
+        case Kind::Cycle:
+            ss << "cycle " << bp.cycle;
+            break;
+        case Kind::Memory:
+            ss << (bp.access == ReadWrite ? "access" : bp.access == Read ? "read" : "write") << " 0x" << std::hex
+               << bp.address;
+            if (bp.size > 1) {
+                ss << "-0x" << bp.address + bp.size - 1;
+            }
+            break;
+    }
+    return ss.str();
+}
+
+size_t BreakpointEngine::memoryUsage() const {
+    size_t bytes = footprint::treeBytes(m_breakpoints) + footprint::hashBytes(m_portBreakpoints) +
+                   footprint::hashBytes(m_memoryBreakpoints) + footprint::bytes(m_hits) +
+                   footprint::bytes(m_readHits);
+    for (const auto& it : m_portBreakpoints) {
+        bytes += footprint::bytes(it.second);
+    }
+    for (const auto& it : m_memoryBreakpoints) {
+        bytes += footprint::bytes(it.second);
+    }
+    return bytes;
+}
+
+void BreakpointEngine::rewind() {
+    m_nextCycle = LLONG_MAX;
+    for (const auto& [id, bp] : m_breakpoints) {
+        if (bp.kind == Kind::Cycle && bp.enabled) {
+            m_nextCycle = std::min(m_nextCycle, bp.cycle);
+        }
+    }
+}
+
+void BreakpointEngine::evaluatePort(SimPort& port) {
+    auto it = m_portBreakpoints.find(&port);
+    if (it == m_portBreakpoints.end()) {
+        return;
+    }
+    const VSRTL_VT_U value = port.uValue();
+    for (uint32_t id : it->second) {
+        const auto& bp = m_breakpoints.at(id);
+        if (!bp.enabled) {
+            continue;
+        }
+        if (bp.condition == Condition::Changes || (bp.condition == Condition::Equals) == (value == bp.value)) {
+            m_hits.push_back({id, m_cycle, value});
+        }
+    }
+}
+
+void BreakpointEngine::evaluateAccess(const WatchableMemory& memory, VSRTL_VT_U address, unsigned bytes,
+                                      Access access) {
+    auto it = m_memoryBreakpoints.find(&memory);
+    if (it == m_memoryBreakpoints.end()) {
+        return;
+    }
+    for (uint32_t id : it->second) {
+        const auto& bp = m_breakpoints.at(id);
+        if (bp.enabled && (bp.access & access) && address < bp.address + bp.size && bp.address < address + bytes) {
+            if (access == Read) {
+                if (std::find(m_readHits.begin(), m_readHits.end(), id) != m_readHits.end()) {
+                    continue;
+                }
+                m_readHits.push_back(id);
+            }
+            m_hits.push_back({id, m_cycle, address});
+        }
+    }
+}
+
+void BreakpointEngine::evaluateCycle(long long cycle) {
+    m_nextCycle = LLONG_MAX;
+    for (const auto& [id, bp] : m_breakpoints) {
+        if (bp.kind != Kind::Cycle || !bp.enabled) {
+            continue;
+        }
+        if (bp.cycle == cycle) {
+            m_hits.push_back({id, cycle, static_cast<VSRTL_VT_U>(cycle)});
+        } else if (bp.cycle > cycle) {
+            m_nextCycle = std::min(m_nextCycle, bp.cycle);
+        }
+    }
+}
+
+}  // namespace vsrtl
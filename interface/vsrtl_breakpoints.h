@@ -0,0 +1,164 @@
+#pragma once
+
+#include "vsrtl_defines.h"
+
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vsrtl {
+
+class SimPort;
+class BreakpointEngine;
+
+/**
+ * @brief The WatchableMemory class
+ * Base of memories which may be watched by a BreakpointEngine. Simulators notify the watcher of a memory (if any)
+ * whenever the memory is read or written by the design. Read ports access the memory every cycle, including when
+ * reading the same address as in the previous cycle.
+ */
+class WatchableMemory {
+public:
+    /// @returns the breakpoint engine watching this memory, or nullptr if no watchpoints are placed on the memory.
+    BreakpointEngine* watcher() const { return m_watcher; }
+
+private:
+    friend class BreakpointEngine;
+    BreakpointEngine* m_watcher = nullptr;
+};
+
+/**
+ * @brief The BreakpointEngine class
+ * Declarative breakpoints on port values, memory accesses and cycle counts. Rather than polling each condition every
+ * cycle, conditions are evaluated only when the watched port changes value or the watched memory is accessed; ports
+ * and memories without breakpoints incur no cost besides a flag test.
+ *
+ * Breakpoints fire while the design is being clocked; changes caused by resetting, reversing or forcing values do
+ * not trigger breakpoints. Fired breakpoints are recorded as hits, which remain until cleared. A simulation loop thus
+ * stops once triggered() is set after clocking the design.
+ */
+class BreakpointEngine {
+public:
+    enum class Condition {
+        /// The port changes value
+        Changes,
+        /// The port changes to a given value
+        Equals,
+        /// The port changes to any value but a given value
+        NotEquals
+    };
+
+    enum Access { Read = 0b01, Write = 0b10, ReadWrite = Read | Write };
+
+    struct Hit {
+        uint32_t id;
+        long long cycle;
+        /// The new value of the port, the accessed address or the cycle count, depending on the type of breakpoint
+        VSRTL_VT_U value;
+    };
+
+    BreakpointEngine() = default;
+    BreakpointEngine(const BreakpointEngine&) = delete;
+    BreakpointEngine& operator=(const BreakpointEngine&) = delete;
+
+    /**
+     * @brief addPortBreakpoint
+     * Breaks when @p port changes value and satisfies @p condition. Register breakpoints are placed on the output port
+     * of the register. @returns the id of the breakpoint.
+     */
+    uint32_t addPortBreakpoint(SimPort& port, Condition condition = Condition::Changes, VSRTL_VT_U value = 0);
+
+    /// Breaks once the cycle count of the design reaches @p cycle. @returns the id of the breakpoint.
+    uint32_t addCycleBreakpoint(long long cycle);
+
+    /**
+     * @brief addWatchpoint
+     * Breaks when the design accesses any of the @p size bytes starting at @p address within @p memory, through an
+     * access of type @p access. @returns the id of the breakpoint.
+     */
+    uint32_t addWatchpoint(WatchableMemory& memory, VSRTL_VT_U address, unsigned size = 1, Access access = ReadWrite);
+
+    void remove(uint32_t id);
+    void clear();
+    void setEnabled(uint32_t id, bool enabled);
+    bool isEnabled(uint32_t id) const { return m_breakpoints.at(id).enabled; }
+    size_t size() const { return m_breakpoints.size(); }
+
+    /// @returns a textual description of breakpoint @p id, ie. "acc_reg->out == 5".
+    std::string describe(uint32_t id) const;
+
+    bool triggered() const { return !m_hits.empty(); }
+    const std::vector<Hit>& hits() const { return m_hits; }
+    void clearHits() { m_hits.clear(); }
+
+    /// Estimated number of bytes allocated by the engine.
+    size_t memoryUsage() const;
+
+    /**
+     * Notifications from the simulator. Breakpoints only fire while the engine is armed, which the simulator does for
+     * the duration of clocking the design.
+     */
+    void arm(long long cycle) {
+        m_armed = true;
+        m_cycle = cycle;
+        m_readHits.clear();
+    }
+    void disarm() { m_armed = false; }
+    void portChanged(SimPort& port) {
+        if (m_armed) {
+            evaluatePort(port);
+        }
+    }
+    void memoryAccessed(const WatchableMemory& memory, VSRTL_VT_U address, unsigned bytes, Access access) {
+        if (m_armed) {
+            evaluateAccess(memory, address, bytes, access);
+        }
+    }
+    /// The design was reset or reversed; cycle breakpoints may fire again.
+    void rewind();
+    void cycleClocked(long long cycle) {
+        if (cycle >= m_nextCycle) {
+            evaluateCycle(cycle);
+        }
+    }
+
+private:
+    enum class Kind { Port, Cycle, Memory };
+
+    struct Breakpoint {
+        Kind kind;
+        bool enabled = true;
+        SimPort* port = nullptr;
+        Condition condition = Condition::Changes;
+        VSRTL_VT_U value = 0;
+        long long cycle = 0;
+        WatchableMemory* memory = nullptr;
+        VSRTL_VT_U address = 0;
+        unsigned size = 0;
+        Access access = ReadWrite;
+    };
+
+    uint32_t add(const Breakpoint& bp);
+    void evaluatePort(SimPort& port);
+    void evaluateAccess(const WatchableMemory& memory, VSRTL_VT_U address, unsigned bytes, Access access);
+    void evaluateCycle(long long cycle);
+
+    std::map<uint32_t, Breakpoint> m_breakpoints;
+    std::unordered_map<const SimPort*, std::vector<uint32_t>> m_portBreakpoints;
+    std::unordered_map<const WatchableMemory*, std::vector<uint32_t>> m_memoryBreakpoints;
+    /// Smallest cycle of any enabled cycle breakpoint
+    long long m_nextCycle = LLONG_MAX;
+    /// Cycle being clocked while armed
+    long long m_cycle = 0;
+    uint32_t m_nextId = 0;
+    bool m_armed = false;
+    std::vector<Hit> m_hits;
+    /// Watchpoints hit by reads within the cycle being clocked. A read port may be evaluated more than once per cycle,
+    /// so read watchpoints fire at most once per cycle.
+    std::vector<uint32_t> m_readHits;
+};
+
+}  // namespace vsrtl
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vsrtl {
+
+class SimComponent;
+
+/**
+ * Estimates of the heap memory owned by standard library containers, excluding the memory of the container object
+ * itself. Node based containers are assumed to allocate each element separately, with an overhead of the pointers of
+ * the node.
+ */
+namespace footprint {
+
+inline size_t bytes(const std::string& s) {
+    // Strings within the small string buffer do not allocate
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+template <typename T>
+size_t bytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+inline size_t bytes(const std::vector<bool>& v) {
+    return v.capacity() / 8;
+}
+
+template <typename T>
+size_t bytes(const std::deque<T>& d) {
+    // Elements are stored in fixed size blocks, which are referenced through a map of block pointers
+    constexpr size_t blockSize = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+    const size_t blocks = d.size() / blockSize + 1;
+    return blocks * blockSize * sizeof(T) + std::max<size_t>(8, blocks + 2) * sizeof(void*);
+}
+
+/// Ordered associative containers (std::set, std::map); each node holds three pointers and a color.
+template <typename C>
+size_t treeBytes(const C& c) {
+    return c.size() * (sizeof(typename C::value_type) + 4 * sizeof(void*));
+}
+
+/// Unordered associative containers; each node holds a next pointer and a cached hash, next to the bucket array.
+template <typename C>
+size_t hashBytes(const C& c) {
+    return c.size() * (sizeof(typename C::value_type) + 2 * sizeof(void*)) + c.bucket_count() * sizeof(void*);
+}
+
+}  // namespace footprint
+
+/**
+ * @brief The MemoryFootprint class
+ * An estimate of the memory used by a design, broken down by category and by component. Each component of the design
+ * is a node of the footprint, wherein a parent precedes its subcomponents. Memory is attributed to the component which
+ * owns it; memory which is shared by the design (ie. address spaces and elaboration structures) is attributed to the
+ * design itself. Totals are aggregated up through the hierarchy.
+ * The footprint is a snapshot; see SimDesign::getMemoryFootprint().
+ */
+class MemoryFootprint {
+public:
+    static constexpr uint32_t NoParent = UINT32_MAX;
+
+    enum Category {
+        /// Component objects, their names and port/subcomponent containers, as well as unused object arena memory
+        Components,
+        /// Port objects, their names and connections
+        Ports,
+        /// Propagation functions of ports
+        PropagationFunctions,
+        /// Reverse stacks of clocked components
+        ReverseStacks,
+        /// Contents of address spaces
+        AddressSpaces,
+        /// Initialization memories of address spaces, rewritten upon reset
+        InitializationMemories,
+        /// Netlist graph, propagation stack and hierarchy index of the design
+        Elaboration,
+        /// VCD file buffers, activity samples, profiles, breakpoints and value snapshots
+        Tracing,
+        /// Graphical objects of the graphics library, if any
+        ComponentGraphics,
+        PortGraphics,
+        WireGraphics,
+        NumCategories
+    };
+
+    static const char* categoryName(Category category) {
+        static const char* names[NumCategories] = {"components",
+                                                   "ports",
+                                                   "propagation functions",
+                                                   "reverse stacks",
+                                                   "address spaces",
+                                                   "initialization memories",
+                                                   "elaboration",
+                                                   "tracing",
+                                                   "component graphics",
+                                                   "port graphics",
+                                                   "wire graphics"};
+        return names[category];
+    }
+
+    struct Usage {
+        std::array<size_t, NumCategories> bytes = {};
+
+        size_t& operator[](Category category) { return bytes[category]; }
+        size_t operator[](Category category) const { return bytes[category]; }
+        Usage& operator+=(const Usage& other) {
+            for (int i = 0; i < NumCategories; ++i) {
+                bytes[i] += other.bytes[i];
+            }
+            return *this;
+        }
+        size_t total() const {
+            size_t sum = 0;
+            for (size_t b : bytes) {
+                sum += b;
+            }
+            return sum;
+        }
+    };
+
+    struct Node {
+        const SimComponent* component = nullptr;
+        std::string name;
+        uint32_t parent = NoParent;
+        /// Memory owned by this component, excluding subcomponents
+        Usage self;
+        /// Memory owned by this component and all of its subcomponents
+        Usage total;
+    };
+
+    /**
+     * @brief addNode
+     * Adds a component to the footprint. The parent of a component must be added before the component itself.
+     * @returns the index of the node.
+     */
+    uint32_t addNode(const SimComponent* component, const std::string& name, uint32_t parent) {
+        const uint32_t idx = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back({component, name, parent, {}, {}});
+        m_nodeIndex[component] = idx;
+        m_dirty = true;
+        return idx;
+    }
+
+    Usage& usage(uint32_t node) {
+        m_dirty = true;
+        return m_nodes.at(node).self;
+    }
+
+    /// Attributes @p bytes of category @p category to @p component, which must be part of the footprint.
+    void add(const SimComponent* component, Category category, size_t bytes) {
+        const uint32_t idx = nodeIndex(component);
+        if (idx == NoParent) {
+            throw std::runtime_error("Component is not part of the memory footprint");
+        }
+        usage(idx)[category] += bytes;
+    }
+
+    uint32_t nodeIndex(const SimComponent* component) const {
+        auto it = m_nodeIndex.find(component);
+        return it == m_nodeIndex.end() ? NoParent : it->second;
+    }
+
+    /// @returns all nodes of the footprint, with totals aggregated up through the hierarchy.
+    const std::vector<Node>& nodes() const {
+        aggregate();
+        return m_nodes;
+    }
+
+    /// @returns the node of @p component, or nullptr if @p component is not part of the footprint.
+    const Node* node(const SimComponent* component) const {
+        const uint32_t idx = nodeIndex(component);
+        return idx == NoParent ? nullptr : &nodes()[idx];
+    }
+
+    /// Memory used by all nodes of the footprint.
+    Usage total() const {
+        Usage sum;
+        for (const auto& n : nodes()) {
+            if (n.parent == NoParent) {
+                sum += n.total;
+            }
+        }
+        return sum;
+    }
+
+    /// @returns the hierarchical path of node @p idx.
+    std::string path(uint32_t idx, const char* separator = "->") const {
+        std::vector<uint32_t> stack;
+        for (uint32_t i = idx; i != NoParent; i = m_nodes[i].parent) {
+            stack.push_back(i);
+        }
+        std::string p;
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            if (!p.empty()) {
+                p += separator;
+            }
+            p += m_nodes[*it].name;
+        }
+        return p;
+    }
+
+    static std::string formatBytes(size_t bytes) {
+        static const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+        double value = static_cast<double>(bytes);
+        unsigned unit = 0;
+        while (value >= 1024 && unit < 4) {
+            value /= 1024;
+            unit++;
+        }
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), unit == 0 ? "%.0f %s" : "%.1f %s", value, units[unit]);
+        return buf;
+    }
+
+    /**
+     * @brief print
+     * Prints the total footprint by category, followed by the footprint of each component down to a hierarchy depth of
+     * @p maxDepth.
+     */
+    void print(std::ostream& os, unsigned maxDepth = UINT32_MAX) const {
+        const auto sum = total();
+        char line[256];
+        std::snprintf(line, sizeof(line), "Memory footprint: %s\n", formatBytes(sum.total()).c_str());
+        os << line;
+        for (int c = 0; c < NumCategories; ++c) {
+            if (sum.bytes[c] != 0) {
+                std::snprintf(line, sizeof(line), "  %-24s %12s\n", categoryName(static_cast<Category>(c)),
+                              formatBytes(sum.bytes[c]).c_str());
+                os << line;
+            }
+        }
+        std::snprintf(line, sizeof(line), "%12s %12s  %s\n", "total", "self", "component");
+        os << line;
+        const auto& all = nodes();
+        std::vector<unsigned> depths(all.size(), 0);
+        for (uint32_t i = 0; i < all.size(); ++i) {
+            depths[i] = all[i].parent == NoParent ? 0 : depths[all[i].parent] + 1;
+            if (depths[i] > maxDepth) {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "%12s %12s  ", formatBytes(all[i].total.total()).c_str(),
+                          formatBytes(all[i].self.total()).c_str());
+            os << line << std::string(depths[i] * 2, ' ') << all[i].name << "\n";
+        }
+    }
+
+    /**
+     * @brief writeCsv
+     * Writes the footprint as CSV; one row per component, holding the memory of each category owned by the component
+     * itself followed by the total memory of the component and its subcomponents.
+     */
+    void writeCsv(std::ostream& os) const {
+        os << "component";
+        for (int c = 0; c < NumCategories; ++c) {
+            std::string name = categoryName(static_cast<Category>(c));
+            std::replace(name.begin(), name.end(), ' ', '_');
+            os << "," << name;
+        }
+        os << ",total\n";
+        const auto& all = nodes();
+        for (uint32_t i = 0; i < all.size(); ++i) {
+            os << path(i);
+            for (size_t b : all[i].self.bytes) {
+                os << "," << b;
+            }
+            os << "," << all[i].total.total() << "\n";
+        }
+    }
+
+private:
+    void aggregate() const {
+        if (!m_dirty) {
+            return;
+        }
+        for (auto& n : m_nodes) {
+            n.total = n.self;
+        }
+        // Parents precede their subcomponents; accumulate in reverse
+        for (auto it = m_nodes.rbegin(); it != m_nodes.rend(); ++it) {
+            if (it->parent != NoParent) {
+                m_nodes[it->parent].total += it->total;
+            }
+        }
+        m_dirty = false;
+    }
+
+    mutable std::vector<Node> m_nodes;
+    std::unordered_map<const SimComponent*, uint32_t> m_nodeIndex;
+    mutable bool m_dirty = false;
+};
+
+}  // namespace vsrtl
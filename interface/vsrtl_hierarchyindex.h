@@ -0,0 +1,137 @@
+#pragma once
+
+#include "vsrtl_footprint.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vsrtl {
+
+class SimBase;
+
+/**
+ * @brief globMatch
+ * Matches @p text against @p pattern, wherein '*' matches any (possibly empty) sequence of characters and '?' matches
+ * any single character.
+ */
+inline bool globMatch(std::string_view pattern, std::string_view text) {
+    size_t p = 0, t = 0;
+    size_t starP = std::string_view::npos, starT = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            p++;
+            t++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            // Initially let the wildcard match the empty sequence; backtrack to here upon a mismatch
+            starP = p++;
+            starT = t;
+        } else if (starP != std::string_view::npos) {
+            p = starP + 1;
+            t = ++starT;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+/**
+ * @brief The HierarchyIndex class
+ * Maps the hierarchical paths of the components and ports of a design (see SimBase::getHierName()) to the objects
+ * themselves. Paths are not copied; the index refers to the hierarchical names cached within each object, and is thus
+ * only valid for as long as the indexed objects are alive.
+ * Exact lookups are served through hash maps, whereas prefix and glob queries are served through a sorted list of
+ * paths. Glob queries are narrowed down to the range of paths sharing the literal prefix of the pattern.
+ */
+class HierarchyIndex {
+public:
+    enum Kind { Component = 0b01, Port = 0b10, Any = 0b11 };
+
+    struct Entry {
+        std::string_view path;
+        SimBase* object;
+        Kind kind;
+    };
+
+    void clear() {
+        m_entries.clear();
+        m_components.clear();
+        m_ports.clear();
+    }
+
+    void add(std::string_view path, SimBase* object, Kind kind) { m_entries.push_back({path, object, kind}); }
+
+    /// Builds the lookup structures of the index. Must be called after all objects have been added.
+    void finalize() {
+        m_components.reserve(m_entries.size());
+        m_ports.reserve(m_entries.size());
+        for (const auto& e : m_entries) {
+            (e.kind == Component ? m_components : m_ports).emplace(e.path, e.object);
+        }
+        std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) { return a.path < b.path; });
+    }
+
+    SimBase* find(std::string_view path, Kind kind) const {
+        const auto& map = kind == Component ? m_components : m_ports;
+        auto it = map.find(path);
+        return it == map.end() ? nullptr : it->second;
+    }
+
+    /**
+     * @brief findPrefix
+     * @returns all objects of type @p kind whose path starts with @p prefix, sorted by path.
+     */
+    std::vector<const Entry*> findPrefix(std::string_view prefix, Kind kind = Any) const {
+        std::vector<const Entry*> results;
+        for (auto it = lowerBound(prefix); it != m_entries.end() && startsWith(it->path, prefix); ++it) {
+            if (it->kind & kind) {
+                results.push_back(&*it);
+            }
+        }
+        return results;
+    }
+
+    /**
+     * @brief findGlob
+     * @returns all objects of type @p kind whose path matches @p pattern (see globMatch()), sorted by path.
+     */
+    std::vector<const Entry*> findGlob(std::string_view pattern, Kind kind = Any) const {
+        const std::string_view prefix = pattern.substr(0, pattern.find_first_of("*?"));
+        std::vector<const Entry*> results;
+        for (auto it = lowerBound(prefix); it != m_entries.end() && startsWith(it->path, prefix); ++it) {
+            if ((it->kind & kind) && globMatch(pattern, it->path)) {
+                results.push_back(&*it);
+            }
+        }
+        return results;
+    }
+
+    const std::vector<Entry>& entries() const { return m_entries; }
+    size_t size() const { return m_entries.size(); }
+
+    /// Estimated number of bytes allocated by the index.
+    size_t memoryUsage() const {
+        return footprint::bytes(m_entries) + footprint::hashBytes(m_components) + footprint::hashBytes(m_ports);
+    }
+
+private:
+    static bool startsWith(std::string_view s, std::string_view prefix) {
+        return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    std::vector<Entry>::const_iterator lowerBound(std::string_view path) const {
+        return std::lower_bound(m_entries.begin(), m_entries.end(), path,
+                                [](const Entry& e, std::string_view p) { return e.path < p; });
+    }
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string_view, SimBase*> m_components;
+    std::unordered_map<std::string_view, SimBase*> m_ports;
+};
+
+}  // namespace vsrtl
@@ -1,11 +1,58 @@
 #include "vsrtl_interface.h"
 
+#include <cctype>
+#include <string_view>
+
 namespace vsrtl {
+
+namespace {
+/// Prefixes all allocations of simulator objects; aligned such that the object following the header is aligned.
+struct alignas(std::max_align_t) AllocationHeader {
+    size_t size;
+    bool inArena;
+};
+
+void* initializeHeader(AllocationHeader* header, size_t size, bool inArena) {
+    header->size = sizeof(AllocationHeader) + size;
+    header->inArena = inArena;
+    return header + 1;
+}
+}  // namespace
+
+void* SimBase::operator new(size_t size) {
+    auto* header = static_cast<AllocationHeader*>(::operator new(sizeof(AllocationHeader) + size));
+    return initializeHeader(header, size, false);
+}
+
+void* SimBase::operator new(size_t size, ObjectArena& arena) {
+    auto* header = static_cast<AllocationHeader*>(arena.allocate(sizeof(AllocationHeader) + size));
+    return initializeHeader(header, size, true);
+}
+
+void SimBase::operator delete(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+    if (!header->inArena) {
+        ::operator delete(header);
+    }
+}
+
+void SimBase::operator delete(void*, ObjectArena&) {
+    // Arena memory is released by the arena
+}
+
+void SimBase::recordAllocation() {
+    // The allocation holds the most derived object, which the header precedes
+    m_allocatedSize = (static_cast<const AllocationHeader*>(dynamic_cast<const void*>(this)) - 1)->size;
+}
+
 void SimPort::queueVcdVarChange() {
     getDesign()->queueVcdVarChange(this);
 }
 
-SimDesign* SimBase::getDesign() {
+SimDesign* SimBase::getDesign() const {
     if (m_design)
         return m_design;
 
@@ -14,7 +61,7 @@ SimDesign* SimBase::getDesign() {
     // Recurse until locating a parent which either has its SimDesign set, or the component has no parent (ie. it is the
     // design)
     if (!m_parent) {
-        m_design = dynamic_cast<SimDesign*>(this);
+        m_design = dynamic_cast<SimDesign*>(const_cast<SimBase*>(this));
     } else {
         m_design = m_parent->getDesign();
     }
@@ -22,4 +69,168 @@ SimDesign* SimBase::getDesign() {
 
     return m_design;
 }
+void SimPort::accountMemory(MemoryFootprint::Usage& usage) const {
+    usage[MemoryFootprint::Ports] += allocatedSize() + footprint::bytes(m_name) + footprint::bytes(m_displayName) +
+                                     footprint::bytes(m_description) + footprint::bytes(m_hierName) +
+                                     footprint::bytes(m_vcdId) + footprint::bytes(m_outputPorts);
+}
+
+void SimComponent::accountMemory(MemoryFootprint::Usage& usage) const {
+    size_t bytes = allocatedSize() + footprint::bytes(m_name) + footprint::bytes(m_displayName) +
+                   footprint::bytes(m_description) + footprint::bytes(m_hierName);
+    bytes += footprint::treeBytes(m_inputPorts) + footprint::treeBytes(m_outputPorts) +
+             footprint::treeBytes(m_signals) + footprint::treeBytes(m_subcomponents) +
+             footprint::treeBytes(m_parameters) + footprint::treeBytes(m_specialPorts);
+    bytes += footprint::hashBytes(m_portIndex) + footprint::hashBytes(m_subcomponentIndex) +
+             footprint::hashBytes(m_parameterIndex);
+    usage[MemoryFootprint::Components] += bytes;
+}
+
+void SimDesign::accountMemory(MemoryFootprint::Usage& usage) const {
+    SimComponent::accountMemory(usage);
+    // Memory reserved by the object arena which has yet to be handed out
+    usage[MemoryFootprint::Components] += m_objectArena.bytesReserved() - m_objectArena.bytesAllocated();
+    usage[MemoryFootprint::Elaboration] += m_hierarchyIndex.memoryUsage() + footprint::bytes(m_ports);
+    usage[MemoryFootprint::Tracing] += footprint::treeBytes(m_vcdVarChangeQueue) + footprint::bytes(m_activitySamples) +
+                                       m_breakpoints.memoryUsage() + m_snapshot.memoryUsage();
+    if (m_vcdFile) {
+        usage[MemoryFootprint::Tracing] += sizeof(VCDFile) + m_vcdFile->memoryUsage();
+    }
+}
+
+MemoryFootprint SimDesign::getMemoryFootprint() const {
+    MemoryFootprint fp;
+    // Visit parents before their subcomponents
+    std::vector<std::pair<const SimComponent*, uint32_t>> stack = {{this, MemoryFootprint::NoParent}};
+    while (!stack.empty()) {
+        const auto [c, parent] = stack.back();
+        stack.pop_back();
+        const uint32_t idx = fp.addNode(c, c->getName(), parent);
+        auto& usage = fp.usage(idx);
+        c->accountMemory(usage);
+        for (const auto* ports : {&c->m_inputPorts, &c->m_outputPorts, &c->m_signals}) {
+            for (const auto& p : *ports) {
+                p->accountMemory(usage);
+            }
+        }
+        for (auto it = c->m_subcomponents.rbegin(); it != c->m_subcomponents.rend(); ++it) {
+            stack.push_back({it->get(), idx});
+        }
+    }
+    return fp;
+}
+
+namespace {
+/// Escapes characters which are not valid within SAIF identifiers.
+std::string saifIdentifier(const std::string& name) {
+    std::string id;
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            id += '\\';
+        }
+        id += c;
+    }
+    return id;
+}
+
+/// Quotes a CSV field as per RFC 4180, doubling any quotes within it.
+std::string csvField(std::string_view field) {
+    std::string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+/// Writes the SAIF instances of @p top and its subcomponents. Constant ports are omitted, as in the CSV report.
+void writeSaifInstances(std::ostream& os, SimComponent* top) {
+    struct Frame {
+        SimComponent* component;
+        unsigned indent;
+        /// Closes the instance of the component, once all of its subcomponents have been written
+        bool close;
+    };
+    std::vector<Frame> stack = {{top, 0, false}};
+    while (!stack.empty()) {
+        const Frame frame = stack.back();
+        stack.pop_back();
+        const std::string pad(frame.indent * 2, ' ');
+        if (frame.close) {
+            os << pad << ")\n";
+            continue;
+        }
+
+        os << pad << "(INSTANCE " << saifIdentifier(frame.component->getName()) << "\n";
+        std::vector<const SimPort*> ports;
+        for (const auto* port : frame.component->getAllPorts()) {
+            if (!port->isConstant()) {
+                ports.push_back(port);
+            }
+        }
+        if (!ports.empty()) {
+            os << pad << "  (NET\n";
+            for (const auto* port : ports) {
+                os << pad << "    (" << saifIdentifier(port->getName()) << " (TC " << port->bitFlipCount() << "))\n";
+            }
+            os << pad << "  )\n";
+        }
+        stack.push_back({frame.component, frame.indent, true});
+        const auto subcomponents = frame.component->getSubComponents();
+        for (auto it = subcomponents.rbegin(); it != subcomponents.rend(); ++it) {
+            stack.push_back({*it, frame.indent + 1, false});
+        }
+    }
+}
+}  // namespace
+
+void SimDesign::resetActivity() {
+    std::vector<SimComponent*> stack = {this};
+    while (!stack.empty()) {
+        auto* c = stack.back();
+        stack.pop_back();
+        for (auto* p : c->getAllPorts()) {
+            p->resetActivity();
+        }
+        for (auto* sc : c->getSubComponents()) {
+            stack.push_back(sc);
+        }
+    }
+    m_activity = ActivityCounters();
+    m_activityWindowStart = ActivityCounters();
+    m_activitySamples.clear();
+}
+
+void SimDesign::writeActivityCsv(std::ostream& os) const {
+    const double cycles = m_activity.cycles;
+    os << "net,width,toggles,bit_flips,toggle_rate,bit_flip_rate\n";
+    for (const auto& entry : m_hierarchyIndex.entries()) {
+        if (entry.kind != HierarchyIndex::Port) {
+            continue;
+        }
+        const auto* port = static_cast<const SimPort*>(entry.object);
+        if (port->isConstant()) {
+            continue;
+        }
+        os << csvField(entry.path) << "," << port->getWidth() << "," << port->toggleCount() << ","
+           << port->bitFlipCount() << "," << (cycles ? port->toggleCount() / cycles : 0.0) << ","
+           << (cycles ? port->bitFlipCount() / cycles : 0.0) << "\n";
+    }
+}
+
+void SimDesign::writeActivitySaif(std::ostream& os) const {
+    os << "(SAIFILE\n"
+       << "(SAIFVERSION \"2.0\")\n"
+       << "(DIRECTION \"backward\")\n"
+       << "(DESIGN \"" << getName() << "\")\n"
+       << "(PROGRAM_NAME \"VSRTL\")\n"
+       << "(TIMESCALE 1 ns)\n"
+       << "(DURATION " << m_activity.cycles << ")\n";
+    // The SAIF writer only reads the design hierarchy, which is not exposed through a const interface
+    writeSaifInstances(os, const_cast<SimDesign*>(this));
+    os << ")\n";
+}
+
 }  // namespace vsrtl
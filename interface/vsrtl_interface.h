@@ -2,19 +2,32 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <climits>
 #include <functional>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <set>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "Signal.h"
+#include "vsrtl_arena.h"
+#include "vsrtl_breakpoints.h"
+#include "vsrtl_footprint.h"
 #include "vsrtl_defines.h"
 #include "vsrtl_gfxobjecttypes.h"
+#include "vsrtl_hierarchyindex.h"
 #include "vsrtl_parameter.h"
+#include "vsrtl_profiler.h"
+#include "vsrtl_snapshot.h"
 #include "vsrtl_vcdfile.h"
 
 namespace vsrtl {
@@ -28,10 +41,39 @@ class SimSynchronous;
 
 class SimBase {
 public:
-    SimBase(const std::string& name, SimBase* parent) : m_name(name), m_parent(parent) {}
+    SimBase(const std::string& name, SimBase* parent) : m_name(name), m_parent(parent) {
+        if (m_parent) {
+            m_arena = m_parent->m_arena;
+        }
+    }
     virtual ~SimBase() {}
 
-    SimDesign* getDesign();
+    /**
+     * Simulator objects may be allocated within the object arena of the design which they are part of (see
+     * SimDesign::m_objectArena). Each allocation is prefixed by a header recording whether the object resides in an
+     * arena, such that deleting an object (ie. through std::unique_ptr) releases heap allocated memory, whereas arena
+     * allocated memory is left for the arena to release.
+     */
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, ObjectArena& arena);
+    static void operator delete(void* ptr);
+    static void operator delete(void* ptr, ObjectArena& arena);
+
+    /**
+     * @brief recordAllocation
+     * Records the size of the allocation made for this object through SimBase::operator new, read from the header of
+     * the allocation. Called by the creator of the object once constructed (see SimComponent::create_component()).
+     * @pre this object was allocated through SimBase::operator new.
+     */
+    void recordAllocation();
+    /**
+     * @brief allocatedSize
+     * @returns the number of bytes allocated for this object through SimBase::operator new, or 0 if no allocation has
+     * been recorded for this object (ie. for members or objects on the stack).
+     */
+    size_t allocatedSize() const { return m_allocatedSize; }
+
+    SimDesign* getDesign() const;
 
     template <typename T = std::runtime_error>
     void throwError(const std::string& message) const {
@@ -41,12 +83,18 @@ public:
     const std::string& getName() const { return m_name; }
     const std::string& getDisplayName() const { return m_displayName.empty() ? m_name : m_displayName; }
     const std::string& getDescription() const { return m_description; }
-    const std::string getHierName() const {
-        if (m_parent) {
-            return m_parent->getHierName() + "->" + getName();
-        } else {
-            return getName();
+    /**
+     * @brief getHierName
+     * @returns the hierarchical path of this object, ie. "design->component->port". The name is computed upon first
+     * access and cached thereafter. The hierarchy index of a design (see SimDesign::getHierarchyIndex()) computes the
+     * names of all objects within the design during verifyAndInitialize(), after which this function is safe to call
+     * from any thread.
+     */
+    const std::string& getHierName() const {
+        if (m_hierName.empty()) {
+            m_hierName = m_parent ? m_parent->getHierName() + "->" + getName() : getName();
         }
+        return m_hierName;
     }
 
     template <typename T = SimBase>
@@ -75,14 +123,22 @@ protected:
     std::string m_name;
     /// Parent of this component.
     SimBase* m_parent = nullptr;
-    /// Cached pointer to the top-level design.
-    SimDesign* m_design = nullptr;
+    /// Cached pointer to the top-level design. Set for all objects of a design during verifyAndInitialize().
+    mutable SimDesign* m_design = nullptr;
     /// Display name of this component. If set, a UI should prefer showing this name over m_name.
     std::string m_displayName;
     /// An optional description of this component.
     std::string m_description;
     /// An opaque pointer to a graphical counterpart to this component.
     void* m_graphicObject = nullptr;
+    /// Arena which child objects of this object are allocated within. Inherited from the parent upon construction.
+    ObjectArena* m_arena = nullptr;
+    /// Cached hierarchical name of this object.
+    mutable std::string m_hierName;
+
+private:
+    /// Size of the allocation made through SimBase::operator new, or 0 if not recorded; see recordAllocation().
+    size_t m_allocatedSize = 0;
 };
 
 template <typename T>
@@ -95,6 +151,7 @@ struct BaseSorter {
 
 class SimPort : public SimBase {
     friend class SimDesign;
+    friend class BreakpointEngine;
 
 public:
     enum class PortType { in, out, signal };
@@ -121,7 +178,7 @@ public:
     template <typename T = SimPort>
     T* getInputPort() {
         static_assert(std::is_base_of<SimPort, T>::value, "Must cast to a simulator-specific port type");
-        return m_inputPort->cast<T>();
+        return m_inputPort ? m_inputPort->cast<T>() : nullptr;
     }
 
     virtual bool isConstant() const = 0;
@@ -198,19 +255,60 @@ public:
      */
     virtual bool isEnumPort() const { return false; }
     virtual std::string valueToEnumString() const { throw std::runtime_error("This is not an enum port!"); }
+    virtual std::string valueToEnumString(VSRTL_VT_U) const { throw std::runtime_error("This is not an enum port!"); }
     virtual VSRTL_VT_U enumStringToValue(const char*) const { throw std::runtime_error("This is not an enum port!"); }
     const std::string& vcdId() const { return m_vcdId; }
     PortType type() const { return m_type; }
 
+    /**
+     * @brief toggleCount, bitFlipCount
+     * Switching activity of this port, recorded while activity tracking of the design is enabled (see
+     * SimDesign::setActivityTracking()); the number of changes of the port value, and the total number of bits flipped
+     * by these changes.
+     */
+    uint64_t toggleCount() const { return m_toggles; }
+    uint64_t bitFlipCount() const { return m_bitFlips; }
+    void resetActivity() {
+        m_toggles = 0;
+        m_bitFlips = 0;
+    }
+
+    /// Whether breakpoints are placed on this port; see BreakpointEngine.
+    bool isWatched() const { return m_watched; }
+
+    /// Index of this port within the ports of its design; see SimDesign::getPorts().
+    uint32_t ordinal() const { return m_ordinal; }
+
+    /**
+     * @brief observedValue
+     * The value of this port as presented to observers of the design. While the design is running on another thread
+     * with live snapshots enabled (see SimDesign::setLiveSnapshots()), this is the value within the latest acquired
+     * snapshot of the design; otherwise, the current value of the port.
+     */
+    inline VSRTL_VT_U observedValue() const;
+
+    /**
+     * @brief accountMemory
+     * Adds the memory owned by this port to @p usage; see SimDesign::getMemoryFootprint().
+     */
+    virtual void accountMemory(MemoryFootprint::Usage& usage) const;
+
     Gallant::Signal0<> changed;
 
 protected:
+    /// Records a change of the value of this port, wherein @p flipped holds the bits which changed.
+    inline void recordActivity(SimDesign* design, VSRTL_VT_U flipped);
+
     std::vector<SimPort*> m_outputPorts;
     SimPort* m_inputPort = nullptr;
+    uint64_t m_toggles = 0;
+    uint64_t m_bitFlips = 0;
 
 private:
     void queueVcdVarChange();
     bool m_traversingConnection = false;
+    bool m_watched = false;
+    uint32_t m_ordinal = 0;
     std::string m_vcdId;
     /**
      * @brief m_type
@@ -230,6 +328,8 @@ struct NoPredicate {};
 }  // namespace
 
 class SimComponent : public SimBase {
+    friend class SimDesign;
+
 public:
     using PortBaseCompT = BaseSorter<std::unique_ptr<SimPort>>;
     using ComponentCompT = BaseSorter<std::unique_ptr<SimComponent>>;
@@ -305,26 +405,32 @@ public:
 
     template <typename T = SimPort>
     T* findPort(const std::string& name) const {
-        T* p_ptr = nullptr;
-        for (const auto& p : getAllPorts<T>()) {
-            if (p->getName() == name) {
-                p_ptr = p;
-                break;
-            }
+        static_assert(std::is_base_of<SimPort, T>::value, "Must cast to a simulator-specific port type");
+        auto it = m_portIndex.find(name);
+        if (it == m_portIndex.end()) {
+            return nullptr;
+        }
+        return it->second->template cast<T>();
+    }
+
+    template <typename T = SimComponent>
+    T* findSubcomponent(const std::string& name) const {
+        static_assert(std::is_base_of<SimComponent, T>::value, "Must cast to a simulator-specific component type");
+        auto it = m_subcomponentIndex.find(name);
+        if (it == m_subcomponentIndex.end()) {
+            return nullptr;
         }
-        return p_ptr;
+        return it->second->template cast<T>();
     }
 
     template <typename T = SimPort>
     T* findSignal(const std::string& name) const {
-        T* p_ptr = nullptr;
-        for (const auto& p : getSignals<T>()) {
-            if (p->getName() == name) {
-                p_ptr = p;
-                break;
-            }
+        static_assert(std::is_base_of<SimPort, T>::value, "Must cast to a simulator-specific port type");
+        auto it = m_portIndex.find(name);
+        if (it == m_portIndex.end() || it->second->type() != SimPort::PortType::signal) {
+            return nullptr;
         }
-        return p_ptr;
+        return it->second->template cast<T>();
     }
 
     template <typename T = SimPort>
@@ -411,9 +517,11 @@ public:
     template <typename T, typename... Args>
     T* create_component(const std::string& name, Args... args) {
         verifyIsUniqueComponentName(name);
-        auto sptr = std::make_unique<T>(name, this, args...);
+        std::unique_ptr<T> sptr(m_arena ? new (*m_arena) T(name, this, args...) : new T(name, this, args...));
         auto* ptr = sptr.get();
+        ptr->recordAllocation();
         m_subcomponents.emplace(std::move(sptr));
+        m_subcomponentIndex.emplace(ptr->getName(), ptr);
         return ptr->template cast<T>();
     }
 
@@ -433,6 +541,7 @@ public:
         auto sptr = std::make_unique<Parameter<T>>(name, value);
         auto* ptr = sptr.get();
         m_parameters.emplace(std::move(sptr));
+        m_parameterIndex.emplace(ptr->getName());
         return *ptr;
     }
 
@@ -445,32 +554,26 @@ public:
     }
 
     void verifyIsUniquePortName(const std::string& name) {
-        if (!(isUniqueName(name, m_outputPorts) && isUniqueName(name, m_inputPorts))) {
+        if (m_portIndex.count(name) != 0) {
             throw std::runtime_error("Duplicate port name: '" + name + "' in component: '" + getName() +
                                      "'. Port names must be unique.");
         }
     }
 
     void verifyIsUniqueComponentName(const std::string& name) {
-        if (!isUniqueName(name, m_subcomponents)) {
+        if (m_subcomponentIndex.count(name) != 0) {
             throw std::runtime_error("Duplicate subcomponent name: '" + name + "' in component: '" + getName() +
                                      "'. Subcomponent names must be unique.");
         }
     }
 
     void verifyIsUniqueParameterName(const std::string& name) {
-        if (!isUniqueName(name, m_parameters)) {
+        if (m_parameterIndex.count(name) != 0) {
             throw std::runtime_error("Duplicate parameter name: '" + name + "' in component: '" + getName() +
                                      "'. Parameter names must be unique.");
         }
     }
 
-    template <typename T, typename C_T>
-    bool isUniqueName(const std::string& name, std::set<std::unique_ptr<T>, C_T>& container) {
-        return std::find_if(container.begin(), container.end(),
-                            [name](const auto& p) { return p->getName() == name; }) == container.end();
-    }
-
     void writeScope(VCDFile& file) {
         auto d = file.scopeDef(getName());
         for (const auto& p : getAllPorts()) {
@@ -501,6 +604,13 @@ public:
     bool isSynchronous() const { return m_synchronous != nullptr; }
     SimSynchronous* getSynchronous() { return m_synchronous; }
 
+    /**
+     * @brief accountMemory
+     * Adds the memory owned by this component, excluding its ports and subcomponents, to @p usage. Components owning
+     * additional memory (ie. reverse stacks) should extend this function; see SimDesign::getMemoryFootprint().
+     */
+    virtual void accountMemory(MemoryFootprint::Usage& usage) const;
+
     Gallant::Signal0<> changed;
 
 protected:
@@ -514,9 +624,39 @@ protected:
     std::set<std::unique_ptr<ParameterBase>> m_parameters;
     std::map<std::string, SimPort*> m_specialPorts;
 
+    /**
+     * Name indexes of the input/output ports, subcomponents and parameters of this component, for constant time
+     * uniqueness checks and lookups. Keys are views of the name of the indexed object, and are valid for as long as
+     * the object is owned by this component.
+     */
+    std::unordered_map<std::string_view, SimPort*> m_portIndex;
+    std::unordered_map<std::string_view, SimComponent*> m_subcomponentIndex;
+    std::unordered_set<std::string_view> m_parameterIndex;
+
+    /**
+     * @brief indexPort
+     * Registers @p port in the port name index. Must be called for any port added to m_inputPorts, m_outputPorts or
+     * m_signals.
+     */
+    void indexPort(SimPort* port) { m_portIndex.emplace(port->getName(), port); }
+
+    /**
+     * @brief destroyChildren
+     * Destroys all ports and subcomponents of this component.
+     */
+    void destroyChildren() {
+        m_portIndex.clear();
+        m_subcomponentIndex.clear();
+        m_subcomponents.clear();
+        m_inputPorts.clear();
+        m_outputPorts.clear();
+        m_signals.clear();
+    }
+
 private:
     unsigned m_constantCount = 0;  // Number of constants currently initialized in the component
     SimSynchronous* m_synchronous = nullptr;
+    bool m_changePending = false;  // Set while the component is queued for emitting its changed signal
 };
 
 /**
@@ -543,9 +683,14 @@ private:
 };
 
 class SimDesign : public SimComponent {
+    friend class SimPort;
+
 public:
-    SimDesign(const std::string& name, SimBase* parent) : SimComponent(name, parent) {}
-    virtual ~SimDesign() {}
+    SimDesign(const std::string& name, SimBase* parent) : SimComponent(name, parent) { m_arena = &m_objectArena; }
+    virtual ~SimDesign() {
+        // Objects of the design may reside in the object arena, and must be destroyed before the arena itself.
+        destroyChildren();
+    }
     /**
      * @brief clock
      * Simulates clocking the circuit. Registers are clocked and the propagation algorithm is run
@@ -564,6 +709,17 @@ public:
         if (vcdDump()) {
             dumpVcdVarChanges();
         }
+
+        m_breakpoints.cycleClocked(getCycleCount());
+
+        if (m_activityTracking) {
+            m_activity.cycles++;
+            if (m_activityWindow != 0 && m_activity.cycles % m_activityWindow == 0) {
+                m_activitySamples.push_back({getCycleCount(), m_activity.toggles - m_activityWindowStart.toggles,
+                                             m_activity.bitFlips - m_activityWindowStart.bitFlips});
+                m_activityWindowStart = m_activity;
+            }
+        }
     }
 
     /**
@@ -579,6 +735,7 @@ public:
         if (clockedSignalsEnabled()) {
             designWasReversed.Emit();
         }
+        m_breakpoints.rewind();
     }
 
     /**
@@ -604,6 +761,7 @@ public:
         if (m_dumpVcdFiles) {
             resetVcdFile();
         }
+        m_breakpoints.rewind();
     }
 
     /**
@@ -616,9 +774,64 @@ public:
      * @brief verifyAndInitialize
      * Any post-construction initialization should be included in this function.
      */
-    virtual void verifyAndInitialize() { m_isVerifiedAndInitialized = true; }
+    virtual void verifyAndInitialize() {
+        indexHierarchy();
+        m_isVerifiedAndInitialized = true;
+    }
     bool isVerifiedAndInitialized() const { return m_isVerifiedAndInitialized; }
 
+    /**
+     * @brief setProfilingEnabled
+     * Enables profiling of the design, if supported by the simulator library.
+     */
+    virtual void setProfilingEnabled(bool) {}
+
+    /**
+     * @brief getProfiler
+     * @returns the evaluation profile of the design, or nullptr if profiling is not enabled.
+     */
+    virtual const Profiler* getProfiler() const { return nullptr; }
+
+    /**
+     * @brief observedProfiler
+     * @returns the profiler of the design (see getProfiler()), if it may be read by observers. While the design is
+     * simulated on another thread (see setLiveSnapshots()), the profile is being written by that thread and nullptr is
+     * returned.
+     */
+    const Profiler* observedProfiler() const { return liveSnapshots() ? nullptr : getProfiler(); }
+
+    /**
+     * @brief getHierarchyIndex
+     * @returns an index of the hierarchical paths of all components and ports within the design.
+     * @pre the design has been verified and initialized.
+     */
+    const HierarchyIndex& getHierarchyIndex() const { return m_hierarchyIndex; }
+
+    /**
+     * @brief findPortByPath
+     * @returns the port with the hierarchical path @p path, ie. "design->component->port", or nullptr if no such port
+     * exists.
+     * @pre the design has been verified and initialized.
+     */
+    template <typename T = SimPort>
+    T* findPortByPath(std::string_view path) const {
+        static_assert(std::is_base_of<SimPort, T>::value, "Must cast to a simulator-specific port type");
+        auto* port = static_cast<SimPort*>(m_hierarchyIndex.find(path, HierarchyIndex::Port));
+        return port ? port->template cast<T>() : nullptr;
+    }
+
+    /**
+     * @brief findComponentByPath
+     * @returns the component with the hierarchical path @p path, or nullptr if no such component exists.
+     * @pre the design has been verified and initialized.
+     */
+    template <typename T = SimComponent>
+    T* findComponentByPath(std::string_view path) const {
+        static_assert(std::is_base_of<SimComponent, T>::value, "Must cast to a simulator-specific component type");
+        auto* component = static_cast<SimComponent*>(m_hierarchyIndex.find(path, HierarchyIndex::Component));
+        return component ? component->template cast<T>() : nullptr;
+    }
+
     /**
      * m_emitsSignals related functions
      * signalsEnabled() may be used by child components and ports of this design, to emit status change signals.
@@ -665,13 +878,20 @@ public:
      */
     bool vcdDump() const { return m_dumpVcdFiles; }
 
+    /**
+     * @brief setVcdFileName
+     * Sets the path of the VCD file written when dumping is enabled. By default, "<design name>.vcd" is written to the
+     * current working directory. Takes effect upon the next reset of the design.
+     */
+    void setVcdFileName(const std::string& path) { m_vcdFileName = path; }
+
     /**
      * @brief resetVcdFile
      * Prepares a new VCD file for the circuit. A header is written containing all ports in the design, as vcd
      * variables, scoped by the SimComponent hierarchy wherein they reside.
      */
     void resetVcdFile() {
-        m_vcdFile = std::make_unique<VCDFile>(getName() + ".vcd");
+        m_vcdFile = std::make_unique<VCDFile>(m_vcdFileName.empty() ? getName() + ".vcd" : m_vcdFileName);
         {
             auto def1 = m_vcdFile->writeHeader();
             auto def2 = m_vcdFile->scopeDef("TOP");
@@ -698,6 +918,30 @@ public:
         m_vcdVarChangeQueue.insert(port);
     }
 
+    /**
+     * @brief queueComponentChange
+     * Called by output ports of @p component upon changing value during propagation. The changed signal of the
+     * component is emitted once per propagation of the design, through emitComponentChanges().
+     */
+    void queueComponentChange(SimComponent* component) {
+        if (!component->m_changePending) {
+            component->m_changePending = true;
+            m_componentChangeQueue.push_back(component);
+        }
+    }
+
+    /**
+     * @brief emitComponentChanges
+     * Emits the changed signal of all components which have had an output port change value since the last call.
+     */
+    void emitComponentChanges() {
+        for (auto* component : m_componentChangeQueue) {
+            component->m_changePending = false;
+            component->changed.Emit();
+        }
+        m_componentChangeQueue.clear();
+    }
+
     /**
      * @brief dumpVcdVarChanges
      * Increments simulation time in the .vcd file and dumps all enqueued variable changes to the file.
@@ -727,11 +971,171 @@ public:
     Gallant::Signal0<> designWasReversed;
     Gallant::Signal0<> designWasReset;
 
+    const ObjectArena& objectArena() const { return m_objectArena; }
+
+    /**
+     * @brief getBreakpoints
+     * @returns the breakpoints of the design. Simulation loops (ie. VSRTLWidget::run()) stop once a breakpoint has been
+     * triggered.
+     */
+    BreakpointEngine& getBreakpoints() { return m_breakpoints; }
+    const BreakpointEngine& getBreakpoints() const { return m_breakpoints; }
+
+    /**
+     * @brief getPorts
+     * @returns all ports of the design, indexed by their ordinal (see SimPort::ordinal()).
+     * @pre the design has been verified and initialized.
+     */
+    const std::vector<SimPort*>& getPorts() const { return m_ports; }
+
+    /**
+     * @brief publishSnapshot
+     * Copies the values of all ports of the design into the value snapshot of the design, and publishes it to the
+     * observing thread. Called by the thread simulating the design.
+     */
+    void publishSnapshot() {
+        auto* values = m_snapshot.values();
+        for (size_t i = 0; i < m_ports.size(); ++i) {
+            values[i] = m_ports[i]->uValue();
+        }
+        m_snapshot.publish(getCycleCount());
+    }
+
+    /**
+     * @brief setLiveSnapshots
+     * While enabled, observers read port values from the latest snapshot acquired through getSnapshot() rather than
+     * from the ports themselves (see SimPort::observedValue()), which may be concurrently modified by a simulation
+     * thread. Enabling live snapshots publishes and acquires an initial snapshot; must thus be called while the design
+     * is not being simulated.
+     */
+    void setLiveSnapshots(bool enabled) {
+        if (enabled) {
+            publishSnapshot();
+            m_snapshot.acquire();
+        }
+        m_liveSnapshots.store(enabled, std::memory_order_release);
+    }
+    bool liveSnapshots() const { return m_liveSnapshots.load(std::memory_order_acquire); }
+    ValueSnapshot& getSnapshot() { return m_snapshot; }
+
+    /**
+     * @brief getMemoryFootprint
+     * @returns an estimate of the memory used by the design, broken down by category and by component.
+     * @pre the design has been verified and initialized.
+     */
+    MemoryFootprint getMemoryFootprint() const;
+
+    void accountMemory(MemoryFootprint::Usage& usage) const override;
+
+    struct ActivityCounters {
+        /// Clock cycles during which activity was tracked
+        uint64_t cycles = 0;
+        uint64_t toggles = 0;
+        uint64_t bitFlips = 0;
+    };
+
+    struct ActivitySample {
+        /// Cycle count at the end of the sample window
+        long long cycle;
+        uint64_t toggles;
+        uint64_t bitFlips;
+    };
+
+    /**
+     * @brief setActivityTracking
+     * Enables counting the switching activity of each port of the design; see SimPort::toggleCount(). Activity is
+     * recorded for the propagation of the design following each clock cycle, and not when the design is reversed or
+     * reset.
+     * @param window: if non-zero, the activity of the entire design is additionally sampled for every @p window tracked
+     * cycles; see getActivitySamples().
+     */
+    void setActivityTracking(bool enabled, unsigned window = 0) {
+        m_activityTracking = enabled;
+        m_activityWindow = window;
+        m_activityWindowStart = m_activity;
+    }
+    bool activityTrackingEnabled() const { return m_activityTracking; }
+
+    /// Accumulated activity of the entire design.
+    const ActivityCounters& getActivity() const { return m_activity; }
+    const std::vector<ActivitySample>& getActivitySamples() const { return m_activitySamples; }
+
+    /// Resets the activity counters of the design and all of its ports, ie. between workload phases.
+    void resetActivity();
+
+    /**
+     * @brief writeActivityCsv
+     * Writes the switching activity of each non-constant port of the design as CSV, one row per hierarchical net.
+     * Net paths are quoted as per RFC 4180.
+     * @pre the design has been verified and initialized.
+     */
+    void writeActivityCsv(std::ostream& os) const;
+
+    /**
+     * @brief writeActivitySaif
+     * Writes the switching activity of the design in the Switching Activity Interchange Format, with one time unit
+     * per clock cycle. Only toggle counts (TC) are reported. Toggle counts of multi-bit ports are reported for the
+     * port as a whole, being the total number of bit flips of the port. As for writeActivityCsv(), constant ports are
+     * omitted.
+     */
+    void writeActivitySaif(std::ostream& os) const;
+
 protected:
+    void recordActivity(VSRTL_VT_U flipped) {
+        m_activity.toggles++;
+        m_activity.bitFlips += std::bitset<sizeof(VSRTL_VT_U) * CHAR_BIT>(flipped).count();
+    }
+
     long long m_cycleCount = 0;
     bool m_emitsSignals = true;
+    bool m_activityTracking = false;
 
 private:
+    /**
+     * @brief indexHierarchy
+     * Builds the hierarchy index of the design. Components are visited before their ports and subcomponents, such
+     * that each hierarchical name is computed by extending the (cached) name of its parent. Ports are assigned their
+     * ordinals in order of visitation.
+     */
+    void indexHierarchy() {
+        m_hierarchyIndex.clear();
+        m_ports.clear();
+        std::vector<SimComponent*> stack = {this};
+        while (!stack.empty()) {
+            auto* c = stack.back();
+            stack.pop_back();
+            m_hierarchyIndex.add(c->getHierName(), c, HierarchyIndex::Component);
+            c->m_design = this;
+            for (auto* ports : {&c->m_inputPorts, &c->m_outputPorts, &c->m_signals}) {
+                for (const auto& p : *ports) {
+                    m_hierarchyIndex.add(p->getHierName(), p.get(), HierarchyIndex::Port);
+                    p->m_design = this;
+                    p->m_ordinal = m_ports.size();
+                    m_ports.push_back(p.get());
+                }
+            }
+            for (const auto& sc : c->m_subcomponents) {
+                stack.push_back(sc.get());
+            }
+        }
+        m_hierarchyIndex.finalize();
+        m_snapshot.resize(m_ports.size());
+    }
+
+    HierarchyIndex m_hierarchyIndex;
+    std::vector<SimPort*> m_ports;
+    ValueSnapshot m_snapshot;
+    std::atomic<bool> m_liveSnapshots = false;
+
+    /**
+     * @brief m_objectArena
+     * Arena which the subcomponents and ports of this design are allocated within. Designs may contain millions of
+     * components and ports which share the lifetime of the design; allocating these from a monotonic arena avoids the
+     * overhead of individual heap allocations.
+     */
+    ObjectArena m_objectArena;
+    BreakpointEngine m_breakpoints;
+    std::vector<SimComponent*> m_componentChangeQueue;
     bool m_emitsClockedSignals = true;
     bool m_isVerifiedAndInitialized = false;
 
@@ -739,11 +1143,29 @@ private:
     std::unique_ptr<VCDFile> m_vcdFile;
     std::set<const SimPort*> m_vcdVarChangeQueue;
     std::string m_vcdClkId;
+    std::string m_vcdFileName;
     bool m_dumpVcdFiles = false;
 
+    // Activity tracking members
+    ActivityCounters m_activity;
+    ActivityCounters m_activityWindowStart;
+    unsigned m_activityWindow = 0;
+    std::vector<ActivitySample> m_activitySamples;
+
 #ifndef NDEBUG
     long long m_cycleCountPre = 0;
 #endif
 };
 
+VSRTL_VT_U SimPort::observedValue() const {
+    auto* design = getDesign();
+    return design->liveSnapshots() ? design->getSnapshot().value(m_ordinal) : uValue();
+}
+
+void SimPort::recordActivity(SimDesign* design, VSRTL_VT_U flipped) {
+    m_toggles++;
+    m_bitFlips += std::bitset<sizeof(VSRTL_VT_U) * CHAR_BIT>(flipped).count();
+    design->recordActivity(flipped);
+}
+
 }  // namespace vsrtl
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "vsrtl_footprint.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define VSRTL_PROFILER_RDTSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define VSRTL_PROFILER_RDTSC
+#endif
+
+namespace vsrtl {
+
+class SimComponent;
+
+/**
+ * @brief The Profiler class
+ * Accumulates the number of evaluations and the time spent evaluating each port of a design, as well as the time spent
+ * saving and reversing the state of each clocked component. Port costs are attributed to the component owning the
+ * port, and component costs are aggregated up through the component hierarchy.
+ * Time is measured in ticks of the time stamp counter, if available, and otherwise in nanoseconds.
+ */
+class Profiler {
+public:
+    using Ticks = uint64_t;
+    static constexpr uint32_t NoParent = UINT32_MAX;
+
+    struct PortProfile {
+        uint64_t evaluations = 0;
+        Ticks ticks = 0;
+    };
+
+    struct ComponentProfile {
+        const SimComponent* component = nullptr;
+        std::string name;
+        uint32_t parent = NoParent;
+
+        /// Number of port evaluations of this component
+        uint64_t evaluations = 0;
+        /// Time spent evaluating the ports of this component, excluding subcomponents
+        Ticks propagation = 0;
+        /// Time spent in save()/reverse() of this component
+        Ticks save = 0;
+        Ticks reverse = 0;
+        /// Time spent within this component and all of its subcomponents
+        Ticks total = 0;
+
+        Ticks self() const { return propagation + save + reverse; }
+    };
+
+    static Ticks now() {
+#ifdef VSRTL_PROFILER_RDTSC
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+    }
+
+    /**
+     * @brief initialize
+     * @param components: components of the design, wherein a parent must precede its subcomponents. Each component
+     * refers to its parent by index, or NoParent for top-level components.
+     * @param portOwners: index of the owning component of each port, indexed by port ordinal.
+     */
+    void initialize(std::vector<ComponentProfile> components, std::vector<uint32_t> portOwners) {
+        m_components = std::move(components);
+        m_portOwners = std::move(portOwners);
+        m_componentIndex.clear();
+        for (uint32_t i = 0; i < m_components.size(); ++i) {
+            m_componentIndex[m_components[i].component] = i;
+        }
+        reset();
+    }
+
+    void reset() {
+        m_ports.assign(m_portOwners.size(), {});
+        for (auto& c : m_components) {
+            c.evaluations = c.propagation = c.save = c.reverse = c.total = 0;
+        }
+        m_cycles = 0;
+        m_totalTicks = 0;
+        m_startTicks = now();
+        m_startTime = std::chrono::steady_clock::now();
+        m_dirty = false;
+    }
+
+    bool isInitialized() const { return !m_portOwners.empty(); }
+
+    void addPortEvaluation(uint32_t port, Ticks ticks) {
+        auto& p = m_ports[port];
+        p.evaluations++;
+        p.ticks += ticks;
+        m_dirty = true;
+    }
+    void addSave(uint32_t component, Ticks ticks) {
+        m_components[component].save += ticks;
+        m_dirty = true;
+    }
+    void addReverse(uint32_t component, Ticks ticks) {
+        m_components[component].reverse += ticks;
+        m_dirty = true;
+    }
+    void addCycle() { m_cycles++; }
+
+    uint64_t cycles() const { return m_cycles; }
+
+    /// Estimated number of bytes allocated by the profiler.
+    size_t memoryUsage() const {
+        size_t bytes = footprint::bytes(m_components) + footprint::bytes(m_portOwners) + footprint::bytes(m_ports) +
+                       footprint::hashBytes(m_componentIndex);
+        for (const auto& c : m_components) {
+            bytes += footprint::bytes(c.name);
+        }
+        return bytes;
+    }
+    const PortProfile& port(uint32_t ordinal) const { return m_ports.at(ordinal); }
+    uint32_t componentIndex(const SimComponent* c) const {
+        auto it = m_componentIndex.find(c);
+        return it == m_componentIndex.end() ? NoParent : it->second;
+    }
+
+    /// @returns the profile of all components, with costs aggregated up through the hierarchy.
+    const std::vector<ComponentProfile>& components() const {
+        aggregate();
+        return m_components;
+    }
+
+    /// @returns the profile of @p c, or nullptr if @p c is not profiled.
+    const ComponentProfile* component(const SimComponent* c) const {
+        const uint32_t idx = componentIndex(c);
+        return idx == NoParent ? nullptr : &components()[idx];
+    }
+
+    /// Total time spent within all profiled components.
+    Ticks totalTicks() const {
+        aggregate();
+        return m_totalTicks;
+    }
+
+    /// @returns the share of the total profiled time spent within @p c and its subcomponents, in [0; 1].
+    double share(const SimComponent* c) const {
+        const auto* profile = component(c);
+        const Ticks total = totalTicks();
+        return profile && total != 0 ? static_cast<double>(profile->total) / total : 0.0;
+    }
+
+    /// Estimated number of ticks per second, as measured since the profile was reset.
+    double ticksPerSecond() const {
+#ifdef VSRTL_PROFILER_RDTSC
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+        return seconds > 0 ? (now() - m_startTicks) / seconds : 1e9;
+#else
+        return 1e9;
+#endif
+    }
+
+    double toSeconds(Ticks ticks) const { return ticks / ticksPerSecond(); }
+
+    /**
+     * @brief hotspots
+     * @returns indices of the @p n components with the highest self time (excluding subcomponents), highest first.
+     */
+    std::vector<uint32_t> hotspots(size_t n) const {
+        const auto& comps = components();
+        std::vector<uint32_t> order(comps.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        n = std::min(n, order.size());
+        std::partial_sort(order.begin(), order.begin() + n, order.end(),
+                          [&](uint32_t a, uint32_t b) { return comps[a].self() > comps[b].self(); });
+        order.resize(n);
+        return order;
+    }
+
+    /// Prints the @p n hottest components of the profile to @p os.
+    void printHotspots(std::ostream& os, size_t n = 20) const {
+        const double tps = ticksPerSecond();
+        const Ticks total = totalTicks();
+        char line[256];
+        std::snprintf(line, sizeof(line), "Profile of %llu cycles, %.3f ms total\n",
+                      static_cast<unsigned long long>(m_cycles), total / tps * 1e3);
+        os << line;
+        std::snprintf(line, sizeof(line), "%8s %12s %12s %12s %14s  %s\n", "self%", "self [us]", "total [us]",
+                      "clocked [us]", "evaluations", "component");
+        os << line;
+        for (uint32_t idx : hotspots(n)) {
+            const auto& c = m_components[idx];
+            std::snprintf(line, sizeof(line), "%7.2f%% %12.1f %12.1f %12.1f %14llu  ",
+                          total ? 100.0 * c.self() / total : 0.0, c.self() / tps * 1e6, c.total / tps * 1e6,
+                          (c.save + c.reverse) / tps * 1e6, static_cast<unsigned long long>(c.evaluations));
+            os << line << path(idx, "->") << "\n";
+        }
+    }
+
+    /**
+     * @brief writeFoldedStacks
+     * Writes the profile in the folded stack format, as consumed by flame graph tools (ie. flamegraph.pl, speedscope):
+     * one line per component, holding the semicolon-separated hierarchy of the component followed by its self time in
+     * nanoseconds.
+     */
+    void writeFoldedStacks(std::ostream& os, const std::string& root) const {
+        const auto& comps = components();
+        const double nsPerTick = 1e9 / ticksPerSecond();
+        for (uint32_t i = 0; i < comps.size(); ++i) {
+            const auto ns = static_cast<unsigned long long>(comps[i].self() * nsPerTick);
+            if (ns != 0) {
+                os << root << ";" << path(i, ";") << " " << ns << "\n";
+            }
+        }
+    }
+
+    /// @returns the hierarchical path of component @p idx, relative to the design.
+    std::string path(uint32_t idx, const char* separator) const {
+        std::vector<uint32_t> stack;
+        for (uint32_t i = idx; i != NoParent; i = m_components[i].parent) {
+            stack.push_back(i);
+        }
+        std::string p;
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            if (!p.empty()) {
+                p += separator;
+            }
+            p += m_components[*it].name;
+        }
+        return p;
+    }
+
+private:
+    /// Attributes port costs to their owning components, and accumulates component totals up through the hierarchy.
+    void aggregate() const {
+        if (!m_dirty) {
+            return;
+        }
+        for (auto& c : m_components) {
+            c.evaluations = 0;
+            c.propagation = 0;
+        }
+        for (uint32_t p = 0; p < m_ports.size(); ++p) {
+            auto& c = m_components[m_portOwners[p]];
+            c.evaluations += m_ports[p].evaluations;
+            c.propagation += m_ports[p].ticks;
+        }
+        for (auto& c : m_components) {
+            c.total = c.self();
+        }
+        // Parents precede their subcomponents; accumulate in reverse
+        m_totalTicks = 0;
+        for (auto it = m_components.rbegin(); it != m_components.rend(); ++it) {
+            if (it->parent != NoParent) {
+                m_components[it->parent].total += it->total;
+            } else {
+                m_totalTicks += it->total;
+            }
+        }
+        m_dirty = false;
+    }
+
+    mutable std::vector<ComponentProfile> m_components;
+    std::vector<uint32_t> m_portOwners;
+    std::vector<PortProfile> m_ports;
+    std::unordered_map<const SimComponent*, uint32_t> m_componentIndex;
+    uint64_t m_cycles = 0;
+    Ticks m_startTicks = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+    mutable Ticks m_totalTicks = 0;
+    mutable bool m_dirty = false;
+};
+
+}  // namespace vsrtl
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "vsrtl_defines.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace vsrtl {
+
+/**
+ * @brief The ValueSnapshot class
+ * Triple-buffered copy of the values of all ports of a design, allowing a simulation thread to publish consistent
+ * views of the design to observers on another thread (ie. a GUI) without either thread blocking the other.
+ *
+ * The writer fills the back buffer and publishes it by exchanging it with the middle buffer. The reader acquires the
+ * latest published buffer by exchanging its front buffer with the middle buffer, if the middle buffer holds a buffer
+ * which has not yet been acquired. Each buffer is thus only ever accessed by a single thread, and an acquired snapshot
+ * remains stable until the next call to acquire().
+ *
+ * Only a single writer thread and a single reader thread may use the snapshot concurrently.
+ */
+class ValueSnapshot {
+public:
+    ValueSnapshot() = default;
+    ValueSnapshot(const ValueSnapshot&) = delete;
+    ValueSnapshot& operator=(const ValueSnapshot&) = delete;
+
+    /// Resizes the snapshot to hold @p ports values. Must not be called while the snapshot is in use by other threads.
+    void resize(size_t ports) {
+        for (auto& buffer : m_buffers) {
+            buffer.values.assign(ports, 0);
+            buffer.cycle = -1;
+        }
+        m_back = 0;
+        m_middle.store(1, std::memory_order_relaxed);
+        m_front = 2;
+    }
+    size_t size() const { return m_buffers[0].values.size(); }
+
+    // Writer interface
+    /// @returns the values of the back buffer, to be filled by the writer before calling publish().
+    VSRTL_VT_U* values() { return m_buffers[m_back].values.data(); }
+    /// Publishes the back buffer as the state of the design at @p cycle.
+    void publish(long long cycle) {
+        m_buffers[m_back].cycle = cycle;
+        m_back = m_middle.exchange(m_back | Fresh, std::memory_order_acq_rel) & Index;
+    }
+
+    // Reader interface
+    /// Acquires the most recently published snapshot. @returns true if a new snapshot was acquired.
+    bool acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & Fresh) == 0) {
+            return false;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & Index;
+        return true;
+    }
+    /// @returns the value of port @p ordinal within the acquired snapshot; see SimPort::ordinal().
+    VSRTL_VT_U value(uint32_t ordinal) const { return m_buffers[m_front].values[ordinal]; }
+    /// @returns the cycle of the acquired snapshot, or -1 if no snapshot has been acquired.
+    long long cycle() const { return m_buffers[m_front].cycle; }
+
+    /// Estimated number of bytes allocated by the snapshot.
+    size_t memoryUsage() const { return m_buffers.size() * m_buffers[0].values.capacity() * sizeof(VSRTL_VT_U); }
+
+private:
+    static constexpr uint8_t Index = 0b011;
+    /// Set for the middle buffer when it has been published but not yet acquired
+    static constexpr uint8_t Fresh = 0b100;
+
+    struct Buffer {
+        std::vector<VSRTL_VT_U> values;
+        long long cycle = -1;
+    };
+
+    std::array<Buffer, 3> m_buffers;
+    /// Buffer owned by the writer
+    uint8_t m_back = 0;
+    /// Buffer in transit between the writer and the reader
+    std::atomic<uint8_t> m_middle = 1;
+    /// Buffer owned by the reader
+    uint8_t m_front = 2;
+};
+
+}  // namespace vsrtl
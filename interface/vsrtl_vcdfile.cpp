@@ -1,6 +1,8 @@
 #include "vsrtl_vcdfile.h"
+#include "vsrtl_footprint.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -27,6 +29,18 @@ VCDFile::VCDFile(const std::string& filename) {
     m_file.open(filename, std::ios_base::trunc);
 }
 
+size_t VCDFile::memoryUsage() const {
+    // Write buffer of the underlying file buffer
+    size_t bytes = BUFSIZ + footprint::treeBytes(m_varWidths) + footprint::treeBytes(m_dumpVars);
+    for (const auto& var : m_varWidths) {
+        bytes += footprint::bytes(var.first);
+    }
+    for (const auto& var : m_dumpVars) {
+        bytes += footprint::bytes(var.first);
+    }
+    return bytes;
+}
+
 VCDFile::~VCDFile() {
     m_file.close();
 }
@@ -32,6 +32,9 @@ public:
     void writeVarChange(const std::string& ref, uint64_t value);
     void varInitVal(const std::string& ref, uint64_t value) { m_dumpVars[ref] = value; }
 
+    /// Estimated number of bytes allocated by the file, including its write buffer.
+    size_t memoryUsage() const;
+
 private:
     std::string genId();
     void writeLine(const std::string& line);
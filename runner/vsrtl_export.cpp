@@ -0,0 +1,231 @@
+/**
+ * vsrtl-export
+ * Headless schematic export. A registered design (see vsrtl_designregistry.h) is selected by name, laid out either
+ * from a layout file or by expanding and placing all of its components, optionally clocked for a number of cycles, and
+ * rendered to SVG, PNG or PNG tiles without showing any window. A summary of the export is printed as JSON.
+ *
+ * Rendering requires Qt. Unless a platform is given through QT_QPA_PLATFORM, the offscreen platform is used, such that
+ * no display is required.
+ */
+
+#include "vsrtl_designregistry.h"
+#include "vsrtl_graphics_defines.h"
+#include "vsrtl_schematicexport.h"
+#include "vsrtl_widget.h"
+
+#include <cereal/archives/json.hpp>
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QFileInfo>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+using namespace vsrtl;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string design;
+    std::string layout;
+    bool expandAll = false;
+    bool darkmode = false;
+    unsigned long long cycles = 0;
+    std::string svg;
+    std::string png;
+    std::string tiles;
+    SchematicExporter::TileOptions tileOptions;
+    qreal scale = 1.0;
+    std::string output;
+};
+
+struct ExportResult {
+    std::string design;
+    unsigned long long cycles = 0;
+    double width = 0;
+    double height = 0;
+    SchematicExporter::TileResult tiles;
+    double seconds = 0;
+
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(cereal::make_nvp("design", design), cereal::make_nvp("cycles", cycles),
+                cereal::make_nvp("width", width), cereal::make_nvp("height", height),
+                cereal::make_nvp("tile_levels", tiles.levels), cereal::make_nvp("tiles", tiles.tiles),
+                cereal::make_nvp("seconds", seconds));
+    }
+};
+
+std::ofstream openOutput(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open '" + path + "' for writing");
+    }
+    return file;
+}
+
+/// Expands all components of the design shown by @p widget, and waits for them to be placed and routed.
+void expandAll(VSRTLWidget& widget) {
+    QEventLoop loop;
+    QObject::connect(&widget, &VSRTLWidget::expandAllFinished, &loop, &QEventLoop::quit);
+    widget.expandAllComponents();
+    loop.exec();
+}
+
+ExportResult exportDesign(const core::RegisteredDesign& registered, const Options& options) {
+    const auto start = Clock::now();
+    auto design = registered.create();
+
+    VSRTLWidget widget;
+    widget.setDesign(design.get());
+    widget.setDarkmode(options.darkmode);
+
+    if (!options.layout.empty()) {
+        if (!QFileInfo::exists(QString::fromStdString(options.layout))) {
+            throw std::runtime_error("No layout file '" + options.layout + "'");
+        }
+        widget.getTopLevelComponent()->loadLayoutFile(QString::fromStdString(options.layout));
+    }
+    // Without a layout, the entire design is shown
+    if (options.expandAll || options.layout.empty()) {
+        expandAll(widget);
+    }
+
+    for (unsigned long long i = 0; i < options.cycles; ++i) {
+        design->clock();
+    }
+    widget.syncAll();
+    // Process pending redraws and reroutes before rendering
+    QCoreApplication::processEvents();
+
+    ExportResult result;
+    result.design = registered.name;
+    result.cycles = design->getCycleCount();
+    const QRectF source =
+        widget.getTopLevelComponent()->sceneBoundingRect().adjusted(-GRID_SIZE, -GRID_SIZE, GRID_SIZE, GRID_SIZE);
+    result.width = source.width();
+    result.height = source.height();
+
+    const SchematicExporter exporter(widget.getScene(), source);
+    if (!options.svg.empty()) {
+        exporter.exportSvg(QString::fromStdString(options.svg), QString::fromStdString(registered.name));
+    }
+    if (!options.png.empty()) {
+        exporter.exportPng(QString::fromStdString(options.png), options.scale);
+    }
+    if (!options.tiles.empty()) {
+        auto tileOptions = options.tileOptions;
+        tileOptions.scale = options.scale;
+        result.tiles = exporter.exportTiles(QString::fromStdString(options.tiles), tileOptions);
+    }
+
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " --design <name> [options]\n"
+              << "  --design <name>       Design to export; see --list\n"
+              << "  --layout <file>       Lay out the design from a binary or JSON layout file\n"
+              << "  --expand-all          Expand and place all components; the default without a layout\n"
+              << "  --darkmode            Render in dark mode\n"
+              << "  --cycles <n>          Clock the design <n> times before rendering (default: 0)\n"
+              << "  --svg <file>          Write the schematic as SVG to <file>\n"
+              << "  --png <file>          Write the schematic as a single PNG image to <file>\n"
+              << "  --tiles <dir>         Write the schematic as PNG tiles to <dir>/<level>/<column>/<row>.png\n"
+              << "  --tile-size <n>       Size of tiles, in pixels (default: 256)\n"
+              << "  --pyramid             Write all levels of the tile pyramid rather than only the full resolution\n"
+              << "  --threads <n>         Number of threads rendering tiles (default: all cores)\n"
+              << "  --scale <f>           Pixels per scene unit of PNG output (default: 1)\n"
+              << "  --output <file>       Write the JSON summary to <file> instead of stdout\n"
+              << "  --list                List available designs\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    // Render without a display unless a platform has been requested explicitly
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--design") {
+            options.design = value();
+        } else if (arg == "--layout") {
+            options.layout = value();
+        } else if (arg == "--expand-all") {
+            options.expandAll = true;
+        } else if (arg == "--darkmode") {
+            options.darkmode = true;
+        } else if (arg == "--cycles") {
+            options.cycles = std::stoull(value());
+        } else if (arg == "--svg") {
+            options.svg = value();
+        } else if (arg == "--png") {
+            options.png = value();
+        } else if (arg == "--tiles") {
+            options.tiles = value();
+        } else if (arg == "--tile-size") {
+            options.tileOptions.tileSize = std::stoi(value());
+        } else if (arg == "--pyramid") {
+            options.tileOptions.pyramid = true;
+        } else if (arg == "--threads") {
+            options.tileOptions.threads = std::stoi(value());
+        } else if (arg == "--scale") {
+            options.scale = std::stod(value());
+        } else if (arg == "--output") {
+            options.output = value();
+        } else if (arg == "--list") {
+            for (const auto& design : core::registeredDesigns()) {
+                std::cout << design.name << "\t" << design.description << "\n";
+            }
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    const auto* registered = core::findRegisteredDesign(options.design);
+    if (!registered) {
+        std::cerr << (options.design.empty() ? "No design given" : "Unknown design '" + options.design + "'")
+                  << "; see --list\n";
+        return 2;
+    }
+    if (options.svg.empty() && options.png.empty() && options.tiles.empty()) {
+        std::cerr << "No output given; see --svg, --png and --tiles\n";
+        return 2;
+    }
+
+    try {
+        const auto result = exportDesign(*registered, options);
+        if (options.output.empty()) {
+            cereal::JSONOutputArchive archive(std::cout);
+            archive(cereal::make_nvp("export", result));
+        } else {
+            auto file = openOutput(options.output);
+            cereal::JSONOutputArchive archive(file);
+            archive(cereal::make_nvp("export", result));
+        }
+        std::cout << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Export failed: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
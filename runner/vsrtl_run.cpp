@@ -0,0 +1,333 @@
+/**
+ * vsrtl-run
+ * Headless simulation runner. A registered design (see vsrtl_designregistry.h) is selected by name, optionally loaded
+ * with a program image, and clocked for a number of cycles or until a stop condition is met. Traces may be dumped
+ * during the run. Throughput and the final register state of the design are printed as JSON.
+ *
+ * The runner only depends on the core, interface and components libraries, and thus does not require Qt.
+ */
+
+#include "vsrtl_designregistry.h"
+
+#include <cereal/archives/json.hpp>
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace vsrtl;
+using Clock = std::chrono::steady_clock;
+
+struct Watch {
+    VSRTL_VT_U address;
+    unsigned size;
+    BreakpointEngine::Access access;
+};
+
+struct Options {
+    std::string design;
+    std::string program;
+    VSRTL_VT_U loadAddress = 0;
+    unsigned long long cycles = 1000;
+    /// Port paths and the values which they must change to
+    std::vector<std::pair<std::string, VSRTL_VT_U>> until;
+    std::vector<std::string> untilChange;
+    std::vector<Watch> watch;
+    std::string vcd;
+    std::string activity;
+    std::string profile;
+    std::string output;
+};
+
+struct RegisterState {
+    std::vector<std::pair<std::string, VSRTL_VT_U>> values;
+
+    template <class Archive>
+    void save(Archive& archive) const {
+        for (const auto& [path, value] : values) {
+            archive(cereal::make_nvp(path, value));
+        }
+    }
+};
+
+struct RunResult {
+    std::string design;
+    unsigned long long cycles = 0;
+    std::string stopReason;
+    double seconds = 0;
+    double cyclesPerSecond = 0;
+    RegisterState registers;
+
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(cereal::make_nvp("design", design), cereal::make_nvp("cycles", cycles),
+                cereal::make_nvp("stop_reason", stopReason), cereal::make_nvp("seconds", seconds),
+                cereal::make_nvp("cycles_per_second", cyclesPerSecond), cereal::make_nvp("registers", registers));
+    }
+};
+
+/**
+ * @brief parseNumber
+ * Parses @p text as an unsigned number in decimal, hexadecimal (0x) or octal (0) notation.
+ * @throws std::invalid_argument naming @p option if @p text is not such a number.
+ */
+unsigned long long parseNumber(const std::string& text, const std::string& option) {
+    size_t end = 0;
+    unsigned long long value = 0;
+    if (!text.empty() && text[0] != '-') {
+        try {
+            value = std::stoull(text, &end, 0);
+        } catch (const std::exception&) {
+            end = 0;
+        }
+    }
+    if (end == 0 || end != text.size()) {
+        throw std::invalid_argument("Invalid number '" + text + "' for " + option);
+    }
+    return value;
+}
+
+/// Parses a stop condition of the form <port>=<value>.
+std::pair<std::string, VSRTL_VT_U> parseUntil(const std::string& expression) {
+    const auto eq = expression.rfind('=');
+    if (eq == std::string::npos || eq == 0) {
+        throw std::invalid_argument("Invalid stop condition '" + expression +
+                                    "' for --until; expected <port>=<value>");
+    }
+    return {expression.substr(0, eq), parseNumber(expression.substr(eq + 1), "--until")};
+}
+
+/// Parses a memory range of the form <address>[+<size>].
+Watch parseWatch(const std::string& range, const std::string& option, BreakpointEngine::Access access) {
+    const auto plus = range.find('+');
+    const VSRTL_VT_U address = parseNumber(range.substr(0, plus), option);
+    const auto size = plus == std::string::npos ? 1 : parseNumber(range.substr(plus + 1), option);
+    if (size == 0 || size > UINT_MAX) {
+        throw std::invalid_argument("Invalid size of memory range '" + range + "' for " + option);
+    }
+    return {address, static_cast<unsigned>(size), access};
+}
+
+std::ofstream openOutput(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open '" + path + "' for writing");
+    }
+    return file;
+}
+
+/// Loads the raw binary image at @p path into the initialization memory of @p memory, starting at @p address.
+void loadProgram(core::AddressSpace& memory, const std::string& path, VSRTL_VT_U address) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not open program '" + path + "'");
+    }
+    const std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    memory.addInitializationMemory(address, image.data(), image.size());
+}
+
+/**
+ * @brief findPort
+ * Locates a port by its hierarchical path, with or without the name of the design as its first element. Registers
+ * may be given in place of ports, referring to the output port of the register.
+ */
+SimPort& findPort(const core::Design& design, const std::string& path) {
+    for (const auto& p : {path, design.getName() + "->" + path}) {
+        if (auto* port = design.findPortByPath(p)) {
+            return *port;
+        }
+        if (auto* reg = dynamic_cast<core::RegisterBase*>(design.findComponentByPath(p))) {
+            return *reg->getOut();
+        }
+    }
+    throw std::runtime_error("No port or register '" + path + "' in design '" + design.getName() + "'");
+}
+
+/// Adds the breakpoints given by @p options to @p design.
+void addBreakpoints(core::Design& design, core::AddressSpace* memory, const Options& options) {
+    auto& breakpoints = design.getBreakpoints();
+    for (const auto& [path, value] : options.until) {
+        breakpoints.addPortBreakpoint(findPort(design, path), BreakpointEngine::Condition::Equals, value);
+    }
+    for (const auto& path : options.untilChange) {
+        breakpoints.addPortBreakpoint(findPort(design, path));
+    }
+    for (const auto& watch : options.watch) {
+        if (!memory) {
+            throw std::runtime_error("Design '" + design.getName() + "' has no program memory to watch");
+        }
+        breakpoints.addWatchpoint(*memory, watch.address, watch.size, watch.access);
+    }
+    if (options.cycles != 0) {
+        breakpoints.addCycleBreakpoint(options.cycles);
+    }
+}
+
+RunResult run(const core::RegisteredDesign& registered, const Options& options) {
+    auto design = registered.create();
+    core::AddressSpace* memory = registered.programMemory ? registered.programMemory(*design) : nullptr;
+
+    if (!options.program.empty()) {
+        if (!memory) {
+            throw std::runtime_error("Design '" + registered.name + "' does not accept programs");
+        }
+        loadProgram(*memory, options.program, options.loadAddress);
+    }
+
+    const bool tracing = !options.vcd.empty();
+    design->setProfilingEnabled(!options.profile.empty());
+    design->setActivityTracking(!options.activity.empty());
+    design->verifyAndInitialize();
+
+    addBreakpoints(*design, memory, options);
+
+    // Signals are only consumed by VCD dumping; without any listeners, emitting them is wasted work
+    design->setEnableSignals(tracing);
+    design->setEnableClockedSignals(false);
+    if (tracing) {
+        design->setVcdFileName(options.vcd);
+        design->vcdDump(true);
+        design->reset();
+    }
+
+    // Stop conditions, including the cycle limit, are breakpoints of the design
+    const auto& breakpoints = design->getBreakpoints();
+    RunResult result;
+    result.design = registered.name;
+    const auto start = Clock::now();
+    while (!breakpoints.triggered()) {
+        design->clock();
+    }
+    result.cycles = design->getCycleCount();
+    result.stopReason = breakpoints.describe(breakpoints.hits().front().id);
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.cyclesPerSecond = result.seconds > 0 ? result.cycles / result.seconds : 0;
+
+    for (auto* reg : design->getRegisterComponents()) {
+        result.registers.values.push_back({reg->getHierName(), reg->getOut()->uValue()});
+    }
+    if (!options.activity.empty()) {
+        auto file = openOutput(options.activity);
+        design->writeActivityCsv(file);
+    }
+    if (const auto* profiler = design->getProfiler()) {
+        auto file = openOutput(options.profile);
+        profiler->printHotspots(file);
+    }
+    return result;
+}
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " --design <name> [options]\n"
+              << "  --design <name>       Design to simulate; see --list\n"
+              << "  --program <file>      Load a raw binary program image into the program memory of the design\n"
+              << "  --address <addr>      Load address of the program image (default: 0)\n"
+              << "  --cycles <n>          Maximum number of cycles to simulate (default: 1000); 0 for no limit, which\n"
+              << "                        requires another stop condition\n"
+              << "  --until <port>=<val>  Stop once <port> changes to <val>\n"
+              << "  --until-change <port> Stop once <port> changes value\n"
+              << "  --watch <addr>[+<n>]  Stop once the design accesses <n> bytes at <addr> of the program memory\n"
+              << "  --watch-read <range>  As --watch, for reads only\n"
+              << "  --watch-write <range> As --watch, for writes only\n"
+              << "  --vcd <file>          Dump a VCD trace to <file>\n"
+              << "  --activity <file>     Write per-net switching activity as CSV to <file>\n"
+              << "  --profile <file>      Write the evaluation hotspots of the design to <file>\n"
+              << "  --output <file>       Write the JSON result to <file> instead of stdout\n"
+              << "  --list                List available designs\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    // Malformed values are reported as usage errors
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    std::cerr << "Missing value for " << arg << "\n";
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+            if (arg == "--design") {
+                options.design = value();
+            } else if (arg == "--program") {
+                options.program = value();
+            } else if (arg == "--address") {
+                options.loadAddress = parseNumber(value(), arg);
+            } else if (arg == "--cycles") {
+                options.cycles = parseNumber(value(), arg);
+            } else if (arg == "--until") {
+                options.until.push_back(parseUntil(value()));
+            } else if (arg == "--until-change") {
+                options.untilChange.push_back(value());
+            } else if (arg == "--watch") {
+                options.watch.push_back(parseWatch(value(), arg, BreakpointEngine::ReadWrite));
+            } else if (arg == "--watch-read") {
+                options.watch.push_back(parseWatch(value(), arg, BreakpointEngine::Read));
+            } else if (arg == "--watch-write") {
+                options.watch.push_back(parseWatch(value(), arg, BreakpointEngine::Write));
+            } else if (arg == "--vcd") {
+                options.vcd = value();
+            } else if (arg == "--activity") {
+                options.activity = value();
+            } else if (arg == "--profile") {
+                options.profile = value();
+            } else if (arg == "--output") {
+                options.output = value();
+            } else if (arg == "--list") {
+                for (const auto& design : core::registeredDesigns()) {
+                    std::cout << design.name << "\t" << design.description << "\n";
+                }
+                return 0;
+            } else {
+                printUsage(argv[0]);
+                return arg == "--help" ? 0 : 2;
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    // The run loop only stops upon hitting a breakpoint
+    if (options.cycles == 0 && options.until.empty() && options.untilChange.empty() && options.watch.empty()) {
+        std::cerr << "--cycles 0 requires a stop condition (--until, --until-change or --watch)\n";
+        return 2;
+    }
+
+    const auto* registered = core::findRegisteredDesign(options.design);
+    if (!registered) {
+        std::cerr << (options.design.empty() ? "No design given" : "Unknown design '" + options.design + "'")
+                  << "; see --list\n";
+        return 2;
+    }
+
+    try {
+        const auto result = run(*registered, options);
+        if (options.output.empty()) {
+            cereal::JSONOutputArchive archive(std::cout);
+            archive(cereal::make_nvp("run", result));
+        } else {
+            auto file = openOutput(options.output);
+            cereal::JSONOutputArchive archive(file);
+            archive(cereal::make_nvp("run", result));
+        }
+        std::cout << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Simulation failed: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
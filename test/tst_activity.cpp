@@ -0,0 +1,139 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_adderandreg.h"
+
+#include <algorithm>
+#include <bitset>
+#include <sstream>
+
+class tst_Activity : public QObject {
+    Q_OBJECT private slots : void disabledByDefault();
+    void toggles();
+    void untrackedStateChanges();
+    void windows();
+    void reports();
+};
+
+using namespace vsrtl::core;
+
+namespace {
+uint64_t totalPortToggles(AdderAndReg& design) {
+    uint64_t toggles = 0;
+    for (const auto& entry : design.getHierarchyIndex().entries()) {
+        if (entry.kind == vsrtl::HierarchyIndex::Port) {
+            toggles += static_cast<const vsrtl::SimPort*>(entry.object)->toggleCount();
+        }
+    }
+    return toggles;
+}
+}  // namespace
+
+void tst_Activity::disabledByDefault() {
+    AdderAndReg design;
+    design.verifyAndInitialize();
+    QVERIFY(!design.activityTrackingEnabled());
+    for (unsigned i = 0; i < 10; ++i) {
+        design.clock();
+    }
+    QCOMPARE(design.getActivity().cycles, uint64_t(0));
+    QCOMPARE(design.getActivity().toggles, uint64_t(0));
+    QCOMPARE(design.reg->out.toggleCount(), uint64_t(0));
+}
+
+void tst_Activity::toggles() {
+    AdderAndReg design;
+    design.verifyAndInitialize();
+    design.setActivityTracking(true);
+
+    constexpr unsigned cycles = 100;
+    uint64_t expectedFlips = 0;
+    for (unsigned i = 0; i < cycles; ++i) {
+        expectedFlips += std::bitset<32>((i * 4) ^ ((i + 1) * 4)).count();
+        design.clock();
+    }
+
+    // The register output changes every cycle
+    QCOMPARE(design.getActivity().cycles, uint64_t(cycles));
+    QCOMPARE(design.reg->out.toggleCount(), uint64_t(cycles));
+    QCOMPARE(design.reg->out.bitFlipCount(), expectedFlips);
+
+    // Design-wide counters are the sum of all port counters
+    QCOMPARE(totalPortToggles(design), design.getActivity().toggles);
+
+    design.resetActivity();
+    QCOMPARE(design.getActivity().cycles, uint64_t(0));
+    QCOMPARE(design.getActivity().bitFlips, uint64_t(0));
+    QCOMPARE(design.reg->out.toggleCount(), uint64_t(0));
+    QCOMPARE(totalPortToggles(design), uint64_t(0));
+}
+
+void tst_Activity::untrackedStateChanges() {
+    AdderAndReg design;
+    design.verifyAndInitialize();
+    design.setActivityTracking(true);
+
+    design.clock();
+    design.clock();
+    const auto toggles = design.getActivity().toggles;
+
+    // Reversing and resetting the design does not constitute switching activity
+    design.reverse();
+    QCOMPARE(design.getActivity().toggles, toggles);
+    design.reset();
+    QCOMPARE(design.getActivity().toggles, toggles);
+    QCOMPARE(design.reg->out.toggleCount(), uint64_t(2));
+}
+
+void tst_Activity::windows() {
+    AdderAndReg design;
+    design.verifyAndInitialize();
+    design.setActivityTracking(true, 10);
+
+    for (unsigned i = 0; i < 35; ++i) {
+        design.clock();
+    }
+    const auto& samples = design.getActivitySamples();
+    QCOMPARE(samples.size(), size_t(3));
+    QCOMPARE(samples[0].cycle, 10ll);
+    QCOMPARE(samples[2].cycle, 30ll);
+
+    uint64_t toggles = 0;
+    for (const auto& s : samples) {
+        toggles += s.toggles;
+    }
+    QVERIFY(toggles <= design.getActivity().toggles);
+    QVERIFY(toggles > 0);
+}
+
+void tst_Activity::reports() {
+    AdderAndReg design;
+    design.verifyAndInitialize();
+    design.setActivityTracking(true);
+    for (unsigned i = 0; i < 10; ++i) {
+        design.clock();
+    }
+
+    std::stringstream csv;
+    design.writeActivityCsv(csv);
+    QVERIFY(csv.str().rfind("net,width,toggles,bit_flips,toggle_rate,bit_flip_rate\n", 0) == 0);
+    QVERIFY(csv.str().find("\"" + design.reg->out.getHierName() + "\",32,10,") != std::string::npos);
+
+    std::stringstream saif;
+    design.writeActivitySaif(saif);
+    QVERIFY(saif.str().rfind("(SAIFILE", 0) == 0);
+    QVERIFY(saif.str().find("(DURATION 10)") != std::string::npos);
+    QVERIFY(saif.str().find("(INSTANCE reg") != std::string::npos);
+    const std::string& s = saif.str();
+    QCOMPARE(std::count(s.begin(), s.end(), '('), std::count(s.begin(), s.end(), ')'));
+
+    // Both reports omit constant ports
+    const std::string& c = csv.str();
+    size_t saifNets = 0;
+    for (size_t pos = s.find("(TC "); pos != std::string::npos; pos = s.find("(TC ", pos + 1)) {
+        saifNets++;
+    }
+    QCOMPARE(saifNets, static_cast<size_t>(std::count(c.begin(), c.end(), '\n') - 1));
+}
+
+QTEST_APPLESS_MAIN(tst_Activity)
+#include "tst_activity.moc"
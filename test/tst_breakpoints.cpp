@@ -0,0 +1,195 @@
+#include <QtTest/QTest>
+
+#include "Leros/SingleCycleLeros/SingleCycleLeros.h"
+#include "vsrtl_adderandreg.h"
+
+class tst_Breakpoints : public QObject {
+    Q_OBJECT private slots : void portConditions();
+    void cycles();
+    void watchpoints();
+    void readWatchpoints();
+    void resetAddressWatchpoints();
+    void untracked();
+};
+
+using namespace vsrtl;
+
+namespace {
+/// A register which is loaded with the value stored at the address held by the register itself.
+class PointerChase : public core::Design {
+public:
+    PointerChase() : Design("Pointer chase") {
+        0 >> mem->data_in;
+        0 >> mem->wr_en;
+        0 >> mem->wr_width;
+        reg->out >> mem->addr;
+        mem->data_out >> reg->in;
+        mem->setMemory(m_memory);
+    }
+    SUBCOMPONENT(mem, TYPE(core::MemoryAsyncRd<8, 8>));
+    SUBCOMPONENT(reg, core::Register<8>);
+    ADDRESSSPACE(m_memory);
+};
+
+/// Clocks @p design until a breakpoint is triggered, or at most @p maxCycles cycles.
+void runUntilBreak(core::Design& design, unsigned maxCycles = 1000) {
+    for (unsigned i = 0; i < maxCycles && !design.getBreakpoints().triggered(); ++i) {
+        design.clock();
+    }
+}
+}  // namespace
+
+void tst_Breakpoints::portConditions() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    auto& breakpoints = design.getBreakpoints();
+
+    // The register accumulates by 4 each cycle
+    const auto eq = breakpoints.addPortBreakpoint(design.reg->out, BreakpointEngine::Condition::Equals, 20);
+    QVERIFY(design.reg->out.isWatched());
+    runUntilBreak(design);
+    QCOMPARE(design.getCycleCount(), 5);
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+    QCOMPARE(breakpoints.hits()[0].id, eq);
+    QCOMPARE(breakpoints.hits()[0].cycle, 5);
+    QCOMPARE(breakpoints.hits()[0].value, VSRTL_VT_U(20));
+
+    // Change breakpoints fire every cycle
+    breakpoints.clearHits();
+    const auto changes = breakpoints.addPortBreakpoint(design.reg->out);
+    design.clock();
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+    QCOMPARE(breakpoints.hits()[0].id, changes);
+
+    // Disabled breakpoints do not fire
+    breakpoints.clearHits();
+    breakpoints.setEnabled(changes, false);
+    design.clock();
+    QVERIFY(!breakpoints.triggered());
+
+    breakpoints.remove(eq);
+    QVERIFY(design.reg->out.isWatched());
+    breakpoints.remove(changes);
+    QVERIFY(!design.reg->out.isWatched());
+    QCOMPARE(breakpoints.size(), size_t(0));
+}
+
+void tst_Breakpoints::cycles() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    auto& breakpoints = design.getBreakpoints();
+
+    const auto id = breakpoints.addCycleBreakpoint(10);
+    runUntilBreak(design);
+    QCOMPARE(design.getCycleCount(), 10);
+    QCOMPARE(breakpoints.hits()[0].id, id);
+    QCOMPARE(breakpoints.describe(id), std::string("cycle 10"));
+
+    // Passed cycle breakpoints fire again after resetting the design
+    breakpoints.clearHits();
+    runUntilBreak(design, 20);
+    QVERIFY(!breakpoints.triggered());
+    design.reset();
+    runUntilBreak(design);
+    QCOMPARE(design.getCycleCount(), 10);
+}
+
+void tst_Breakpoints::watchpoints() {
+    leros::SingleCycleLeros design;
+    // Increments the value at 0x100; see tst_leros
+    std::vector<unsigned short> program = {0x2901, 0x3000, 0x5000, 0x2100, 0x7000,
+                                           0x6000, 0x0901, 0x7000, 0x2100, 0x8FFC};
+    design.m_memory->addInitializationMemory(0x0, program.data(), program.size());
+    design.verifyAndInitialize();
+    auto& breakpoints = design.getBreakpoints();
+
+    const auto write = breakpoints.addWatchpoint(*design.m_memory, 0x100, 2, BreakpointEngine::Write);
+    QVERIFY(design.m_memory->watcher() == &breakpoints);
+    runUntilBreak(design);
+    QVERIFY(breakpoints.triggered());
+    QCOMPARE(breakpoints.hits()[0].id, write);
+    QCOMPARE(breakpoints.hits()[0].value, VSRTL_VT_U(0x100));
+    const auto firstWrite = design.getCycleCount();
+
+    // Within the loop (ldind, addi, stind, loadi, br), the incremented value is stored every 5 cycles
+    breakpoints.clearHits();
+    runUntilBreak(design);
+    QCOMPARE(design.getCycleCount(), firstWrite + 3);
+    breakpoints.clearHits();
+    runUntilBreak(design);
+    QCOMPARE(design.getCycleCount(), firstWrite + 8);
+
+    // Accesses outside of the watched range do not fire
+    breakpoints.clear();
+    QVERIFY(design.m_memory->watcher() == nullptr);
+    breakpoints.addWatchpoint(*design.m_memory, 0x200, 4);
+    runUntilBreak(design, 100);
+    QVERIFY(!breakpoints.triggered());
+}
+
+void tst_Breakpoints::readWatchpoints() {
+    PointerChase design;
+    // 0 -> 5 -> 5 -> ...
+    std::vector<uint8_t> data = {5, 0, 0, 0, 0, 5};
+    design.m_memory->addInitializationMemory(0x0, data.data(), data.size());
+    design.verifyAndInitialize();
+    auto& breakpoints = design.getBreakpoints();
+
+    const auto read = breakpoints.addWatchpoint(*design.m_memory, 0x5, 1, BreakpointEngine::Read);
+    design.clock();
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+    QCOMPARE(breakpoints.hits()[0].id, read);
+    QCOMPARE(breakpoints.hits()[0].value, VSRTL_VT_U(0x5));
+
+    // Reading the same address again accesses the memory again, once per cycle
+    breakpoints.clearHits();
+    for (unsigned i = 0; i < 10; ++i) {
+        design.clock();
+    }
+    QCOMPARE(breakpoints.hits().size(), size_t(10));
+    QCOMPARE(breakpoints.hits()[0].cycle, 2);
+    QCOMPARE(breakpoints.hits()[9].cycle, 11);
+}
+
+void tst_Breakpoints::resetAddressWatchpoints() {
+    // The register stays at address 0, which is read when propagating the design upon initialization and reset
+    PointerChase design;
+    design.verifyAndInitialize();
+    auto& breakpoints = design.getBreakpoints();
+
+    breakpoints.addWatchpoint(*design.m_memory, 0x0, 1, BreakpointEngine::Read);
+    design.clock();
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+    QCOMPARE(breakpoints.hits()[0].cycle, 1);
+
+    breakpoints.clearHits();
+    design.reverse();
+    QVERIFY(!breakpoints.triggered());
+    design.clock();
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+    QCOMPARE(breakpoints.hits()[0].cycle, 1);
+
+    breakpoints.clearHits();
+    design.reset();
+    QVERIFY(!breakpoints.triggered());
+    design.clock();
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+}
+
+void tst_Breakpoints::untracked() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    auto& breakpoints = design.getBreakpoints();
+    breakpoints.addPortBreakpoint(design.reg->out);
+
+    // Only changes caused by clocking the design fire breakpoints
+    design.setSynchronousValue(design.reg, 0, 123);
+    design.reset();
+    QVERIFY(!breakpoints.triggered());
+    design.clock();
+    design.reverse();
+    QCOMPARE(breakpoints.hits().size(), size_t(1));
+}
+
+QTEST_APPLESS_MAIN(tst_Breakpoints)
+#include "tst_breakpoints.moc"
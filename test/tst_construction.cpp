@@ -0,0 +1,84 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_adderandreg.h"
+#include "vsrtl_xornetwork.h"
+
+class tst_Construction : public QObject {
+    Q_OBJECT private slots : void uniqueNames();
+    void lookup();
+    void largeDesign();
+    void hierarchyIndex();
+};
+
+namespace {
+class DuplicatePorts : public vsrtl::core::Component {
+public:
+    DuplicatePorts(const std::string& name, vsrtl::SimComponent* parent) : Component(name, parent) {
+        createInputPort<1>("a");
+        createOutputPort<1>("a");
+    }
+};
+
+class DuplicateComponents : public vsrtl::core::Design {
+public:
+    DuplicateComponents() : Design("Duplicate components") {
+        create_component<vsrtl::core::Register<1>>("r");
+        create_component<vsrtl::core::Register<1>>("r");
+    }
+};
+}  // namespace
+
+void tst_Construction::uniqueNames() {
+    QVERIFY_EXCEPTION_THROWN(DuplicateComponents(), std::runtime_error);
+
+    vsrtl::core::AdderAndReg a;
+    QVERIFY_EXCEPTION_THROWN(a.create_component<DuplicatePorts>("dup"), std::runtime_error);
+    QVERIFY_EXCEPTION_THROWN(a.createParameter<int>("p", 0); a.createParameter<int>("p", 1), std::runtime_error);
+}
+
+void tst_Construction::lookup() {
+    vsrtl::core::AdderAndReg a;
+    QCOMPARE(a.findSubcomponent("adder"), a.adder);
+    QCOMPARE(a.findSubcomponent<vsrtl::core::Register<32>>("reg"), a.reg);
+    QVERIFY(a.findSubcomponent("nonexistent") == nullptr);
+    QCOMPARE(a.adder->findPort("op1"), &a.adder->op1);
+    QVERIFY(a.adder->findPort("nonexistent") == nullptr);
+}
+
+void tst_Construction::largeDesign() {
+    vsrtl::core::XorNetwork a;
+    // xors + seedReg, decol, adder and the seed constant
+    QCOMPARE(a.getSubComponents().size(), size_t(vsrtl::core::XorNetwork::rows * vsrtl::core::XorNetwork::cols + 4));
+
+    // Subcomponents and ports of the design are allocated within the object arena of the design
+    QVERIFY(a.objectArena().bytesAllocated() > 0);
+    a.verifyAndInitialize();
+    a.clock();
+}
+
+void tst_Construction::hierarchyIndex() {
+    vsrtl::core::AdderAndReg a;
+    a.verifyAndInitialize();
+
+    QCOMPARE(a.adder->op1.getHierName(), std::string("Adder and Register->adder->op1"));
+    QCOMPARE(a.findPortByPath("Adder and Register->adder->op1"), &a.adder->op1);
+    QCOMPARE(a.findPortByPath<vsrtl::core::Port<32>>("Adder and Register->reg->out"), &a.reg->out);
+    QVERIFY(a.findPortByPath("Adder and Register->adder") == nullptr);
+    QCOMPARE(a.findComponentByPath("Adder and Register->adder"), a.adder);
+    QCOMPARE(a.findComponentByPath("Adder and Register"), &a);
+
+    const auto& index = a.getHierarchyIndex();
+    QCOMPARE(index.findPrefix("Adder and Register->adder->").size(), size_t(3));
+    QCOMPARE(index.findPrefix("Adder and Register->", vsrtl::HierarchyIndex::Component).size(), size_t(3));
+    const auto outputs = index.findGlob("*->out", vsrtl::HierarchyIndex::Port);
+    QCOMPARE(outputs.size(), size_t(3));
+    QCOMPARE(index.findGlob("Adder and Register->adder->op?").size(), size_t(2));
+    QCOMPARE(index.findGlob("Adder and Register->reg->in").size(), size_t(1));
+
+    QVERIFY(vsrtl::globMatch("a*b?d", "axxbcd"));
+    QVERIFY(vsrtl::globMatch("*", ""));
+    QVERIFY(!vsrtl::globMatch("a*b", "axxbc"));
+}
+
+QTEST_APPLESS_MAIN(tst_Construction)
+#include "tst_construction.moc"
@@ -0,0 +1,49 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_designregistry.h"
+
+#include <set>
+
+class tst_DesignRegistry : public QObject {
+    Q_OBJECT private slots : void createAll();
+    void programMemory();
+};
+
+using namespace vsrtl::core;
+
+void tst_DesignRegistry::createAll() {
+    std::set<std::string> names;
+    for (const auto& registered : registeredDesigns()) {
+        QVERIFY(names.insert(registered.name).second);
+        QVERIFY(findRegisteredDesign(registered.name) == &registered);
+
+        auto design = registered.create();
+        design->verifyAndInitialize();
+        for (int i = 0; i < 10; ++i) {
+            design->clock();
+        }
+        QCOMPARE(design->getCycleCount(), 10);
+    }
+    QVERIFY(findRegisteredDesign("NoSuchDesign") == nullptr);
+}
+
+void tst_DesignRegistry::programMemory() {
+    const auto* registered = findRegisteredDesign("SingleCycleLeros");
+    QVERIFY(registered != nullptr);
+    QVERIFY(registered->programMemory);
+
+    // loadi 5, loaded through the program memory of the design
+    auto design = registered->create();
+    const unsigned short program[] = {0x2105};
+    auto* memory = registered->programMemory(*design);
+    QVERIFY(memory != nullptr);
+    memory->addInitializationMemory(0x0, program, 1);
+    design->verifyAndInitialize();
+    design->clock();
+    QCOMPARE(design->findPortByPath(design->getName() + "->acc_reg->out")->uValue(), vsrtl::VSRTL_VT_U(5));
+
+    QVERIFY(!findRegisteredDesign("RanNumGen")->programMemory);
+}
+
+QTEST_APPLESS_MAIN(tst_DesignRegistry)
+#include "tst_designregistry.moc"
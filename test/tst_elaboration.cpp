@@ -0,0 +1,145 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_adderandreg.h"
+#include "vsrtl_counter.h"
+#include "vsrtl_constant.h"
+#include "vsrtl_design.h"
+#include "vsrtl_logicgate.h"
+#include "vsrtl_register.h"
+
+#include <filesystem>
+
+class tst_Elaboration : public QObject {
+    Q_OBJECT private slots : void combinationalLoops();
+    void levelization();
+    void deepDesign();
+    void elaborationCache();
+};
+
+namespace {
+using namespace vsrtl::core;
+
+/// Two independent combinational loops, each spanning two xor gates.
+class CombinationalLoops : public Design {
+public:
+    CombinationalLoops() : Design("Combinational loops") {
+        for (auto* x : {x1, x2, x3, x4}) {
+            0 >> *x->in[1];
+        }
+        x1->out >> *x2->in[0];
+        x2->out >> *x1->in[0];
+        x3->out >> *x4->in[0];
+        x4->out >> *x3->in[0];
+    }
+    SUBCOMPONENT(x1, TYPE(Xor<1, 2>));
+    SUBCOMPONENT(x2, TYPE(Xor<1, 2>));
+    SUBCOMPONENT(x3, TYPE(Xor<1, 2>));
+    SUBCOMPONENT(x4, TYPE(Xor<1, 2>));
+};
+
+/// A register feeding back into itself through a long chain of inverters; toggles every cycle.
+class InverterChain : public Design {
+public:
+    static constexpr unsigned length = 20001;
+    InverterChain() : Design("Inverter chain") {
+        Port<1>* prev = &reg->out;
+        for (unsigned i = 0; i < length; ++i) {
+            auto* n = create_component<Not<1, 1>>("not_" + std::to_string(i));
+            *prev >> *n->in[0];
+            prev = &n->out;
+        }
+        *prev >> reg->in;
+    }
+    SUBCOMPONENT(reg, Register<1>);
+};
+}  // namespace
+
+void tst_Elaboration::combinationalLoops() {
+    CombinationalLoops a;
+    QVERIFY_EXCEPTION_THROWN(a.verifyAndInitialize(), std::runtime_error);
+
+    // Every loop is reported, with the ports of each loop
+    const auto& loops = a.getCombinationalLoops();
+    QCOMPARE(loops.size(), size_t(2));
+    for (const auto& loop : loops) {
+        QCOMPARE(loop.size(), size_t(4));
+    }
+}
+
+void tst_Elaboration::levelization() {
+    AdderAndReg a;
+    a.verifyAndInitialize();
+
+    // Each port must be propagated after the ports which it depends on
+    const auto& stack = a.getPropagationStack();
+    auto position = [&](const vsrtl::SimPort* p) { return std::find(stack.begin(), stack.end(), p) - stack.begin(); };
+    QVERIFY(position(&a.reg->out) < position(&a.adder->op2));
+    QVERIFY(position(&a.adder->op2) < position(&a.adder->out));
+    QVERIFY(position(&a.adder->out) < position(&a.reg->in));
+
+    // Constant ports are not part of the propagation stack
+    QVERIFY(a.adder->op1.isConstant());
+    QCOMPARE(position(&a.adder->op1), static_cast<std::ptrdiff_t>(stack.size()));
+
+    // reg.out -> adder.op2 -> adder.out -> reg.in
+    QCOMPARE(a.getElaborationReport().levels, size_t(4));
+    QCOMPARE(a.getElaborationReport().components, size_t(3));
+}
+
+void tst_Elaboration::deepDesign() {
+    InverterChain a;
+    a.verifyAndInitialize();
+    QCOMPARE(a.getElaborationReport().levels, size_t(InverterChain::length * 2 + 2));
+
+    for (unsigned i = 0; i < 4; ++i) {
+        QCOMPARE(a.reg->out.uValue(), vsrtl::VSRTL_VT_U(i % 2));
+        a.clock();
+    }
+}
+
+void tst_Elaboration::elaborationCache() {
+    const auto dir = std::filesystem::temp_directory_path() / "vsrtl_tst_elaboration_cache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    // QCOMPARE returns from the enclosing function on failure; values are passed through an out parameter.
+    auto run = [&](ElaborationCacheMode mode, bool expectHit, std::vector<vsrtl::VSRTL_VT_U>& values) {
+        Counter<8> a;
+        if (mode != ElaborationCacheMode::Disabled) {
+            a.setElaborationCache(dir.string(), mode);
+        }
+        a.verifyAndInitialize();
+        QCOMPARE(a.getElaborationReport().cacheHit, expectHit);
+        values.clear();
+        for (unsigned i = 0; i < 20; ++i) {
+            a.clock();
+            values.push_back(a.value->out.uValue());
+        }
+    };
+
+    std::vector<vsrtl::VSRTL_VT_U> reference, values;
+    run(ElaborationCacheMode::Disabled, false, reference);
+    run(ElaborationCacheMode::Enabled, false, values);
+    QVERIFY(values == reference);
+    run(ElaborationCacheMode::Enabled, true, values);
+    QVERIFY(values == reference);
+    run(ElaborationCacheMode::Verify, true, values);
+    QVERIFY(values == reference);
+
+    // Structurally different designs are cached separately
+    AdderAndReg b;
+    b.setElaborationCache(dir.string());
+    b.verifyAndInitialize();
+    QVERIFY(!b.getElaborationReport().cacheHit);
+
+    // Corrupted cache files are ignored
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        std::filesystem::resize_file(entry.path(), 16);
+    }
+    run(ElaborationCacheMode::Enabled, false, values);
+    QVERIFY(values == reference);
+    std::filesystem::remove_all(dir);
+}
+
+QTEST_APPLESS_MAIN(tst_Elaboration)
+#include "tst_elaboration.moc"
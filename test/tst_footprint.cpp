@@ -0,0 +1,120 @@
+#include <QtTest/QTest>
+
+#include "Leros/SingleCycleLeros/SingleCycleLeros.h"
+
+#include <sstream>
+
+class tst_Footprint : public QObject {
+    Q_OBJECT private slots : void hierarchy();
+    void categories();
+    void reports();
+    void allocations();
+};
+
+using namespace vsrtl;
+
+namespace {
+void loadProgram(leros::SingleCycleLeros& design) {
+    // Increments a value in memory; see tst_leros
+    std::vector<unsigned short> program = {0x2901, 0x3000, 0x5000, 0x2100, 0x7000,
+                                           0x6000, 0x0901, 0x7000, 0x2100, 0x8FFC};
+    design.m_memory->addInitializationMemory(0x0, program.data(), program.size());
+    design.verifyAndInitialize();
+}
+}  // namespace
+
+void tst_Footprint::hierarchy() {
+    leros::SingleCycleLeros design;
+    loadProgram(design);
+    const auto fp = design.getMemoryFootprint();
+
+    // One node per component, including the design itself, with parents preceding their subcomponents
+    const auto& nodes = fp.nodes();
+    QCOMPARE(nodes.size(), design.getHierarchyIndex().findPrefix("", HierarchyIndex::Component).size());
+    QVERIFY(nodes[0].component == &design);
+    QVERIFY(nodes[0].parent == MemoryFootprint::NoParent);
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        QVERIFY(nodes[i].parent < i);
+        QVERIFY(nodes[i].component->getParent() == nodes[nodes[i].parent].component);
+        QVERIFY(nodes[i].self.total() > 0);
+    }
+
+    // Totals are aggregated up through the hierarchy
+    size_t sum = 0;
+    for (const auto& n : nodes) {
+        sum += n.self.total();
+    }
+    QCOMPARE(fp.total().total(), sum);
+    QCOMPARE(nodes[0].total.total(), sum);
+
+    const auto* acc = fp.node(design.acc_reg);
+    QVERIFY(acc != nullptr);
+    QVERIFY(acc->total.total() >= acc->self.total());
+}
+
+void tst_Footprint::categories() {
+    leros::SingleCycleLeros design;
+    loadProgram(design);
+    const auto before = design.getMemoryFootprint().total();
+
+    QVERIFY(before[MemoryFootprint::Components] > 0);
+    QVERIFY(before[MemoryFootprint::Ports] > 0);
+    QVERIFY(before[MemoryFootprint::PropagationFunctions] > 0);
+    QVERIFY(before[MemoryFootprint::ReverseStacks] > 0);
+    QVERIFY(before[MemoryFootprint::AddressSpaces] > 0);
+    QVERIFY(before[MemoryFootprint::InitializationMemories] > 0);
+    QVERIFY(before[MemoryFootprint::Elaboration] > 0);
+    QVERIFY(before[MemoryFootprint::ComponentGraphics] == 0);
+
+    // Reverse stacks fill up as the design is clocked
+    for (int i = 0; i < 200; ++i) {
+        design.clock();
+    }
+    const auto after = design.getMemoryFootprint().total();
+    QVERIFY(after[MemoryFootprint::ReverseStacks] > before[MemoryFootprint::ReverseStacks]);
+    QVERIFY(after[MemoryFootprint::AddressSpaces] >= before[MemoryFootprint::AddressSpaces]);
+    QCOMPARE(after[MemoryFootprint::Ports], before[MemoryFootprint::Ports]);
+}
+
+void tst_Footprint::reports() {
+    leros::SingleCycleLeros design;
+    loadProgram(design);
+    auto fp = design.getMemoryFootprint();
+
+    // External subsystems may attribute memory to components of the footprint
+    const auto total = fp.total().total();
+    fp.add(design.acc_reg, MemoryFootprint::ComponentGraphics, 100);
+    QCOMPARE(fp.total().total(), total + 100);
+    QCOMPARE(fp.total()[MemoryFootprint::ComponentGraphics], size_t(100));
+    QVERIFY_EXCEPTION_THROWN(fp.add(nullptr, MemoryFootprint::ComponentGraphics, 1), std::runtime_error);
+
+    std::stringstream text;
+    fp.print(text, 1);
+    QVERIFY(text.str().rfind("Memory footprint: ", 0) == 0);
+    QVERIFY(text.str().find("acc_reg") != std::string::npos);
+
+    std::stringstream csv;
+    fp.writeCsv(csv);
+    std::string line;
+    std::getline(csv, line);
+    QVERIFY(line.rfind("component,components,ports,", 0) == 0);
+    size_t rows = 0;
+    while (std::getline(csv, line)) {
+        rows++;
+    }
+    QCOMPARE(rows, fp.nodes().size());
+}
+
+void tst_Footprint::allocations() {
+    // Objects created by their parents record the size of their allocation; designs do so if created through create()
+    auto created = core::Design::create<leros::SingleCycleLeros>();
+    QVERIFY(created->allocatedSize() > sizeof(leros::SingleCycleLeros));
+    QVERIFY(created->acc_reg->allocatedSize() > sizeof(*created->acc_reg));
+    QVERIFY(created->acc_reg->out.allocatedSize() > sizeof(created->acc_reg->out));
+
+    leros::SingleCycleLeros design;
+    QCOMPARE(design.allocatedSize(), size_t(0));
+}
+
+QTEST_APPLESS_MAIN(tst_Footprint)
+#include "tst_footprint.moc"
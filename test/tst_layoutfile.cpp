@@ -0,0 +1,84 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_layoutfile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+class tst_LayoutFile : public QObject {
+    Q_OBJECT private slots : void roundtrip();
+    void emptyLayout();
+    void invalidFiles();
+};
+
+using namespace vsrtl;
+
+namespace {
+const std::string c_file = "tst_layoutfile.vsrtllayout";
+}
+
+void tst_LayoutFile::roundtrip() {
+    std::map<std::string, std::string> records;
+    records[""] = "top";
+    records["/alu"] = std::string("a\0lu", 4);
+    records["/alu/adder"] = std::string(100000, 'x');
+    records["/reg"] = "";
+    QVERIFY(LayoutFile::write(c_file, 7, "root", records));
+    QVERIFY(LayoutFile::isLayoutFile(c_file));
+
+    LayoutFile file(c_file);
+    QCOMPARE(file.layoutVersion(), 7u);
+    QCOMPARE(file.paths(), (std::vector<std::string>{"", "/alu", "/alu/adder", "/reg"}));
+    QVERIFY(file.contains("/reg"));
+    QVERIFY(!file.contains("/mux"));
+
+    // Records may be read in any order, and any number of times
+    QCOMPARE(file.read("/alu/adder"), records["/alu/adder"]);
+    QCOMPARE(file.readRoot(), std::string("root"));
+    QCOMPARE(file.read("/alu"), records["/alu"]);
+    QCOMPARE(file.read(""), records[""]);
+    QCOMPARE(file.read("/alu"), records["/alu"]);
+    QCOMPARE(file.read("/reg"), std::string());
+    QCOMPARE(file.read("/mux"), std::string());
+    std::remove(c_file.c_str());
+}
+
+void tst_LayoutFile::emptyLayout() {
+    QVERIFY(LayoutFile::write(c_file, 0, "", {}));
+    LayoutFile file(c_file);
+    QVERIFY(file.paths().empty());
+    QCOMPARE(file.readRoot(), std::string());
+    std::remove(c_file.c_str());
+}
+
+void tst_LayoutFile::invalidFiles() {
+    // JSON layouts are not binary layouts
+    {
+        std::ofstream json(c_file);
+        json << "{\n    \"m_layoutVersion\": 1\n}";
+    }
+    QVERIFY(!LayoutFile::isLayoutFile(c_file));
+    QVERIFY_EXCEPTION_THROWN(LayoutFile{c_file}, std::runtime_error);
+
+    // Truncated files are rejected when opened
+    QVERIFY(LayoutFile::write(c_file, 1, "root", {{"/alu", std::string(64, 'x')}}));
+    std::string contents;
+    {
+        std::ifstream in(c_file, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(c_file, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), contents.size() - 1);
+    }
+    QVERIFY(LayoutFile::isLayoutFile(c_file));
+    QVERIFY_EXCEPTION_THROWN(LayoutFile{c_file}, std::runtime_error);
+
+    std::remove(c_file.c_str());
+    QVERIFY_EXCEPTION_THROWN(LayoutFile{c_file}, std::runtime_error);
+}
+
+QTEST_APPLESS_MAIN(tst_LayoutFile)
+#include "tst_layoutfile.moc"
@@ -0,0 +1,113 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_nameindex.h"
+
+#include <chrono>
+#include <regex>
+#include <string>
+
+class tst_NameIndex : public QObject {
+    Q_OBJECT private slots : void queries();
+    void regexPrefilter();
+    void largeIndex();
+};
+
+using namespace vsrtl;
+
+namespace {
+
+using Names = std::vector<std::string>;
+
+const std::vector<std::string> designNames = {"alu",      "alu.op1",         "alu.op2", "alu.res",
+                                              "pc_reg",   "pc_reg.in",       "pc_reg.out",
+                                              "ALU_ctrl", "ALU_ctrl.opcode", "mem",     "mem.addr",
+                                              "mem.data_out"};
+
+/// Indexes @p names, which must outlive @p hierarchy.
+void buildIndex(HierarchyIndex& hierarchy, NameIndex& index, const std::vector<std::string>& names) {
+    for (const auto& name : names) {
+        hierarchy.add(name, nullptr, HierarchyIndex::Component);
+    }
+    hierarchy.finalize();
+    index.build(hierarchy);
+}
+
+/// @returns the paths matching @p query, in the order of their ids
+Names find(const NameIndex& index, const std::string& query, NameIndex::Syntax syntax) {
+    Names names;
+    for (const auto id : index.find(query, syntax)) {
+        names.emplace_back(index.entry(id).path);
+    }
+    return names;
+}
+
+}  // namespace
+
+void tst_NameIndex::queries() {
+    HierarchyIndex hierarchy;
+    NameIndex index;
+    buildIndex(hierarchy, index, designNames);
+
+    // Substring queries are case insensitive, also for queries shorter than a trigram
+    QCOMPARE(find(index, "alu", NameIndex::Syntax::Substring),
+             (Names{"ALU_ctrl", "ALU_ctrl.opcode", "alu", "alu.op1", "alu.op2", "alu.res"}));
+    QCOMPARE(find(index, "OP", NameIndex::Syntax::Substring), (Names{"ALU_ctrl.opcode", "alu.op1", "alu.op2"}));
+    QCOMPARE(find(index, "reg.out", NameIndex::Syntax::Substring), (Names{"pc_reg.out"}));
+    QCOMPARE(index.find("", NameIndex::Syntax::Substring).size(), index.size());
+    QVERIFY(index.find("xyz", NameIndex::Syntax::Substring).empty());
+
+    // Globs match entire names
+    QCOMPARE(find(index, "alu", NameIndex::Syntax::Glob), (Names{"alu"}));
+    QCOMPARE(find(index, "alu.op?", NameIndex::Syntax::Glob), (Names{"alu.op1", "alu.op2"}));
+    QCOMPARE(find(index, "*.*out", NameIndex::Syntax::Glob), (Names{"mem.data_out", "pc_reg.out"}));
+    QCOMPARE(find(index, "alu*", NameIndex::Syntax::Glob),
+             (Names{"ALU_ctrl", "ALU_ctrl.opcode", "alu", "alu.op1", "alu.op2", "alu.res"}));
+    QCOMPARE(index.find("*", NameIndex::Syntax::Glob).size(), index.size());
+
+    // Regular expressions match anywhere within names
+    QCOMPARE(find(index, "^alu\\.op[12]$", NameIndex::Syntax::Regex), (Names{"alu.op1", "alu.op2"}));
+    QCOMPARE(find(index, "(reg|mem)\\.(in|addr)", NameIndex::Syntax::Regex), (Names{"mem.addr", "pc_reg.in"}));
+    QCOMPARE(find(index, "opcode|res", NameIndex::Syntax::Regex), (Names{"ALU_ctrl.opcode", "alu.res"}));
+    QVERIFY_EXCEPTION_THROWN(index.find("alu(", NameIndex::Syntax::Regex), std::regex_error);
+}
+
+void tst_NameIndex::regexPrefilter() {
+    // Optional parts of a pattern must not exclude names from being matched
+    HierarchyIndex hierarchy;
+    NameIndex index;
+    buildIndex(hierarchy, index, designNames);
+    QCOMPARE(find(index, "pc_?reg\\.ou?t", NameIndex::Syntax::Regex), (Names{"pc_reg.out"}));
+    QCOMPARE(find(index, "mem(\\.data)?_out", NameIndex::Syntax::Regex), (Names{"mem.data_out"}));
+    QCOMPARE(find(index, "alux{0,1}\\.res", NameIndex::Syntax::Regex), (Names{"alu.res"}));
+    QCOMPARE(find(index, "a[l]u\\.op\\d", NameIndex::Syntax::Regex), (Names{"alu.op1", "alu.op2"}));
+    QCOMPARE(find(index, "data.*", NameIndex::Syntax::Regex), (Names{"mem.data_out"}));
+}
+
+void tst_NameIndex::largeIndex() {
+    // 10^5 hierarchical names; ie. 10 levels of components with ports
+    std::vector<std::string> names;
+    for (unsigned i = 0; i < 100000; ++i) {
+        names.push_back("core" + std::to_string(i % 10) + ".unit" + std::to_string(i / 10 % 100) + ".block" +
+                        std::to_string(i / 1000) + ".port" + std::to_string(i % 7));
+    }
+    HierarchyIndex hierarchy;
+    NameIndex index;
+    buildIndex(hierarchy, index, names);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto substring = index.find("unit42.block7.", NameIndex::Syntax::Substring);
+    const auto glob = index.find("core3.*.block9?.port5", NameIndex::Syntax::Glob);
+    const auto regex = index.find("unit4[0-9]\\.block99\\.port6$", NameIndex::Syntax::Regex);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    QCOMPARE(substring.size(), 10u);
+    for (const auto id : substring) {
+        QVERIFY(index.entry(id).path.find("unit42.block7.") != std::string_view::npos);
+    }
+    QVERIFY(!glob.empty());
+    QVERIFY(!regex.empty());
+    QVERIFY(elapsed < std::chrono::seconds(1));
+}
+
+QTEST_APPLESS_MAIN(tst_NameIndex)
+#include "tst_nameindex.moc"
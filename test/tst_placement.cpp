@@ -0,0 +1,108 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_adderandreg.h"
+#include "vsrtl_placeroute.h"
+#include "vsrtl_syntheticdesign.h"
+
+#include <algorithm>
+#include <map>
+
+class tst_Placement : public QObject {
+    Q_OBJECT private slots : void registerFeedback();
+    void layered();
+    void algorithms();
+};
+
+using namespace vsrtl;
+
+namespace {
+
+std::vector<PlacementNode> nodesOf(const SimComponent& parent) {
+    std::vector<PlacementNode> nodes;
+    int i = 0;
+    for (auto* c : parent.getSubComponents()) {
+        nodes.push_back({c, QSize(3 + i % 4, 2 + i % 5)});
+        i++;
+    }
+    return nodes;
+}
+
+}  // namespace
+
+void tst_Placement::registerFeedback() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    const auto nodes = nodesOf(design);
+    const auto positions = layeredPlacement(nodes);
+    QCOMPARE(positions.size(), nodes.size());
+
+    std::map<SimComponent*, QPoint> placements;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        placements[nodes[i].component] = positions[i];
+    }
+    // The feedback edge of the loop ends at the register
+    QVERIFY(placements.at(design.reg).x() < placements.at(design.adder).x());
+}
+
+void tst_Placement::layered() {
+    core::SyntheticDesignParameters p;
+    p.seed = 42;
+    p.gates = 3000;
+    p.depth = 10;
+    p.registerRatio = 0.05;
+    core::SyntheticDesign design(p);
+    design.verifyAndInitialize();
+
+    const auto nodes = nodesOf(design);
+    const auto positions = layeredPlacement(nodes);
+    QCOMPARE(positions.size(), nodes.size());
+    std::map<SimComponent*, size_t> index;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        index[nodes[i].component] = i;
+    }
+
+    // All cycles pass through registers, so all edges into combinational components point rightwards
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (auto* c : nodes[i].component->getOutputComponents()) {
+            auto it = index.find(c);
+            if (it != index.end() && it->second != i && !c->isSynchronous()) {
+                QVERIFY(positions[i].x() < positions[it->second].x());
+            }
+        }
+    }
+
+    // Components within a column do not overlap
+    std::map<int, std::vector<std::pair<int, int>>> columns;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        QVERIFY(positions[i].x() >= 0 && positions[i].y() >= 0);
+        columns[positions[i].x()].push_back({positions[i].y(), positions[i].y() + nodes[i].size.height()});
+    }
+    for (auto& [x, spans] : columns) {
+        std::sort(spans.begin(), spans.end());
+        for (size_t i = 1; i < spans.size(); ++i) {
+            QVERIFY(spans[i - 1].second <= spans[i].first);
+        }
+    }
+
+    // Placement is deterministic
+    QVERIFY(layeredPlacement(nodes) == positions);
+}
+
+void tst_Placement::algorithms() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    const auto nodes = nodesOf(design);
+
+    auto* placeRoute = PlaceRoute::get();
+    const auto previous = placeRoute->placementAlgorithm();
+    placeRoute->setPlacementAlgorithm(PlaceAlg::Layered);
+    QVERIFY(placeRoute->place(nodes) == layeredPlacement(nodes));
+    for (auto alg : {PlaceAlg::TopologicalSort, PlaceAlg::ASAP}) {
+        placeRoute->setPlacementAlgorithm(alg);
+        QCOMPARE(placeRoute->place(nodes).size(), nodes.size());
+    }
+    placeRoute->setPlacementAlgorithm(previous);
+}
+
+QTEST_APPLESS_MAIN(tst_Placement)
+#include "tst_placement.moc"
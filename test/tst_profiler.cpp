@@ -0,0 +1,118 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_manynestedcomponents.h"
+
+#include <sstream>
+
+class tst_Profiler : public QObject {
+    Q_OBJECT private slots : void disabledByDefault();
+    void evaluations();
+    void hierarchy();
+    void foldedStacks();
+};
+
+using namespace vsrtl::core;
+
+void tst_Profiler::disabledByDefault() {
+    ManyNestedComponents design;
+    design.verifyAndInitialize();
+    design.clock();
+    QVERIFY(design.getProfiler() == nullptr);
+
+    // Profiling may be requested prior to initialization
+    ManyNestedComponents requested;
+    requested.setProfilingEnabled(true);
+    QVERIFY(requested.getProfiler() == nullptr);
+    requested.verifyAndInitialize();
+    QVERIFY(requested.getProfiler() != nullptr);
+
+    requested.setProfilingEnabled(false);
+    QVERIFY(requested.getProfiler() == nullptr);
+}
+
+void tst_Profiler::evaluations() {
+    ManyNestedComponents design;
+    design.verifyAndInitialize();
+    design.setProfilingEnabled(true);
+    const auto* profiler = design.getProfiler();
+
+    constexpr unsigned cycles = 10;
+    for (unsigned i = 0; i < cycles; ++i) {
+        design.clock();
+    }
+    design.reverse();
+    QCOMPARE(profiler->cycles(), uint64_t(cycles));
+
+    // Each port of the propagation stack is evaluated once per clock and reverse
+    for (const auto* p : design.getPropagationStack()) {
+        QCOMPARE(profiler->port(p->graphIndex()).evaluations, uint64_t(cycles + 1));
+    }
+
+    uint64_t evaluations = 0;
+    for (const auto& c : profiler->components()) {
+        evaluations += c.evaluations;
+    }
+    QCOMPARE(evaluations, uint64_t(design.getPropagationStack().size() * (cycles + 1)));
+
+    design.resetProfile();
+    QCOMPARE(profiler->cycles(), uint64_t(0));
+    QCOMPARE(profiler->totalTicks(), uint64_t(0));
+}
+
+void tst_Profiler::hierarchy() {
+    ManyNestedComponents design;
+    design.setProfilingEnabled(true);
+    design.verifyAndInitialize();
+    for (unsigned i = 0; i < 100; ++i) {
+        design.clock();
+    }
+    const auto* profiler = design.getProfiler();
+    QVERIFY(profiler->totalTicks() > 0);
+
+    // Component totals include their subcomponents
+    for (const auto* c : {design.exp1, design.exp2}) {
+        const auto* profile = profiler->component(c);
+        QVERIFY(profile != nullptr);
+        auto total = profile->self();
+        for (const auto* sc : c->getSubComponents()) {
+            total += profiler->component(sc)->total;
+        }
+        QCOMPARE(profile->total, total);
+    }
+
+    // Top-level components cover the entire profile
+    QCOMPARE(profiler->component(design.exp1)->total + profiler->component(design.exp2)->total,
+             profiler->totalTicks());
+    QVERIFY(std::abs(profiler->share(design.exp1) + profiler->share(design.exp2) - 1.0) < 1e-9);
+
+    const auto hotspots = profiler->hotspots(3);
+    QCOMPARE(hotspots.size(), size_t(3));
+    const auto& components = profiler->components();
+    QVERIFY(components[hotspots[0]].self() >= components[hotspots[1]].self());
+    QVERIFY(components[hotspots[1]].self() >= components[hotspots[2]].self());
+}
+
+void tst_Profiler::foldedStacks() {
+    ManyNestedComponents design;
+    design.setProfilingEnabled(true);
+    design.verifyAndInitialize();
+    for (unsigned i = 0; i < 100; ++i) {
+        design.clock();
+    }
+
+    std::stringstream ss;
+    design.getProfiler()->writeFoldedStacks(ss, design.getName());
+    std::string line;
+    unsigned lines = 0;
+    while (std::getline(ss, line)) {
+        lines++;
+        QVERIFY(line.rfind(design.getName() + ";exp", 0) == 0);
+        const auto space = line.rfind(' ');
+        QVERIFY(space != std::string::npos);
+        QVERIFY(std::stoull(line.substr(space + 1)) > 0);
+    }
+    QVERIFY(lines > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_Profiler)
+#include "tst_profiler.moc"
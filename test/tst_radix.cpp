@@ -0,0 +1,61 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_enumandmux.h"
+#include "vsrtl_radix.h"
+
+class tst_Radix : public QObject {
+    Q_OBJECT private slots : void encode();
+    void cachedText();
+};
+
+using namespace vsrtl;
+
+void tst_Radix::encode() {
+    core::EnumAndMux design;
+    design.verifyAndInitialize();
+    const SimPort* select = &design.mux->select;
+    const SimPort* out = &design.mux->out;
+
+    QCOMPARE(encodePortRadixValue(out, Radix::Hex, 0xbeef), QString("0x0000beef"));
+    QCOMPARE(encodePortRadixValue(out, Radix::Binary, 5), "0b" + QString(29, '0') + "101");
+    QCOMPARE(encodePortRadixValue(out, Radix::Unsigned, 0xFFFFFFFF), QString("4294967295"));
+    QCOMPARE(encodePortRadixValue(out, Radix::Signed, 0xFFFFFFFF), QString("-1"));
+
+    // Enum strings are looked up repeatedly, and must match those of the enum
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(encodePortRadixValue(select, Radix::Enum, core::TestEnum::A), QString("A"));
+        QCOMPARE(encodePortRadixValue(select, Radix::Enum, core::TestEnum::E), QString("E"));
+    }
+    QVERIFY_EXCEPTION_THROWN(encodePortRadixValue(out, Radix::Enum, 0), std::runtime_error);
+}
+
+void tst_Radix::cachedText() {
+    core::EnumAndMux design;
+    design.verifyAndInitialize();
+    const SimPort* select = &design.mux->select;
+
+    PortValueText text;
+    QVERIFY(text.update(select, Radix::Enum));
+    QCOMPARE(text.text(), QString("A"));
+
+    // An unchanged value reuses the cached string
+    const QChar* data = text.text().constData();
+    QVERIFY(!text.update(select, Radix::Enum));
+    QCOMPARE(text.get(select, Radix::Enum).constData(), data);
+
+    // Changes in radix or value are re-encoded
+    QVERIFY(text.update(select, Radix::Unsigned));
+    QCOMPARE(text.text(), QString("0"));
+    design.clock();
+    QVERIFY(text.update(select, Radix::Unsigned));
+    QCOMPARE(text.text(), QString("1"));
+    QVERIFY(text.update(select, Radix::Enum));
+    QCOMPARE(text.text(), QString("B"));
+
+    // As are changes in port
+    QVERIFY(text.update(&design.mux->out, Radix::Hex));
+    QCOMPARE(text.text(), QString("0x00000002"));
+}
+
+QTEST_APPLESS_MAIN(tst_Radix)
+#include "tst_radix.moc"
@@ -0,0 +1,165 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_router.h"
+
+#include <map>
+#include <set>
+
+class tst_Router : public QObject {
+    Q_OBJECT private slots : void straight();
+    void obstacles();
+    void tree();
+    void congestion();
+    void reuse();
+};
+
+using namespace vsrtl;
+
+namespace {
+using Axis = GridRouter::Axis;
+
+/// Expands @p route to the grid points it passes through, verifying that all of its segments are rectilinear.
+std::vector<QPoint> gridPoints(const RouteTree& route) {
+    std::vector<QPoint> points;
+    for (size_t i = 0; i < route.points.size(); ++i) {
+        const int parent = route.parents[i];
+        if (parent == -1) {
+            points.push_back(route.points[i]);
+            continue;
+        }
+        QPoint from = route.points[parent];
+        const QPoint to = route.points[i];
+        if (from.x() != to.x() && from.y() != to.y()) {
+            return {};
+        }
+        const QPoint step((to.x() > from.x()) - (to.x() < from.x()), (to.y() > from.y()) - (to.y() < from.y()));
+        while (from != to) {
+            from += step;
+            points.push_back(from);
+        }
+    }
+    return points;
+}
+
+bool intersects(const std::vector<QPoint>& points, const QRect& rect) {
+    return std::any_of(points.begin(), points.end(), [&](const QPoint& p) { return rect.contains(p); });
+}
+
+}  // namespace
+
+void tst_Router::straight() {
+    GridRouter router(QRect(0, 0, 20, 10));
+    GridRouter::Net net;
+    net.source = {QPoint(1, 5), Axis::Horizontal};
+    net.sinks = {{QPoint(15, 5), Axis::Horizontal}};
+
+    const auto routes = router.route({net});
+    QCOMPARE(routes.size(), size_t(1));
+    // Straight wires consist of a single segment
+    QCOMPARE(routes[0].points.size(), size_t(2));
+    QCOMPARE(routes[0].points[0], QPoint(1, 5));
+    QCOMPARE(routes[0].points[routes[0].sinks[0]], QPoint(15, 5));
+}
+
+void tst_Router::obstacles() {
+    GridRouter router(QRect(0, 0, 30, 20));
+    const QRect block(8, 2, 6, 12);
+    router.addObstacle(block);
+    GridRouter::Net net;
+    net.source = {QPoint(2, 8), Axis::Horizontal};
+    net.sinks = {{QPoint(20, 8), Axis::Horizontal}};
+
+    const auto routes = router.route({net});
+    const auto points = gridPoints(routes[0]);
+    QVERIFY(!points.empty());
+    QVERIFY(!intersects(points, block));
+    QCOMPARE(router.statistics().unroutable, 0u);
+    // Routing around the block requires no more than four bends
+    QVERIFY(routes[0].points.size() <= size_t(6));
+}
+
+void tst_Router::tree() {
+    GridRouter router(QRect(0, 0, 30, 30));
+    GridRouter::Net net;
+    net.source = {QPoint(2, 15), Axis::Horizontal};
+    net.sinks = {{QPoint(20, 5), Axis::Horizontal},
+                 {QPoint(20, 25), Axis::Horizontal},
+                 {QPoint(25, 15), Axis::Horizontal}};
+
+    const auto routes = router.route({net});
+    const auto& route = routes[0];
+    QVERIFY(!gridPoints(route).empty());
+    QCOMPARE(route.sinks.size(), net.sinks.size());
+    std::set<int> parents(route.parents.begin(), route.parents.end());
+    for (size_t i = 0; i < net.sinks.size(); ++i) {
+        QCOMPARE(route.points[route.sinks[i]], net.sinks[i].pos);
+        // Sinks are leaves of the tree
+        QVERIFY(parents.count(route.sinks[i]) == 0);
+    }
+    // Sinks share wiring rather than being routed separately from the source
+    QVERIFY(gridPoints(route).size() < size_t(18 + 10 + 18 + 10 + 23 + 1));
+}
+
+void tst_Router::congestion() {
+    // Two nets must pass through a corridor which is two grid points wide
+    GridRouter router(QRect(0, 0, 30, 20));
+    const QRect top(10, 0, 10, 9);
+    const QRect bottom(10, 11, 10, 9);
+    router.addObstacle(top);
+    router.addObstacle(bottom);
+
+    std::vector<GridRouter::Net> nets(2);
+    nets[0].source = {QPoint(2, 4), Axis::Horizontal};
+    nets[0].sinks = {{QPoint(27, 4), Axis::Horizontal}};
+    nets[1].source = {QPoint(2, 16), Axis::Horizontal};
+    nets[1].sinks = {{QPoint(27, 16), Axis::Horizontal}};
+
+    const auto routes = router.route(nets);
+    QCOMPARE(router.statistics().contested, 0u);
+    std::map<std::pair<int, int>, int> uses;
+    auto usesAt = [&](int x, int y) { return uses[std::make_pair(x, y)]; };
+    for (const auto& route : routes) {
+        const auto points = gridPoints(route);
+        QVERIFY(!points.empty());
+        QVERIFY(!intersects(points, top) && !intersects(points, bottom));
+        for (const auto& p : points) {
+            uses[std::make_pair(p.x(), p.y())]++;
+        }
+    }
+    // Nets do not share grid points within the corridor
+    for (int x = 10; x < 20; ++x) {
+        QVERIFY(usesAt(x, 9) <= 1 && usesAt(x, 10) <= 1);
+    }
+}
+
+void tst_Router::reuse() {
+    GridRouter::Net a, b;
+    a.source = {QPoint(2, 4), Axis::Horizontal};
+    a.sinks = {{QPoint(20, 4), Axis::Horizontal}};
+    b.source = {QPoint(2, 14), Axis::Horizontal};
+    b.sinks = {{QPoint(20, 14), Axis::Horizontal}};
+
+    GridRouter first(QRect(0, 0, 30, 20));
+    const auto routes = first.route({a, b});
+    QCOMPARE(first.statistics().reused, 0u);
+
+    // A component is placed across the route of b; only b is rerouted
+    a.previous = &routes[0];
+    b.previous = &routes[1];
+    GridRouter second(QRect(0, 0, 30, 20));
+    second.addObstacle(QRect(10, 12, 4, 4));
+    const auto rerouted = second.route({a, b});
+    QVERIFY(second.wasReused(0));
+    QVERIFY(!second.wasReused(1));
+    QCOMPARE(rerouted[0].points, routes[0].points);
+    QVERIFY(!intersects(gridPoints(rerouted[1]), QRect(10, 12, 4, 4)));
+
+    // A moved terminal invalidates the previous route
+    a.sinks[0].pos = QPoint(21, 4);
+    GridRouter third(QRect(0, 0, 30, 20));
+    third.route({a, b});
+    QVERIFY(!third.wasReused(0));
+}
+
+QTEST_APPLESS_MAIN(tst_Router)
+#include "tst_router.moc"
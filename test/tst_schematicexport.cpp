@@ -0,0 +1,42 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_schematicexport.h"
+
+class tst_SchematicExport : public QObject {
+    Q_OBJECT private slots : void tileGrid();
+    void tilePyramid();
+};
+
+using namespace vsrtl;
+
+void tst_SchematicExport::tileGrid() {
+    const TileGrid grid(QSize(1000, 300), 256);
+    QCOMPARE(grid.levels(), 3);
+    QCOMPARE(grid.tiles(2), QSize(4, 2));
+    QCOMPARE(grid.tiles(1), QSize(2, 1));
+    QCOMPARE(grid.tiles(0), QSize(1, 1));
+
+    // Images fitting a single tile have a single level
+    QCOMPARE(TileGrid(QSize(256, 256), 256).levels(), 1);
+    QCOMPARE(TileGrid(QSize(0, 0), 256).tiles(0), QSize(1, 1));
+    QCOMPARE(TileGrid(QSize(257, 10), 256).levels(), 2);
+
+    QVERIFY_EXCEPTION_THROWN(TileGrid(QSize(100, 100), 0), std::runtime_error);
+}
+
+void tst_SchematicExport::tilePyramid() {
+    // Each level covers the level below it by 2x2 tiles, and level 0 is a single tile
+    for (const auto& size : {QSize(5000, 3000), QSize(100000, 700), QSize(1, 40000)}) {
+        const TileGrid grid(size, 256);
+        QCOMPARE(grid.tiles(0), QSize(1, 1));
+        const QSize full = grid.tiles(grid.levels() - 1);
+        QCOMPARE(full, QSize((size.width() + 255) / 256, (size.height() + 255) / 256));
+        for (int level = 0; level < grid.levels() - 1; ++level) {
+            const QSize below = grid.tiles(level + 1);
+            QCOMPARE(grid.tiles(level), QSize((below.width() + 1) / 2, (below.height() + 1) / 2));
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_SchematicExport)
+#include "tst_schematicexport.moc"
@@ -0,0 +1,112 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_adderandreg.h"
+
+#include <atomic>
+#include <thread>
+
+class tst_Snapshot : public QObject {
+    Q_OBJECT private slots : void ordinals();
+    void publishAndAcquire();
+    void observedValues();
+    void concurrentReader();
+};
+
+using namespace vsrtl;
+
+void tst_Snapshot::ordinals() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+
+    const auto& ports = design.getPorts();
+    QCOMPARE(ports.size(), design.getSnapshot().size());
+    QCOMPARE(ports[design.reg->out.ordinal()], &design.reg->out);
+    for (uint32_t i = 0; i < ports.size(); ++i) {
+        QCOMPARE(ports[i]->ordinal(), i);
+    }
+}
+
+void tst_Snapshot::publishAndAcquire() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    auto& snapshot = design.getSnapshot();
+    const auto out = design.reg->out.ordinal();
+
+    QVERIFY(!snapshot.acquire());
+    QCOMPARE(snapshot.cycle(), -1);
+
+    design.clock();
+    design.publishSnapshot();
+    design.clock();
+    design.publishSnapshot();
+    // Only the latest published snapshot is acquired
+    QVERIFY(snapshot.acquire());
+    QCOMPARE(snapshot.cycle(), 2);
+    QCOMPARE(snapshot.value(out), VSRTL_VT_U(8));
+    QVERIFY(!snapshot.acquire());
+
+    // The acquired snapshot is unaffected by further publishing
+    design.clock();
+    design.publishSnapshot();
+    QCOMPARE(snapshot.value(out), VSRTL_VT_U(8));
+    QVERIFY(snapshot.acquire());
+    QCOMPARE(snapshot.value(out), VSRTL_VT_U(12));
+}
+
+void tst_Snapshot::observedValues() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    design.clock();
+
+    QCOMPARE(design.reg->out.observedValue(), VSRTL_VT_U(4));
+    design.setLiveSnapshots(true);
+    QCOMPARE(design.reg->out.observedValue(), VSRTL_VT_U(4));
+
+    // Observers see the acquired snapshot rather than the current port value
+    design.clock();
+    QCOMPARE(design.reg->out.observedValue(), VSRTL_VT_U(4));
+    design.publishSnapshot();
+    QVERIFY(design.getSnapshot().acquire());
+    QCOMPARE(design.reg->out.observedValue(), VSRTL_VT_U(8));
+
+    design.clock();
+    design.setLiveSnapshots(false);
+    QCOMPARE(design.reg->out.observedValue(), VSRTL_VT_U(12));
+}
+
+void tst_Snapshot::concurrentReader() {
+    core::AdderAndReg design;
+    design.verifyAndInitialize();
+    design.setEnableSignals(false);
+    auto& snapshot = design.getSnapshot();
+    const auto out = design.reg->out.ordinal();
+    const long long cycles = 200000;
+
+    std::atomic<bool> done = false;
+    std::thread writer([&] {
+        for (long long i = 0; i < cycles; ++i) {
+            design.clock();
+            design.publishSnapshot();
+        }
+        done = true;
+    });
+
+    // Each acquired snapshot must be a consistent view of the design at a single cycle
+    long long lastCycle = -1;
+    bool consistent = true;
+    while (!done) {
+        if (snapshot.acquire()) {
+            consistent &= snapshot.cycle() > lastCycle;
+            consistent &= snapshot.value(out) == VSRTL_VT_U(snapshot.cycle() * 4);
+            lastCycle = snapshot.cycle();
+        }
+    }
+    writer.join();
+    QVERIFY(consistent);
+    // The final snapshot may already have been acquired within the loop
+    snapshot.acquire();
+    QCOMPARE(snapshot.cycle(), cycles);
+}
+
+QTEST_APPLESS_MAIN(tst_Snapshot)
+#include "tst_snapshot.moc"
@@ -0,0 +1,90 @@
+#include <QtTest/QTest>
+
+#include "vsrtl_syntheticdesign.h"
+
+class tst_SyntheticDesign : public QObject {
+    Q_OBJECT private slots : void reproducible();
+    void shapes();
+    void invalidParameters();
+};
+
+using namespace vsrtl::core;
+
+void tst_SyntheticDesign::reproducible() {
+    SyntheticDesignParameters p;
+    p.seed = 1234;
+    p.memories = 2;
+
+    SyntheticDesign a(p), b(p);
+    a.verifyAndInitialize();
+    b.verifyAndInitialize();
+    QCOMPARE(a.structuralHash(), b.structuralHash());
+
+    // Equal designs simulate identically
+    for (int i = 0; i < 50; ++i) {
+        a.clock();
+        b.clock();
+    }
+    const auto& aStack = a.getPropagationStack();
+    const auto& bStack = b.getPropagationStack();
+    QCOMPARE(aStack.size(), bStack.size());
+    for (size_t i = 0; i < aStack.size(); ++i) {
+        QCOMPARE(aStack[i]->uValue(), bStack[i]->uValue());
+    }
+
+    p.seed = 4321;
+    SyntheticDesign c(p);
+    c.verifyAndInitialize();
+    QVERIFY(a.structuralHash() != c.structuralHash());
+}
+
+void tst_SyntheticDesign::shapes() {
+    for (unsigned hierarchyDepth : {0u, 1u, 3u}) {
+        for (unsigned memories : {0u, 5u}) {
+            SyntheticDesignParameters p;
+            p.gates = 2000;
+            p.depth = 12;
+            p.registerRatio = 0.05;
+            p.fanOutSkew = 3.0;
+            p.widths = {1, 16, 64};
+            p.hierarchyDepth = hierarchyDepth;
+            p.hierarchyBranching = 2;
+            p.memories = memories;
+
+            SyntheticDesign d(p);
+            d.verifyAndInitialize();
+            const auto& stats = d.statistics();
+            QVERIFY(stats.gates >= p.gates);
+            QVERIFY(stats.gates < p.gates * 1.1);
+            QCOMPARE(stats.memories, memories);
+            QCOMPARE(stats.modules, hierarchyDepth == 0 ? 0u : (2u << hierarchyDepth) - 2);
+            // Each gate contributes an input and an output level to the netlist
+            QVERIFY(d.getElaborationReport().levels >= 2 * p.depth);
+
+            for (int i = 0; i < 20; ++i) {
+                d.clock();
+            }
+            for (int i = 0; i < 10; ++i) {
+                d.reverse();
+            }
+            QCOMPARE(d.getCycleCount(), 10ll);
+        }
+    }
+}
+
+void tst_SyntheticDesign::invalidParameters() {
+    SyntheticDesignParameters p;
+    p.widths = {3};
+    QVERIFY_EXCEPTION_THROWN(SyntheticDesign{p}, std::runtime_error);
+
+    p.widths = {1};
+    p.memories = 1;
+    QVERIFY_EXCEPTION_THROWN(SyntheticDesign{p}, std::runtime_error);
+
+    p.memories = 0;
+    p.depth = 0;
+    QVERIFY_EXCEPTION_THROWN(SyntheticDesign{p}, std::runtime_error);
+}
+
+QTEST_APPLESS_MAIN(tst_SyntheticDesign)
+#include "tst_syntheticdesign.moc"